@@ -33,6 +33,7 @@
 #include <NodeType.h>
 #include <SharedUtil.h>
 #include <PathUtils.h>
+#include <TBBHelpers.h>
 #include <image/TextureProcessing.h>
 
 #include "AssetServerLogging.h"
@@ -118,14 +119,13 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
         auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
-        task->setAutoDelete(false);
         _pendingBakes[assetHash] = task;
 
         connect(task.get(), &BakeAssetTask::bakeComplete, this, &AssetServer::handleCompletedBake);
         connect(task.get(), &BakeAssetTask::bakeFailed, this, &AssetServer::handleFailedBake);
         connect(task.get(), &BakeAssetTask::bakeAborted, this, &AssetServer::handleAbortedBake);
 
-        _bakingTaskPool.start(task.get());
+        task->start(_bakeWorkerPool);
     } else {
         qDebug() << "Already in queue";
     }
@@ -273,7 +273,7 @@ bool interfaceRunning() {
     return result;
 }
 
-void updateConsumedCores() {
+void updateConsumedCores(BakeWorkerPool& bakeWorkerPool) {
     static bool wasInterfaceRunning = false;
     bool isInterfaceRunning = interfaceRunning();
     // If state is unchanged, return early
@@ -288,13 +288,15 @@ void updateConsumedCores() {
     } 
     qCDebug(asset_server) << "Setting max consumed cores to " << coreCount;
     setMaxCores(coreCount);
+    // the bake workers share the cores left to the asset server
+    bakeWorkerPool.setMaxWorkers(BakeWorkerPool::maxWorkersForCores(coreCount));
 }
 
 
 AssetServer::AssetServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _transferTaskPool(this),
-    _bakingTaskPool(this),
+    _bakeWorkerPool(this),
     _filesizeLimit(AssetUtils::MAX_UPLOAD_SIZE)
 {
     BAKEABLE_TEXTURE_EXTENSIONS = image::getSupportedFormats();
@@ -304,17 +306,18 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     // so the ideal is greater than the number of cores on the system.
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
-    _bakingTaskPool.setMaxThreadCount(1);
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetMappingOperation }, this, "queueRequests");
 
+    _bakeWorkerPool.setMaxWorkers(BakeWorkerPool::maxWorkersForCores(std::thread::hardware_concurrency()));
+
 #ifdef Q_OS_WIN
-    updateConsumedCores();
+    updateConsumedCores(_bakeWorkerPool);
     QTimer* timer = new QTimer(this);
-    auto timerConnection = connect(timer, &QTimer::timeout, [] {
-        updateConsumedCores();
+    auto timerConnection = connect(timer, &QTimer::timeout, [this] {
+        updateConsumedCores(_bakeWorkerPool);
     });
     connect(qApp, &QCoreApplication::aboutToQuit, [this, timerConnection] {
         disconnect(timerConnection);
@@ -330,18 +333,11 @@ void AssetServer::aboutToFinish() {
     // remove pending transfer tasks
     _transferTaskPool.clear();
 
-    // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
-    auto it = _pendingBakes.begin();
-    while (it != _pendingBakes.end()) {
-        auto pendingRunnable =  _bakingTaskPool.tryTake(it->get());
-
-        if (pendingRunnable) {
-            it = _pendingBakes.erase(it);
-        } else {
-            qDebug() << "Aborting bake for" << it.key();
-            it.value()->abort();
-            ++it;
-        }
+    // abort each of our queued and running bake tasks, this removes queued bakes from _pendingBakes right away
+    auto pendingBakes = _pendingBakes;
+    for (auto it = pendingBakes.begin(); it != pendingBakes.end(); ++it) {
+        qDebug() << "Aborting bake for" << it.key();
+        it.value()->abort();
     }
 
     // make sure all bakers are finished or aborted
@@ -436,6 +432,11 @@ void AssetServer::completeSetup() {
 
         qCInfo(asset_server) << "There are" << hashedFiles.size() << "asset files in the asset directory.";
 
+        static const QString VERIFY_ASSETS_OPTION = "verify_assets_on_startup";
+        if (assetServerObject[VERIFY_ASSETS_OPTION].toBool(false)) {
+            verifyAssetFiles(hashedFiles);
+        }
+
         if (_fileMappings.size() > 0) {
             cleanupUnmappedFiles();
             cleanupBakedFilesForDeletedAssets();
@@ -550,6 +551,29 @@ void AssetServer::cleanupUnmappedFiles() {
     }
 }
 
+void AssetServer::verifyAssetFiles(const QStringList& hashedFiles) {
+    qCInfo(asset_server) << "Verifying the content of" << hashedFiles.size() << "asset files.";
+
+    auto startTime = usecTimestampNow();
+    tbb::concurrent_vector<QString> corruptedFiles;
+
+    // each file is streamed through the hasher, so verifying in parallel doesn't load whole assets in memory
+    tbb::parallel_for(0, hashedFiles.size(), [&](int i) {
+        const auto& filename = hashedFiles[i];
+        auto hash = AssetUtils::hashFile(_filesDirectory.absoluteFilePath(filename));
+        if (QString(hash.toHex()).compare(filename, Qt::CaseInsensitive) != 0) {
+            corruptedFiles.push_back(filename);
+        }
+    });
+
+    for (const auto& filename : corruptedFiles) {
+        qCWarning(asset_server) << "\tAsset file" << filename << "does not match its hash, it will be replaced on its next upload.";
+    }
+
+    qCInfo(asset_server) << "Verified asset files in" << (usecTimestampNow() - startTime) / USECS_PER_MSEC << "ms,"
+                         << corruptedFiles.size() << "corrupted.";
+}
+
 void AssetServer::cleanupBakedFilesForDeletedAssets() {
     qCInfo(asset_server) << "Performing baked asset cleanup for deleted assets";
 
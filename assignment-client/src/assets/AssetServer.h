@@ -16,6 +16,7 @@
 #include <QtCore/QThreadPool>
 #include <QRunnable>
 
+#include <BakeWorkerPool.h>
 #include <ThreadedAssignment.h>
 
 #include "AssetUtils.h"
@@ -122,6 +123,9 @@ private:
     /// Delete any unmapped files from the local asset directory
     void cleanupUnmappedFiles();
 
+    /// Check in parallel that the content of each asset file matches the hash it is named after
+    void verifyAssetFiles(const QStringList& hashedFiles);
+
     /// Delete any baked files for assets removed from the local asset directory
     void cleanupBakedFilesForDeletedAssets();
 
@@ -157,7 +161,7 @@ private:
     QThreadPool _transferTaskPool;
 
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
-    QThreadPool _bakingTaskPool;
+    BakeWorkerPool _bakeWorkerPool;
 
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
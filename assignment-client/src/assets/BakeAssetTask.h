@@ -12,26 +12,25 @@
 #ifndef hifi_BakeAssetTask_h
 #define hifi_BakeAssetTask_h
 
-#include <memory>
-
 #include <QtCore/QDebug>
 #include <QtCore/QObject>
-#include <QtCore/QRunnable>
 #include <QDir>
 #include <QProcess>
 
 #include <AssetUtils.h>
 
-class BakeAssetTask : public QObject, public QRunnable {
+class BakeWorkerPool;
+
+class BakeAssetTask : public QObject {
     Q_OBJECT
 public:
     BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
-    // Thread-safe inspection methods
-    bool isBaking() { return _isBaking.load(); }
-    bool wasAborted() const { return _wasAborted.load(); }
+    bool isBaking() const { return _isBaking; }
+    bool wasAborted() const { return _wasAborted; }
 
-    void run() override;
+    // copies the asset to a temporary directory and queues an oven process for it on the worker pool
+    void start(BakeWorkerPool& workerPool);
 
 public slots:
     void abort();
@@ -40,14 +39,21 @@ signals:
     void bakeComplete(QString assetHash, QString assetPath, QString tempOutputDir);
     void bakeFailed(QString assetHash, QString assetPath, QString errors);
     void bakeAborted(QString assetHash, QString assetPath);
-    
+
+private slots:
+    void handleJobStarted(quint32 jobID);
+    void handleJobFinished(quint32 jobID, int exitCode, QProcess::ExitStatus exitStatus);
+    void handleJobAborted(quint32 jobID);
+
 private:
-    std::atomic<bool> _isBaking { false };
+    bool _isBaking { false };
     AssetUtils::AssetHash _assetHash;
     AssetUtils::AssetPath _assetPath;
     QString _filePath;
-    std::unique_ptr<QProcess> _ovenProcess { nullptr };
-    std::atomic<bool> _wasAborted { false };
+    QString _tempOutputDir;
+    BakeWorkerPool* _workerPool { nullptr };
+    quint32 _jobID { 0 };
+    bool _wasAborted { false };
 };
 
 #endif // hifi_BakeAssetTask_h
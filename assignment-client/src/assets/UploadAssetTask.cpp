@@ -11,6 +11,8 @@
 
 #include "UploadAssetTask.h"
 
+#include <algorithm>
+
 #include <QtCore/QBuffer>
 #include <QtCore/QFile>
 
@@ -54,8 +56,10 @@ void UploadAssetTask::run() {
     if (fileSize > _filesizeLimit) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
-        
+        // reference the file content in place in the received message instead of copying it out
+        auto bytesAvailable = std::min((qint64)fileSize, buffer.bytesAvailable());
+        QByteArray fileData = QByteArray::fromRawData(data.constData() + buffer.pos(), bytesAvailable);
+
         auto hash = AssetUtils::hashData(fileData);
         auto hexHash = hash.toHex();
 
@@ -71,7 +75,7 @@ void UploadAssetTask::run() {
         
         if (file.exists()) {
             // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
+            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashDevice(file) == hash) {
                 qDebug() << "Not overwriting existing verified file: " << hexHash;
 
                 existingCorrectFile = true;
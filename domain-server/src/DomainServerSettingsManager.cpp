@@ -72,6 +72,7 @@ DomainServerSettingsManager::DomainServerSettingsManager() {
             if (descriptionObject.contains(DESCRIPTION_SETTINGS_KEY)) {
                 _descriptionArray = descriptionDocument.object()[DESCRIPTION_SETTINGS_KEY].toArray();
                 splitSettingsDescription();
+                compileDefaultValues();
 
                 return;
             }
@@ -176,6 +177,41 @@ void DomainServerSettingsManager::splitSettingsDescription() {
     _settingsMenuGroups[SPLIT_MENU_GROUPS_CONTENT_SETTINGS_KEY] = contentSettingsMenuGroups;
 }
 
+void DomainServerSettingsManager::compileDefaultValues() {
+    // flatten the default value for each described setting into a hash keyed by its full key path
+    // so that valueOrDefaultValueForKeyPath doesn't need to walk the description array on every miss
+    _defaultValues.clear();
+    QSet<QString> describedGroups;
+
+    foreach(const QJsonValue& group, _descriptionArray) {
+        QJsonObject groupObject = group.toObject();
+        QString groupName = groupObject[DESCRIPTION_NAME_KEY].toString();
+
+        if (describedGroups.contains(groupName)) {
+            // only the first group with a given name is ever consulted for defaults
+            continue;
+        }
+
+        describedGroups.insert(groupName);
+
+        foreach(const QJsonValue& settingDescription, groupObject[DESCRIPTION_SETTINGS_KEY].toArray()) {
+            QJsonObject settingObject = settingDescription.toObject();
+            QString keyPath = groupName + "." + settingObject[DESCRIPTION_NAME_KEY].toString();
+
+            if (!_defaultValues.contains(keyPath)) {
+                _defaultValues.insert(keyPath, settingObject[SETTING_DEFAULT_KEY].toVariant());
+            }
+        }
+    }
+}
+
+void DomainServerSettingsManager::invalidateResolvedValues() {
+    // callers hold a write lock of _settingsLock (or are still in setup), so no reader can be
+    // about to insert a value resolved from the config map as it was before this change
+    QMutexLocker locker(&_resolvedValuesMutex);
+    _resolvedValues.clear();
+}
+
 void DomainServerSettingsManager::processSettingsRequestPacket(QSharedPointer<ReceivedMessage> message) {
     Assignment::Type type;
     message->readPrimitive(&type);
@@ -449,6 +485,9 @@ void DomainServerSettingsManager::setupConfigMap(const QString& userConfigFilena
         persistToFile();
     }
 
+    // we changed the config map without a write lock above, so drop anything resolved in the meantime
+    invalidateResolvedValues();
+
     unpackPermissions();
 }
 
@@ -482,6 +521,7 @@ void DomainServerSettingsManager::packPermissionsForMap(QString mapName,
                                                         QString keyPath) {
     // grab a write lock on the settings mutex since we're about to change the config map
     QWriteLocker locker(&_settingsLock);
+    invalidateResolvedValues();
 
     // find (or create) the "security" section of the settings map
     QVariant* security = _configMap.valueForKeyPath("security", true);
@@ -1050,42 +1090,35 @@ NodePermissions DomainServerSettingsManager::getForbiddensForGroup(const QUuid&
 
 QVariant DomainServerSettingsManager::valueForKeyPath(const QString& keyPath) {
     QReadLocker locker(&_settingsLock);
-    auto foundValue = _configMap.valueForKeyPath(keyPath);
-    return foundValue ? *foundValue : QVariant();
-}
-
-QVariant DomainServerSettingsManager::valueOrDefaultValueForKeyPath(const QString& keyPath) {
-    QReadLocker locker(&_settingsLock);
-    const QVariant* foundValue = _configMap.valueForKeyPath(keyPath);
 
-    if (foundValue) {
-        return *foundValue;
-    } else {
-        // we don't need the settings lock anymore since we're done reading from the config map
-        locker.unlock();
+    {
+        QMutexLocker resolvedLocker(&_resolvedValuesMutex);
+        auto it = _resolvedValues.constFind(keyPath);
+        if (it != _resolvedValues.constEnd()) {
+            return it.value();
+        }
+    }
 
-        int dotIndex = keyPath.indexOf('.');
+    // first read of this key path since the config map last changed, walk the map and remember the result
+    // (including a miss) while we still hold the read lock so a writer can't invalidate in between
+    auto foundValue = _configMap.valueForKeyPath(keyPath);
+    QVariant resolvedValue = foundValue ? *foundValue : QVariant();
 
-        QString groupKey = keyPath.mid(0, dotIndex);
-        QString settingKey = keyPath.mid(dotIndex + 1);
+    QMutexLocker resolvedLocker(&_resolvedValuesMutex);
+    _resolvedValues.insert(keyPath, resolvedValue);
 
-        foreach(const QVariant& group, _descriptionArray.toVariantList()) {
-            QVariantMap groupMap = group.toMap();
+    return resolvedValue;
+}
 
-            if (groupMap[DESCRIPTION_NAME_KEY].toString() == groupKey) {
-                foreach(const QVariant& setting, groupMap[DESCRIPTION_SETTINGS_KEY].toList()) {
-                    QVariantMap settingMap = setting.toMap();
-                    if (settingMap[DESCRIPTION_NAME_KEY].toString() == settingKey) {
-                        return settingMap[SETTING_DEFAULT_KEY];
-                    }
-                }
+QVariant DomainServerSettingsManager::valueOrDefaultValueForKeyPath(const QString& keyPath) {
+    QVariant foundValue = valueForKeyPath(keyPath);
 
-                return QVariant();
-            }
-        }
+    if (foundValue.isValid()) {
+        return foundValue;
+    } else {
+        // _defaultValues is only written during construction so it is safe to read without the settings lock
+        return _defaultValues.value(keyPath);
     }
-
-    return QVariant();
 }
 
 bool DomainServerSettingsManager::handleAuthenticatedHTTPRequest(HTTPConnection *connection, const QUrl &url) {
@@ -1210,6 +1243,7 @@ bool DomainServerSettingsManager::restoreSettingsFromObject(QJsonObject settings
 
     // grab a write lock since we're about to change the settings map
     QWriteLocker locker(&_settingsLock);
+    invalidateResolvedValues();
 
     QJsonArray* filteredDescriptionArray = settingsType == DomainSettings
         ? &_domainSettingsDescription : &_contentSettingsDescription;
@@ -1549,6 +1583,7 @@ bool DomainServerSettingsManager::recurseJSONObjectAndOverwriteSettings(const QJ
 
     // take a write lock since we're about to overwrite settings in the config map
     QWriteLocker locker(&_settingsLock);
+    invalidateResolvedValues();
 
     static const QString SECURITY_ROOT_KEY = "security";
     static const QString AC_SUBNET_WHITELIST_KEY = "ac_subnet_whitelist";
@@ -1681,6 +1716,7 @@ bool permissionVariantLessThan(const QVariant &v1, const QVariant &v2) {
 void DomainServerSettingsManager::sortPermissions() {
     // take a write lock since we're about to change the config map data
     QWriteLocker locker(&_settingsLock);
+    invalidateResolvedValues();
 
     // sort the permission-names
     QVariant* standardPermissions = _configMap.valueForKeyPath(AGENT_STANDARD_PERMISSIONS_KEYPATH);
@@ -1708,6 +1744,19 @@ void DomainServerSettingsManager::sortPermissions() {
 void DomainServerSettingsManager::persistToFile() {
     sortPermissions();
 
+    QByteArray settingsJSON;
+
+    {
+        // take a read lock so we can grab the config and serialize it
+        QReadLocker locker(&_settingsLock);
+        settingsJSON = QJsonDocument::fromVariant(_configMap.getConfig()).toJson();
+    }
+
+    if (settingsJSON == _lastPersistedSettings) {
+        // nothing changed since our last successful write, skip hitting the disk
+        return;
+    }
+
     // make sure we have the dir the settings file is supposed to live in
     QFileInfo settingsFileInfo(_configMap.getUserConfigFilename());
 
@@ -1717,16 +1766,17 @@ void DomainServerSettingsManager::persistToFile() {
 
     QFile settingsFile(_configMap.getUserConfigFilename());
 
-    if (settingsFile.open(QIODevice::WriteOnly)) {
-        // take a read lock so we can grab the config and write it to file
-        QReadLocker locker(&_settingsLock);
-        settingsFile.write(QJsonDocument::fromVariant(_configMap.getConfig()).toJson());
+    if (settingsFile.open(QIODevice::WriteOnly) && settingsFile.write(settingsJSON) == settingsJSON.size()) {
+        _lastPersistedSettings = settingsJSON;
     } else {
         qCritical("Could not write to JSON settings file. Unable to persist settings.");
 
+        _lastPersistedSettings.clear();
+
         // failed to write, reload whatever the current config state is
         // with a write lock since we're about to overwrite the config map
         QWriteLocker locker(&_settingsLock);
+        invalidateResolvedValues();
         _configMap.loadConfig();
     }
 }
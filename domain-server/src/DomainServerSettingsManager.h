@@ -15,6 +15,7 @@
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QMutex>
 #include <QtNetwork/QNetworkReply>
 
 #include <HifiConfigVariantMap.h>
@@ -53,6 +54,7 @@ public:
 
     // each of the three methods in this group takes a read lock of _settingsLock
     // and cannot be called when the a write lock is held by the same thread
+    // resolved values are cached per key path until the next change to the config map
     QVariant valueOrDefaultValueForKeyPath(const QString& keyPath);
     QVariant valueForKeyPath(const QString& keyPath);
     bool containsKeyPath(const QString& keyPath) { return valueForKeyPath(keyPath).isValid(); }
@@ -155,6 +157,10 @@ private:
     void persistToFile();
 
     void splitSettingsDescription();
+    void compileDefaultValues();
+
+    // must be called with a write lock of _settingsLock held, whenever the config map is changed
+    void invalidateResolvedValues();
 
     double _descriptionVersion;
 
@@ -167,6 +173,16 @@ private:
     // is done with the returned QVariant*
     HifiConfigVariantMap _configMap;
 
+    // values resolved from _configMap (or a miss) by key path, cleared whenever _configMap changes
+    QHash<QString, QVariant> _resolvedValues;
+    QMutex _resolvedValuesMutex;
+
+    // default value for each described setting by key path, built once from _descriptionArray
+    QHash<QString, QVariant> _defaultValues;
+
+    // the settings JSON last written to disk, so unchanged settings aren't re-written
+    QByteArray _lastPersistedSettings;
+
     // these cause calls to metaverse's group api
     void apiGetGroupID(const QString& groupName);
     void apiGetGroupRanks(const QUuid& groupID);
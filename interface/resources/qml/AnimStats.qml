@@ -131,6 +131,9 @@ Item {
                     StatText {
                         text: root.walkingText
                     }
+                    StatText {
+                        text: root.nodeEvaluationText
+                    }
                     StatText {
                         text: "Alpha Values:--------------------------------------------------------------------------"
                     }
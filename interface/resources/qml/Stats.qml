@@ -258,6 +258,20 @@ Item {
                         text: "Processing: " + root.processing +
                               ", Pending: " + root.processingPending;
                     }
+                    StatText {
+                        visible: root.expanded;
+                        text: "Entry Decode Time: " + (root.entryDecodeTime < 0 ? "--" : root.entryDecodeTime + " ms");
+                    }
+                    StatText {
+                        visible: root.expanded;
+                        text: "Model Cache Hits/Misses/Evictions: " + root.modelCacheStats.x + "/" +
+                              root.modelCacheStats.y + "/" + root.modelCacheStats.z;
+                    }
+                    StatText {
+                        visible: root.expanded;
+                        text: "Texture Cache Hits/Misses/Evictions: " + root.textureCacheStats.x + "/" +
+                              root.textureCacheStats.y + "/" + root.textureCacheStats.z;
+                    }
                     StatText {
                         visible: root.expanded && root.downloadUrls.length > 0;
                         text: "Download URLs:"
@@ -107,6 +107,7 @@
 #include <ModelEntityItem.h>
 #include <NetworkAccessManager.h>
 #include <NetworkingConstants.h>
+#include <NumericalConstants.h>
 #include <ObjectMotionState.h>
 #include <OctalCode.h>
 #include <OctreeSceneStats.h>
@@ -339,6 +340,9 @@ static const QString DESKTOP_LOCATION = QStandardPaths::writableLocation(QStanda
 
 Setting::Handle<int> maxOctreePacketsPerSecond{"maxOctreePPS", DEFAULT_MAX_OCTREE_PPS};
 
+// GPU memory kept by unused textures, none by default
+Setting::Handle<int> unusedTextureGPUCacheSizeMB{"unusedTextureGPUCacheSizeMB", 0};
+
 Setting::Handle<bool> loginDialogPoppedUp{"loginDialogPoppedUp", false};
 
 static const QUrl AVATAR_INPUTS_BAR_QML = PathUtils::qmlUrl("AvatarInputsBar.qml");
@@ -1268,6 +1272,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
             _entityServerConnectionTimer.start();
             _failedToConnectToEntityServer = false;
         }
+        DependencyManager::get<ResourceCacheSharedItems>()->getDecodeScheduler().startDomainEntry();
     });
     connect(&domainHandler, &DomainHandler::domainConnectionRefused, this, &Application::domainConnectionRefused);
 
@@ -1326,6 +1331,8 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     connect(addressManager.data(), &AddressManager::hostChanged, this, &Application::updateWindowTitle);
     connect(this, &QCoreApplication::aboutToQuit, addressManager.data(), &AddressManager::storeCurrentAddress);
 
+    DependencyManager::get<TextureCache>()->setUnusedResourceGPUCacheSize(MB_TO_BYTES(unusedTextureGPUCacheSizeMB.get()));
+
     connect(this, &Application::activeDisplayPluginChanged, this, &Application::updateThreadPoolCount);
     connect(this, &Application::activeDisplayPluginChanged, this, [](){
         qApp->setProperty(hifi::properties::HMD, qApp->isHMDMode());
@@ -2718,8 +2725,13 @@ void Application::cleanupBeforeQuit() {
 
     getEntities()->shutdown(); // tell the entities system we're shutting down, so it will stop running scripts
 
-    // Clear any queued processing (I/O, FBX/OBJ/Texture parsing)
+    // Clear any queued processing (I/O, FBX/OBJ/Texture parsing), and let the decoding already running complete
     QThreadPool::globalInstance()->clear();
+    {
+        auto& decodeScheduler = DependencyManager::get<ResourceCacheSharedItems>()->getDecodeScheduler();
+        decodeScheduler.clear();
+        decodeScheduler.waitForDone();
+    }
 
     DependencyManager::destroy<RecordingScriptingInterface>();
 
@@ -5475,6 +5487,9 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    // cache collision mesh BVHs so revisiting a domain doesn't rebuild them
+    static const QString BVH_CACHE_DIRECTORY = "collisionBvhs/";
+    _shapeManager.setBvhCacheDirectory(PathUtils::getAppLocalDataPath() + BVH_CACHE_DIRECTORY);
     ObjectMotionState::setShapeManager(&_shapeManager);
     _physicsEngine->init();
 
@@ -6180,6 +6195,7 @@ void Application::update(float deltaTime) {
                 // scene is ready to compute its collision shape.
                 if (getMyAvatar()->isReadyForPhysics()) {
                     _physicsEnabled = true;
+                    DependencyManager::get<ResourceCacheSharedItems>()->getDecodeScheduler().finishDomainEntry();
                     setIsInterstitialMode(false);
                     getMyAvatar()->updateMotionBehaviorFromMenu();
                 }
@@ -8743,6 +8759,15 @@ int Application::getMaxOctreePacketsPerSecond() const {
     return _maxOctreePPS;
 }
 
+void Application::setUnusedTextureGPUCacheSizeMB(int sizeMB) {
+    unusedTextureGPUCacheSizeMB.set(sizeMB);
+    DependencyManager::get<TextureCache>()->setUnusedResourceGPUCacheSize(MB_TO_BYTES(sizeMB));
+}
+
+int Application::getUnusedTextureGPUCacheSizeMB() const {
+    return (int)BYTES_TO_MB(DependencyManager::get<TextureCache>()->getUnusedResourceGPUCacheSize());
+}
+
 qreal Application::getDevicePixelRatio() {
     return (_window && _window->windowHandle()) ? _window->windowHandle()->devicePixelRatio() : 1.0;
 }
@@ -8988,6 +9013,10 @@ void Application::setShowBulletConstraintLimits(bool value) {
     _physicsEngine->setShowBulletConstraintLimits(value);
 }
 
+void Application::setMultithreadedPhysics(bool value) {
+    _physicsEngine->setMultithreaded(value);
+}
+
 void Application::createLoginDialog() {
     const glm::vec3 LOGIN_DIMENSIONS { 0.89f, 0.5f, 0.01f };
     const auto OFFSET = glm::vec2(0.7f, -0.1f);
@@ -9272,11 +9301,15 @@ static const int OS_RESERVED_THREADS = 1;
 void Application::updateThreadPoolCount() const {
     auto reservedThreads = UI_RESERVED_THREADS + OS_RESERVED_THREADS + _displayPlugin->getRequiredThreadCount();
     auto availableThreads = QThread::idealThreadCount() - reservedThreads;
-    auto threadPoolSize = std::max(MIN_PROCESSING_THREAD_POOL_SIZE, availableThreads);
+    // resource decoding used to run on the global pool, split the available threads with it rather than adding to them
+    auto decodeThreadCount = std::max(MIN_PROCESSING_THREAD_POOL_SIZE, availableThreads / 2);
+    auto threadPoolSize = std::max(MIN_PROCESSING_THREAD_POOL_SIZE, availableThreads - decodeThreadCount);
     qCDebug(interfaceapp) << "Ideal Thread Count " << QThread::idealThreadCount();
     qCDebug(interfaceapp) << "Reserved threads " << reservedThreads;
     qCDebug(interfaceapp) << "Setting thread pool size to " << threadPoolSize;
+    qCDebug(interfaceapp) << "Setting decode thread pool size to " << decodeThreadCount;
     QThreadPool::globalInstance()->setMaxThreadCount(threadPoolSize);
+    DependencyManager::get<ResourceCacheSharedItems>()->getDecodeScheduler().setThreadCount(decodeThreadCount);
 }
 
 void Application::updateSystemTabletMode() {
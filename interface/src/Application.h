@@ -284,6 +284,9 @@ public:
     void setMaxOctreePacketsPerSecond(int maxOctreePPS);
     int getMaxOctreePacketsPerSecond() const;
 
+    void setUnusedTextureGPUCacheSizeMB(int sizeMB);
+    int getUnusedTextureGPUCacheSizeMB() const;
+
     render::ScenePointer getMain3DScene() override { return _graphicsEngine.getRenderScene(); }
     render::EnginePointer getRenderEngine() override { return  _graphicsEngine.getRenderEngine(); }
     gpu::ContextPointer getGPUContext() const { return _graphicsEngine.getGPUContext(); }
@@ -540,6 +543,7 @@ private slots:
     void setShowBulletContactPoints(bool value);
     void setShowBulletConstraints(bool value);
     void setShowBulletConstraintLimits(bool value);
+    void setMultithreadedPhysics(bool value);
 
     void onDismissedLoginDialog();
 
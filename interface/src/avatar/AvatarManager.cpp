@@ -35,6 +35,7 @@
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <TBBHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
@@ -289,6 +290,21 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     const uint64_t MAX_UPDATE_HEROS_TIME_BUDGET = uint64_t(0.8 * MAX_UPDATE_AVATARS_TIME_BUDGET);
 
     uint64_t updatePriorityExpiries[NumVariants] = { startTime + MAX_UPDATE_HEROS_TIME_BUDGET, startTime + MAX_UPDATE_AVATARS_TIME_BUDGET };
+
+    // The rigs are posed in parallel, a batch at a time just ahead of the avatars the budget reaches,
+    // so that no time is spent posing the avatars the budget then skips.
+    const ptrdiff_t poseBatchSize = std::max(1, QThread::idealThreadCount());
+    auto computeJointPoses = [](std::vector<SortableAvatar>::const_iterator begin, std::vector<SortableAvatar>::const_iterator end) {
+        PROFILE_RANGE(simulation, "computeJointPoses");
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, end - begin), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i < range.end(); i++) {
+                const SortableAvatar& sortData = *(begin + i);
+                bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
+                std::static_pointer_cast<OtherAvatar>(sortData.getAvatar())->computeJointPoses(inView);
+            }
+        });
+    };
+
     int numHerosUpdated = 0;
     int numAvatarsUpdated = 0;
     int numAvatarsNotUpdated = 0;
@@ -302,6 +318,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         const auto& sortedAvatarVector = priorityQueue.getSortedVector();
 
         auto passExpiry = updatePriorityExpiries[p];
+        auto poseBatchEnd = sortedAvatarVector.begin();
 
         for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
             const SortableAvatar& sortData = *it;
@@ -330,6 +347,11 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             uint64_t now = usecTimestampNow();
             if (now < passExpiry) {
                 // we're within budget
+                if (it == poseBatchEnd) {
+                    poseBatchEnd = it + std::min(poseBatchSize, sortedAvatarVector.end() - it);
+                    computeJointPoses(it, poseBatchEnd);
+                }
+
                 bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
                 if (inView && avatar->hasNewJointData()) {
                     numAvatarsUpdated++;
@@ -241,6 +241,18 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
     }
 }
 
+void OtherAvatar::computeJointPoses(bool inView) {
+    _jointPosesComputed = false;
+    if (inView && (_hasNewJointData || _transit.isActive())) {
+        PROFILE_RANGE(simulation, "computeJointPoses");
+        auto& rig = _skeletonModel->getRig();
+        rig.copyJointsFromJointData(getJointData());
+        glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+        rig.computeExternalPoses(rootTransform);
+        _jointPosesComputed = true;
+    }
+}
+
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
 
@@ -260,9 +272,10 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
         if (inView) {
             Head* head = getHead();
             if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+                // usually already done by AvatarManager, unless the transit started this frame
+                if (!_jointPosesComputed) {
+                    computeJointPoses(inView);
+                }
                 _jointDataSimulationRate.increment();
 
                 _skeletonModel->simulate(deltaTime, true);
@@ -284,6 +297,7 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
             _skeletonModel->simulate(deltaTime, false);
         }
         _skeletonModelSimulationRate.increment();
+        _jointPosesComputed = false;
     }
 
     // update animation for display name fade in/out
@@ -63,6 +63,9 @@ public:
 
     void setCollisionWithOtherAvatarsFlags() override;
 
+    // The part of simulate() which only touches this avatar's own rig, so that AvatarManager can run it
+    // for many avatars at once on worker threads. simulate() then applies the result on the main thread.
+    void computeJointPoses(bool inView);
     void simulate(float deltaTime, bool inView) override;
     void debugJointData() const;
     friend AvatarManager;
@@ -91,6 +94,7 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsReinsertion { false };
+    bool _jointPosesComputed { false };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
@@ -94,6 +94,13 @@ void AnimStats::updateStats(bool force) {
     }
     emit walkingTextChanged();
 
+    // how many anim node evaluations there were since the last update
+    uint64_t nodeEvaluationCount = myAvatar->getSkeletonModel()->getRig().getAnimNodeEvaluationCount();
+    uint64_t newEvaluations = nodeEvaluationCount - std::min(nodeEvaluationCount, _prevNodeEvaluationCount);
+    _prevNodeEvaluationCount = nodeEvaluationCount;
+    _nodeEvaluationText = QString("Node Evaluations: %1").arg(newEvaluations);
+    emit nodeEvaluationTextChanged();
+
     // update animation debug alpha values
     QStringList newAnimAlphaValues;
     qint64 now = usecTimestampNow();
@@ -25,6 +25,7 @@ class AnimStats : public QQuickItem {
     Q_PROPERTY(QString recenterText READ recenterText NOTIFY recenterTextChanged)
     Q_PROPERTY(QString sittingText READ sittingText NOTIFY sittingTextChanged)
     Q_PROPERTY(QString walkingText READ walkingText NOTIFY walkingTextChanged)
+    Q_PROPERTY(QString nodeEvaluationText READ nodeEvaluationText NOTIFY nodeEvaluationTextChanged)
 
 public:
     static AnimStats* getInstance();
@@ -43,6 +44,7 @@ public:
     QString recenterText() const { return _recenterText; }
     QString sittingText() const { return _sittingText; }
     QString walkingText() const { return _walkingText; }
+    QString nodeEvaluationText() const { return _nodeEvaluationText; }
 
 public slots:
     void forceUpdateStats() { updateStats(true); }
@@ -58,6 +60,7 @@ signals:
     void recenterTextChanged();
     void sittingTextChanged();
     void walkingTextChanged();
+    void nodeEvaluationTextChanged();
 
 private:
     QStringList _animAlphaValues;
@@ -76,6 +79,8 @@ private:
     QString _recenterText;
     QString _sittingText;
     QString _walkingText;
+    QString _nodeEvaluationText;
+    uint64_t _prevNodeEvaluationCount { 0 };
 };
 
 #endif // hifi_AnimStats_h
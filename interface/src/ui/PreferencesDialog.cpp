@@ -104,6 +104,16 @@ void setupPreferences() {
         preferences->addPreference(preference);
     }
 
+    {
+        auto getter = []()->float { return qApp->getUnusedTextureGPUCacheSizeMB(); };
+        auto setter = [](float value) { qApp->setUnusedTextureGPUCacheSizeMB(value); };
+        auto preference = new SpinnerPreference(GRAPHICS_QUALITY, "Texture memory kept for reuse (MB)", getter, setter);
+        preference->setMin(0);
+        preference->setMax(4096);
+        preference->setStep(64);
+        preferences->addPreference(preference);
+    }
+
     // UI
     static const QString UI_CATEGORY { "User Interface" };
     {
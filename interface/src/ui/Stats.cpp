@@ -23,10 +23,12 @@
 #include <AudioClient.h>
 #include <GeometryCache.h>
 #include <LODManager.h>
+#include <model-networking/ModelCache.h>
 #include <OffscreenUi.h>
 #include <PerfStat.h>
 #include <plugins/DisplayPlugin.h>
 #include <PickManager.h>
+#include <TextureCache.h>
 
 #include <gl/Context.h>
 
@@ -288,6 +290,13 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(downloadsPending, (int)ResourceCache::getPendingRequestCount());
         STAT_UPDATE(processing, DependencyManager::get<StatTracker>()->getStat("Processing").toInt());
         STAT_UPDATE(processingPending, DependencyManager::get<StatTracker>()->getStat("PendingProcessing").toInt());
+        STAT_UPDATE(entryDecodeTime, (int)DependencyManager::get<ResourceCacheSharedItems>()->getDecodeScheduler().getDomainEntryDecodeTime());
+        {
+            auto modelCache = DependencyManager::get<ModelCache>();
+            STAT_UPDATE(modelCacheStats, QVector3D(modelCache->getNumHits(), modelCache->getNumMisses(), modelCache->getNumEvictions()));
+            auto textureCache = DependencyManager::get<TextureCache>();
+            STAT_UPDATE(textureCacheStats, QVector3D(textureCache->getNumHits(), textureCache->getNumMisses(), textureCache->getNumEvictions()));
+        }
 
         // See if the active download urls have changed
         bool shouldUpdateUrls = _downloads != _downloadUrls.size();
@@ -96,6 +96,10 @@ private: \
  * @property {string[]} downloadUrls - <em>Read-only.</em>
  * @property {number} processing - <em>Read-only.</em>
  * @property {number} processingPending - <em>Read-only.</em>
+ * @property {number} entryDecodeTime - The time in ms from entering the domain until it had loaded and the resources it
+ *     requested had decoded, <code>-1</code> while still loading. <em>Read-only.</em>
+ * @property {Vec3} modelCacheStats - The hits, misses and evictions of the model cache. <em>Read-only.</em>
+ * @property {Vec3} textureCacheStats - The hits, misses and evictions of the texture cache. <em>Read-only.</em>
  * @property {number} triangles - <em>Read-only.</em>
  * @property {number} materialSwitches - <em>Read-only.</em>
  * @property {number} itemConsidered - <em>Read-only.</em>
@@ -257,6 +261,9 @@ class Stats : public QQuickItem {
     Q_PROPERTY(QStringList downloadUrls READ downloadUrls NOTIFY downloadUrlsChanged)
     STATS_PROPERTY(int, processing, 0)
     STATS_PROPERTY(int, processingPending, 0)
+    STATS_PROPERTY(int, entryDecodeTime, -1)
+    STATS_PROPERTY(QVector3D, modelCacheStats, QVector3D(0, 0, 0))
+    STATS_PROPERTY(QVector3D, textureCacheStats, QVector3D(0, 0, 0))
     STATS_PROPERTY(int, triangles, 0)
     STATS_PROPERTY(int, drawcalls, 0)
     STATS_PROPERTY(int, materialSwitches, 0)
@@ -755,6 +762,27 @@ signals:
      */
     void processingPendingChanged();
 
+    /**jsdoc
+     * Triggered when the value of the <code>entryDecodeTime</code> property changes.
+     * @function Stats.entryDecodeTimeChanged
+     * @returns {Signal}
+     */
+    void entryDecodeTimeChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>modelCacheStats</code> property changes.
+     * @function Stats.modelCacheStatsChanged
+     * @returns {Signal}
+     */
+    void modelCacheStatsChanged();
+
+    /**jsdoc
+     * Triggered when the value of the <code>textureCacheStats</code> property changes.
+     * @function Stats.textureCacheStatsChanged
+     * @returns {Signal}
+     */
+    void textureCacheStatsChanged();
+
     /**jsdoc
      * Triggered when the value of the <code>triangles</code> property changes.
      * @function Stats.trianglesChanged
@@ -24,7 +24,7 @@ AnimBlendLinear::~AnimBlendLinear() {
 
 }
 
-const AnimPoseVec& AnimBlendLinear::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
+const AnimPoseVec& AnimBlendLinear::evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
 
     _alpha = animVars.lookup(_alphaVar, _alpha);
     float parentDebugAlpha = context.getDebugAlpha(_id);
@@ -46,7 +46,7 @@ static float calculateAlpha(const float speed, const std::vector<float>& charact
     return alpha;
 }
 
-const AnimPoseVec& AnimBlendLinearMove::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
+const AnimPoseVec& AnimBlendLinearMove::evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
 
     assert(_children.size() == _characteristicSpeeds.size());
 
@@ -30,7 +30,7 @@ AnimClip::~AnimClip() {
 
 }
 
-const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
+const AnimPoseVec& AnimClip::evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
 
     // lookup parameters from animVars, using current instance variables as defaults.
     _startFrame = animVars.lookup(_startFrameVar, _startFrame);
@@ -43,18 +43,30 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame, dt, _loopFlag, _id, triggersOut);
 
     // poll network anim to see if it's finished loading yet.
-    if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
-        // loading is complete, copy animation frames from network animation, then throw it away.
+    if (!_isNetworkAnimCopied && _networkAnim && _networkAnim->isLoaded() && _skeleton) {
+        // loading is complete, copy animation frames from network animation, then throw it away,
+        // unless the clip may need the mirrored frames later, which are retargeted from it as well.
         copyFromNetworkAnim();
-        _networkAnim.reset();
+        if (!_mirrorFlag && _mirrorFlagVar.isEmpty()) {
+            _networkAnim.reset();
+        }
     }
 
-    if (_anim.size()) {
+    if (_anim && _anim->getNumFrames() > 0) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
-            buildMirrorAnim();
+        if (_mirrorFlag && !_mirrorAnim) {
+            auto animCache = DependencyManager::get<AnimationCache>();
+            if (!_networkAnim) {
+                // the clip didn't expect to be mirrored and let go of its animation, get it back
+                _networkAnim = animCache->getAnimation(_url);
+            }
+            if (_networkAnim->isLoaded()) {
+                _mirrorAnim = animCache->getRetargetedAnimation(_networkAnim, *_skeleton, true);
+                _networkAnim.reset();
+            }
         }
+        const AnimClipData& anim = (_mirrorFlag && _mirrorAnim) ? *_mirrorAnim : *_anim;
 
         int prevIndex = (int)glm::floor(_frame);
         int nextIndex;
@@ -66,15 +78,13 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = anim.getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
         float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        anim.blendFrames(prevIndex, nextIndex, alpha, _poses);
     }
 
     processOutputJoints(triggersOut);
@@ -85,6 +95,7 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 void AnimClip::loadURL(const QString& url) {
     auto animCache = DependencyManager::get<AnimationCache>();
     _networkAnim = animCache->getAnimation(url);
+    _isNetworkAnimCopied = false;
     _url = url;
 }
 
@@ -95,154 +106,17 @@ void AnimClip::setCurrentFrameInternal(float frame) {
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame + _startFrame, dt, _loopFlag, _id, triggers);
 }
 
-static std::vector<int> buildJointIndexMap(const AnimSkeleton& dstSkeleton, const AnimSkeleton& srcSkeleton) {
-    std::vector<int> jointIndexMap;
-    int srcJointCount = srcSkeleton.getNumJoints();
-    jointIndexMap.reserve(srcJointCount);
-    for (int srcJointIndex = 0; srcJointIndex < srcJointCount; srcJointIndex++) {
-        QString srcJointName = srcSkeleton.getJointName(srcJointIndex);
-        int dstJointIndex = dstSkeleton.nameToJointIndex(srcJointName);
-        jointIndexMap.push_back(dstJointIndex);
-    }
-    return jointIndexMap;
-}
-
 void AnimClip::copyFromNetworkAnim() {
     assert(_networkAnim && _networkAnim->isLoaded() && _skeleton);
-    _anim.clear();
-
-    auto avatarSkeleton = getSkeleton();
-    const HFMModel& animModel = _networkAnim->getHFMModel();
-    AnimSkeleton animSkeleton(animModel);
-    const int animJointCount = animSkeleton.getNumJoints();
-    const int avatarJointCount = avatarSkeleton->getNumJoints();
-
-    // build a mapping from animation joint indices to avatar joint indices by matching joints with the same name.
-    std::vector<int> avatarToAnimJointIndexMap = buildJointIndexMap(animSkeleton, *avatarSkeleton);
-
-    const int animFrameCount = animModel.animationFrames.size();
-    _anim.resize(animFrameCount);
-
-    // find the size scale factor for translation in the animation.
-    float boneLengthScale = 1.0f;
-    const int avatarHipsIndex = avatarSkeleton->nameToJointIndex("Hips");
-    const int animHipsIndex = animSkeleton.nameToJointIndex("Hips");
-    if (avatarHipsIndex != -1 && animHipsIndex != -1) {
-        const int avatarHipsParentIndex = avatarSkeleton->getParentIndex(avatarHipsIndex);
-        const int animHipsParentIndex = animSkeleton.getParentIndex(animHipsIndex);
-
-        const AnimPose& avatarHipsAbsoluteDefaultPose = avatarSkeleton->getAbsoluteDefaultPose(avatarHipsIndex);
-        const AnimPose& animHipsAbsoluteDefaultPose = animSkeleton.getAbsoluteDefaultPose(animHipsIndex);
-
-        // the get the units and the heights for the animation and the avatar
-        const float avatarUnitScale = extractScale(avatarSkeleton->getGeometryOffset()).y;
-        const float animationUnitScale = extractScale(animModel.offset).y;
-        const float avatarHeightInMeters = avatarUnitScale * avatarHipsAbsoluteDefaultPose.trans().y;
-        const float animHeightInMeters = animationUnitScale * animHipsAbsoluteDefaultPose.trans().y;
-
-        // get the parent scales for the avatar and the animation
-        float avatarHipsParentScale = 1.0f;
-        if (avatarHipsParentIndex != -1) {
-            const AnimPose& avatarHipsParentAbsoluteDefaultPose = avatarSkeleton->getAbsoluteDefaultPose(avatarHipsParentIndex);
-            avatarHipsParentScale = avatarHipsParentAbsoluteDefaultPose.scale().y;
-        }
-        float animHipsParentScale = 1.0f;
-        if (animHipsParentIndex != -1) {
-            const AnimPose& animationHipsParentAbsoluteDefaultPose = animSkeleton.getAbsoluteDefaultPose(animHipsParentIndex);
-            animHipsParentScale = animationHipsParentAbsoluteDefaultPose.scale().y;
-        }
-
-        const float EPSILON = 0.0001f;
-        // compute the ratios for the units, the heights in meters, and the parent scales
-        if ((fabsf(animHeightInMeters) > EPSILON) && (animationUnitScale > EPSILON) && (animHipsParentScale > EPSILON)) {
-            const float avatarToAnimationHeightRatio = avatarHeightInMeters / animHeightInMeters;
-            const float unitsRatio = 1.0f / (avatarUnitScale / animationUnitScale);
-            const float parentScaleRatio = 1.0f / (avatarHipsParentScale / animHipsParentScale);
 
-            boneLengthScale = avatarToAnimationHeightRatio * unitsRatio * parentScaleRatio;
-        }
-    }
-
-    for (int frame = 0; frame < animFrameCount; frame++) {
-        const HFMAnimationFrame& animFrame = animModel.animationFrames[frame];
-
-        // extract the full rotations from the animFrame (including pre and post rotations from the animModel).
-        std::vector<glm::quat> animRotations;
-        animRotations.reserve(animJointCount);
-        for (int i = 0; i < animJointCount; i++) {
-            animRotations.push_back(animModel.joints[i].preRotation * animFrame.rotations[i] * animModel.joints[i].postRotation);
-        }
-
-        // convert rotations into absolute frame
-        animSkeleton.convertRelativeRotationsToAbsolute(animRotations);
-
-        // build absolute rotations for the avatar
-        std::vector<glm::quat> avatarRotations;
-        avatarRotations.reserve(avatarJointCount);
-        for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
-            int animJointIndex = avatarToAnimJointIndexMap[avatarJointIndex];
-            if (animJointIndex >= 0) {
-                // This joint is in both animation and avatar.
-                // Set the absolute rotation directly
-                avatarRotations.push_back(animRotations[animJointIndex]);
-            } else {
-                // This joint is NOT in the animation at all.
-                // Set it so that the default relative rotation remains unchanged.
-                glm::quat avatarRelativeDefaultRot = avatarSkeleton->getRelativeDefaultPose(avatarJointIndex).rot();
-                glm::quat avatarParentAbsoluteRot;
-                int avatarParentJointIndex = avatarSkeleton->getParentIndex(avatarJointIndex);
-                if (avatarParentJointIndex >= 0) {
-                    avatarParentAbsoluteRot = avatarRotations[avatarParentJointIndex];
-                }
-                avatarRotations.push_back(avatarParentAbsoluteRot * avatarRelativeDefaultRot);
-            }
-        }
-
-        // convert avatar rotations into relative frame
-        avatarSkeleton->convertAbsoluteRotationsToRelative(avatarRotations);
-
-        _anim[frame].reserve(avatarJointCount);
-        for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
-            const AnimPose& avatarDefaultPose = avatarSkeleton->getRelativeDefaultPose(avatarJointIndex);
-
-            // copy scale over from avatar default pose
-            glm::vec3 relativeScale = avatarDefaultPose.scale();
-
-            glm::vec3 relativeTranslation;
-            int animJointIndex = avatarToAnimJointIndexMap[avatarJointIndex];
-            if (animJointIndex >= 0) {
-                // This joint is in both animation and avatar.
-                const glm::vec3& animTrans = animFrame.translations[animJointIndex];
-
-                // retarget translation from animation to avatar
-                const glm::vec3& animZeroTrans = animModel.animationFrames[0].translations[animJointIndex];
-                relativeTranslation = avatarDefaultPose.trans() + boneLengthScale * (animTrans - animZeroTrans);
-            } else {
-                // This joint is NOT in the animation at all.
-                // preserve the default translation.
-                relativeTranslation = avatarDefaultPose.trans();
-            }
-
-            // build the final pose
-            _anim[frame].push_back(AnimPose(relativeScale, avatarRotations[avatarJointIndex], relativeTranslation));
-        }
-    }
-
-    // mirrorAnim will be re-built on demand, if needed.
-    _mirrorAnim.clear();
-
-    _poses.resize(avatarJointCount);
-}
+    auto animCache = DependencyManager::get<AnimationCache>();
+    _anim = animCache->getRetargetedAnimation(_networkAnim, *_skeleton);
+    _isNetworkAnimCopied = true;
 
-void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
+    // mirrorAnim will be looked up on demand, if needed.
+    _mirrorAnim.reset();
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
-    }
+    _poses.resize(_skeleton->getNumJoints());
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
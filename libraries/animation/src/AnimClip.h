@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "AnimClipData.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -28,7 +29,7 @@ public:
     AnimClip(const QString& id, const QString& url, float startFrame, float endFrame, float timeScale, bool loopFlag, bool mirrorFlag);
     virtual ~AnimClip() override;
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
+    virtual const AnimPoseVec& evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
 
     void setStartFrameVar(const QString& startFrameVar) { _startFrameVar = startFrameVar; }
     void setEndFrameVar(const QString& endFrameVar) { _endFrameVar = endFrameVar; }
@@ -59,17 +60,18 @@ protected:
     virtual void setCurrentFrameInternal(float frame) override;
 
     void copyFromNetworkAnim();
-    void buildMirrorAnim();
 
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
 
+    // kept after its frames are copied while the clip may still need them mirrored
     AnimationPointer _networkAnim;
+    bool _isNetworkAnimCopied { false };
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // shared with every other clip playing this animation on an equivalent skeleton
+    AnimClipData::Pointer _anim;
+    AnimClipData::Pointer _mirrorAnim;
 
     QString _url;
     float _startFrame;
@@ -0,0 +1,316 @@
+//
+//  AnimClipData.cpp
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipData.h"
+
+#include <QtCore/QCryptographicHash>
+
+#include <GLMHelpers.h>
+
+#include "AnimUtil.h"
+
+static const int PACKED_COMPONENT_BITS = 20;
+static const uint64_t PACKED_COMPONENT_MASK = (1ULL << PACKED_COMPONENT_BITS) - 1;
+static const int PACKED_INDEX_BITS = 2;
+static const uint64_t PACKED_INDEX_MASK = (1ULL << PACKED_INDEX_BITS) - 1;
+
+// the three smallest components of a unit quaternion lie within +/- 1/sqrt(2)
+static const float PACKED_COMPONENT_RANGE = 0.70710678f;
+
+static std::vector<int> buildJointIndexMap(const AnimSkeleton& dstSkeleton, const AnimSkeleton& srcSkeleton) {
+    std::vector<int> jointIndexMap;
+    int srcJointCount = srcSkeleton.getNumJoints();
+    jointIndexMap.reserve(srcJointCount);
+    for (int srcJointIndex = 0; srcJointIndex < srcJointCount; srcJointIndex++) {
+        QString srcJointName = srcSkeleton.getJointName(srcJointIndex);
+        int dstJointIndex = dstSkeleton.nameToJointIndex(srcJointName);
+        jointIndexMap.push_back(dstJointIndex);
+    }
+    return jointIndexMap;
+}
+
+AnimClipData::AnimClipData(const HFMModel& animModel, const AnimSkeleton& avatarSkeleton, bool mirrored) {
+    AnimSkeleton animSkeleton(animModel);
+    const int animJointCount = animSkeleton.getNumJoints();
+    const int avatarJointCount = avatarSkeleton.getNumJoints();
+
+    // build a mapping from animation joint indices to avatar joint indices by matching joints with the same name.
+    std::vector<int> avatarToAnimJointIndexMap = buildJointIndexMap(animSkeleton, avatarSkeleton);
+
+    const int animFrameCount = animModel.animationFrames.size();
+    std::vector<AnimPoseVec> frames(animFrameCount);
+
+    // find the size scale factor for translation in the animation.
+    float boneLengthScale = 1.0f;
+    const int avatarHipsIndex = avatarSkeleton.nameToJointIndex("Hips");
+    const int animHipsIndex = animSkeleton.nameToJointIndex("Hips");
+    if (avatarHipsIndex != -1 && animHipsIndex != -1) {
+        const int avatarHipsParentIndex = avatarSkeleton.getParentIndex(avatarHipsIndex);
+        const int animHipsParentIndex = animSkeleton.getParentIndex(animHipsIndex);
+
+        const AnimPose& avatarHipsAbsoluteDefaultPose = avatarSkeleton.getAbsoluteDefaultPose(avatarHipsIndex);
+        const AnimPose& animHipsAbsoluteDefaultPose = animSkeleton.getAbsoluteDefaultPose(animHipsIndex);
+
+        // the get the units and the heights for the animation and the avatar
+        const float avatarUnitScale = extractScale(avatarSkeleton.getGeometryOffset()).y;
+        const float animationUnitScale = extractScale(animModel.offset).y;
+        const float avatarHeightInMeters = avatarUnitScale * avatarHipsAbsoluteDefaultPose.trans().y;
+        const float animHeightInMeters = animationUnitScale * animHipsAbsoluteDefaultPose.trans().y;
+
+        // get the parent scales for the avatar and the animation
+        float avatarHipsParentScale = 1.0f;
+        if (avatarHipsParentIndex != -1) {
+            const AnimPose& avatarHipsParentAbsoluteDefaultPose = avatarSkeleton.getAbsoluteDefaultPose(avatarHipsParentIndex);
+            avatarHipsParentScale = avatarHipsParentAbsoluteDefaultPose.scale().y;
+        }
+        float animHipsParentScale = 1.0f;
+        if (animHipsParentIndex != -1) {
+            const AnimPose& animationHipsParentAbsoluteDefaultPose = animSkeleton.getAbsoluteDefaultPose(animHipsParentIndex);
+            animHipsParentScale = animationHipsParentAbsoluteDefaultPose.scale().y;
+        }
+
+        const float EPSILON = 0.0001f;
+        // compute the ratios for the units, the heights in meters, and the parent scales
+        if ((fabsf(animHeightInMeters) > EPSILON) && (animationUnitScale > EPSILON) && (animHipsParentScale > EPSILON)) {
+            const float avatarToAnimationHeightRatio = avatarHeightInMeters / animHeightInMeters;
+            const float unitsRatio = 1.0f / (avatarUnitScale / animationUnitScale);
+            const float parentScaleRatio = 1.0f / (avatarHipsParentScale / animHipsParentScale);
+
+            boneLengthScale = avatarToAnimationHeightRatio * unitsRatio * parentScaleRatio;
+        }
+    }
+
+    for (int frame = 0; frame < animFrameCount; frame++) {
+        const HFMAnimationFrame& animFrame = animModel.animationFrames[frame];
+
+        // extract the full rotations from the animFrame (including pre and post rotations from the animModel).
+        std::vector<glm::quat> animRotations;
+        animRotations.reserve(animJointCount);
+        for (int i = 0; i < animJointCount; i++) {
+            animRotations.push_back(animModel.joints[i].preRotation * animFrame.rotations[i] * animModel.joints[i].postRotation);
+        }
+
+        // convert rotations into absolute frame
+        animSkeleton.convertRelativeRotationsToAbsolute(animRotations);
+
+        // build absolute rotations for the avatar
+        std::vector<glm::quat> avatarRotations;
+        avatarRotations.reserve(avatarJointCount);
+        for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
+            int animJointIndex = avatarToAnimJointIndexMap[avatarJointIndex];
+            if (animJointIndex >= 0) {
+                // This joint is in both animation and avatar.
+                // Set the absolute rotation directly
+                avatarRotations.push_back(animRotations[animJointIndex]);
+            } else {
+                // This joint is NOT in the animation at all.
+                // Set it so that the default relative rotation remains unchanged.
+                glm::quat avatarRelativeDefaultRot = avatarSkeleton.getRelativeDefaultPose(avatarJointIndex).rot();
+                glm::quat avatarParentAbsoluteRot;
+                int avatarParentJointIndex = avatarSkeleton.getParentIndex(avatarJointIndex);
+                if (avatarParentJointIndex >= 0) {
+                    avatarParentAbsoluteRot = avatarRotations[avatarParentJointIndex];
+                }
+                avatarRotations.push_back(avatarParentAbsoluteRot * avatarRelativeDefaultRot);
+            }
+        }
+
+        // convert avatar rotations into relative frame
+        avatarSkeleton.convertAbsoluteRotationsToRelative(avatarRotations);
+
+        frames[frame].reserve(avatarJointCount);
+        for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
+            const AnimPose& avatarDefaultPose = avatarSkeleton.getRelativeDefaultPose(avatarJointIndex);
+
+            // copy scale over from avatar default pose
+            glm::vec3 relativeScale = avatarDefaultPose.scale();
+
+            glm::vec3 relativeTranslation;
+            int animJointIndex = avatarToAnimJointIndexMap[avatarJointIndex];
+            if (animJointIndex >= 0) {
+                // This joint is in both animation and avatar.
+                const glm::vec3& animTrans = animFrame.translations[animJointIndex];
+
+                // retarget translation from animation to avatar
+                const glm::vec3& animZeroTrans = animModel.animationFrames[0].translations[animJointIndex];
+                relativeTranslation = avatarDefaultPose.trans() + boneLengthScale * (animTrans - animZeroTrans);
+            } else {
+                // This joint is NOT in the animation at all.
+                // preserve the default translation.
+                relativeTranslation = avatarDefaultPose.trans();
+            }
+
+            // build the final pose
+            frames[frame].push_back(AnimPose(relativeScale, avatarRotations[avatarJointIndex], relativeTranslation));
+        }
+
+        if (mirrored) {
+            avatarSkeleton.mirrorRelativePoses(frames[frame]);
+        }
+    }
+
+    buildTracks(frames);
+}
+
+void AnimClipData::buildTracks(const std::vector<AnimPoseVec>& frames) {
+    _numFrames = (int)frames.size();
+    const int numJoints = _numFrames > 0 ? (int)frames[0].size() : 0;
+
+    _tracks.resize(numJoints);
+    for (int joint = 0; joint < numJoints; joint++) {
+        const AnimPose& firstPose = frames[0][joint];
+        const uint64_t firstRotation = packRotation(firstPose.rot());
+
+        bool constantScale = true;
+        bool constantRotation = true;
+        bool constantTranslation = true;
+        for (int frame = 1; frame < _numFrames; frame++) {
+            const AnimPose& pose = frames[frame][joint];
+            constantScale = constantScale && pose.scale() == firstPose.scale();
+            constantRotation = constantRotation && packRotation(pose.rot()) == firstRotation;
+            constantTranslation = constantTranslation && pose.trans() == firstPose.trans();
+        }
+
+        Track& track = _tracks[joint];
+        track.scaleOffset = (uint32_t)_scales.size();
+        track.scaleStride = constantScale ? 0 : 1;
+        track.rotationOffset = (uint32_t)_rotations.size();
+        track.rotationStride = constantRotation ? 0 : 1;
+        track.translationOffset = (uint32_t)_translations.size();
+        track.translationStride = constantTranslation ? 0 : 1;
+
+        const int numScales = constantScale ? 1 : _numFrames;
+        for (int frame = 0; frame < numScales; frame++) {
+            _scales.push_back(frames[frame][joint].scale());
+        }
+        const int numRotations = constantRotation ? 1 : _numFrames;
+        for (int frame = 0; frame < numRotations; frame++) {
+            _rotations.push_back(packRotation(frames[frame][joint].rot()));
+        }
+        const int numTranslations = constantTranslation ? 1 : _numFrames;
+        for (int frame = 0; frame < numTranslations; frame++) {
+            _translations.push_back(frames[frame][joint].trans());
+        }
+    }
+
+    _scales.shrink_to_fit();
+    _rotations.shrink_to_fit();
+    _translations.shrink_to_fit();
+}
+
+void AnimClipData::getFrame(int frame, AnimPoseVec& poses) const {
+    assert(frame >= 0 && frame < _numFrames);
+    assert(poses.size() >= _tracks.size());
+    for (size_t i = 0; i < _tracks.size(); i++) {
+        const Track& track = _tracks[i];
+        AnimPose& pose = poses[i];
+        pose.scale() = _scales[track.scaleOffset + track.scaleStride * frame];
+        pose.rot() = unpackRotation(_rotations[track.rotationOffset + track.rotationStride * frame]);
+        pose.trans() = _translations[track.translationOffset + track.translationStride * frame];
+    }
+}
+
+void AnimClipData::blendFrames(int prevFrame, int nextFrame, float alpha, AnimPoseVec& poses) const {
+    assert(prevFrame >= 0 && prevFrame < _numFrames && nextFrame >= 0 && nextFrame < _numFrames);
+    assert(poses.size() >= _tracks.size());
+    for (size_t i = 0; i < _tracks.size(); i++) {
+        const Track& track = _tracks[i];
+        AnimPose& pose = poses[i];
+
+        // constant tracks skip the blend, which would only return the same value
+        if (track.scaleStride == 0) {
+            pose.scale() = _scales[track.scaleOffset];
+        } else {
+            pose.scale() = lerp(_scales[track.scaleOffset + prevFrame], _scales[track.scaleOffset + nextFrame], alpha);
+        }
+
+        if (track.rotationStride == 0) {
+            pose.rot() = unpackRotation(_rotations[track.rotationOffset]);
+        } else {
+            pose.rot() = safeLerp(unpackRotation(_rotations[track.rotationOffset + prevFrame]),
+                                  unpackRotation(_rotations[track.rotationOffset + nextFrame]), alpha);
+        }
+
+        if (track.translationStride == 0) {
+            pose.trans() = _translations[track.translationOffset];
+        } else {
+            pose.trans() = lerp(_translations[track.translationOffset + prevFrame],
+                                _translations[track.translationOffset + nextFrame], alpha);
+        }
+    }
+}
+
+size_t AnimClipData::getMemorySize() const {
+    return sizeof(AnimClipData) + _tracks.capacity() * sizeof(Track) + _scales.capacity() * sizeof(glm::vec3) +
+        _rotations.capacity() * sizeof(uint64_t) + _translations.capacity() * sizeof(glm::vec3);
+}
+
+QByteArray AnimClipData::computeSkeletonSignature(const AnimSkeleton& skeleton) {
+    // everything retargeting and mirroring read from the avatar skeleton: joint names, hierarchy, default pose and units
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const glm::mat4& geometryOffset = skeleton.getGeometryOffset();
+    hash.addData((const char*)&geometryOffset, sizeof(glm::mat4));
+    for (int i = 0; i < skeleton.getNumJoints(); i++) {
+        hash.addData(skeleton.getJointName(i).toUtf8());
+        int parentIndex = skeleton.getParentIndex(i);
+        hash.addData((const char*)&parentIndex, sizeof(int));
+        const AnimPose& defaultPose = skeleton.getRelativeDefaultPose(i);
+        hash.addData((const char*)&defaultPose.scale(), sizeof(glm::vec3));
+        hash.addData((const char*)&defaultPose.rot(), sizeof(glm::quat));
+        hash.addData((const char*)&defaultPose.trans(), sizeof(glm::vec3));
+    }
+    return hash.result();
+}
+
+uint64_t AnimClipData::packRotation(const glm::quat& rotation) {
+    glm::quat normalized = glm::normalize(rotation);
+    const float components[4] = { normalized.x, normalized.y, normalized.z, normalized.w };
+
+    int largestIndex = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabsf(components[i]) > fabsf(components[largestIndex])) {
+            largestIndex = i;
+        }
+    }
+
+    // q and -q are the same rotation, so flip the sign to make the dropped component positive
+    const float sign = components[largestIndex] < 0.0f ? -1.0f : 1.0f;
+
+    uint64_t packed = (uint64_t)largestIndex;
+    int shift = PACKED_INDEX_BITS;
+    for (int i = 0; i < 4; i++) {
+        if (i != largestIndex) {
+            float unitValue = (sign * components[i] + PACKED_COMPONENT_RANGE) / (2.0f * PACKED_COMPONENT_RANGE);
+            uint64_t quantized = (uint64_t)(glm::clamp(unitValue, 0.0f, 1.0f) * (float)PACKED_COMPONENT_MASK + 0.5f);
+            packed |= quantized << shift;
+            shift += PACKED_COMPONENT_BITS;
+        }
+    }
+    return packed;
+}
+
+glm::quat AnimClipData::unpackRotation(uint64_t packedRotation) {
+    const int largestIndex = (int)(packedRotation & PACKED_INDEX_MASK);
+
+    float components[4];
+    float sumOfSquares = 0.0f;
+    int shift = PACKED_INDEX_BITS;
+    for (int i = 0; i < 4; i++) {
+        if (i != largestIndex) {
+            float unitValue = (float)((packedRotation >> shift) & PACKED_COMPONENT_MASK) / (float)PACKED_COMPONENT_MASK;
+            components[i] = unitValue * 2.0f * PACKED_COMPONENT_RANGE - PACKED_COMPONENT_RANGE;
+            sumOfSquares += components[i] * components[i];
+            shift += PACKED_COMPONENT_BITS;
+        }
+    }
+    components[largestIndex] = sqrtf(std::max(0.0f, 1.0f - sumOfSquares));
+
+    return glm::normalize(glm::quat(components[3], components[0], components[1], components[2]));
+}
@@ -0,0 +1,73 @@
+//
+//  AnimClipData.h
+//  libraries/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipData_h
+#define hifi_AnimClipData_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "AnimSkeleton.h"
+
+// The frames of an animation, retargeted onto one skeleton.
+//
+// Instances never change once built, so AnimationCache hands the same one to every clip playing an animation on an
+// equivalent skeleton, and an animation is retargeted and held in memory once however many avatars play it.
+//
+// Frames are stored as one track per joint and channel rather than one pose per joint and frame.  A track that holds
+// the same value in every frame (most scales, and the translations of joints the animation doesn't move) is stored
+// as that single value, and rotations are packed into 64 bits each.
+class AnimClipData {
+public:
+    using Pointer = std::shared_ptr<const AnimClipData>;
+
+    // mirrored frames are mirrored before they are packed, so that they are only quantized once
+    AnimClipData(const HFMModel& animModel, const AnimSkeleton& skeleton, bool mirrored = false);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_tracks.size(); }
+
+    // poses must hold getNumJoints() poses
+    void getFrame(int frame, AnimPoseVec& poses) const;
+    void blendFrames(int prevFrame, int nextFrame, float alpha, AnimPoseVec& poses) const;
+
+    size_t getMemorySize() const;
+
+    // skeletons with the same signature retarget an animation to the same frames
+    static QByteArray computeSkeletonSignature(const AnimSkeleton& skeleton);
+
+    // rotations are stored with their largest component dropped and the others quantized to 20 bits each
+    static uint64_t packRotation(const glm::quat& rotation);
+    static glm::quat unpackRotation(uint64_t packedRotation);
+
+private:
+    // the value of a track at a frame is at offset + stride * frame, where the stride is 0 for a constant track
+    struct Track {
+        uint32_t scaleOffset;
+        uint32_t scaleStride;
+        uint32_t rotationOffset;
+        uint32_t rotationStride;
+        uint32_t translationOffset;
+        uint32_t translationStride;
+    };
+
+    // frames[frame][joint]
+    void buildTracks(const std::vector<AnimPoseVec>& frames);
+
+    int _numFrames { 0 };
+    std::vector<Track> _tracks;
+    std::vector<glm::vec3> _scales;
+    std::vector<uint64_t> _rotations;
+    std::vector<glm::vec3> _translations;
+};
+
+#endif // hifi_AnimClipData_h
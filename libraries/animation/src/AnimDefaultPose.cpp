@@ -20,7 +20,7 @@ AnimDefaultPose::~AnimDefaultPose() {
 
 }
 
-const AnimPoseVec& AnimDefaultPose::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
+const AnimPoseVec& AnimDefaultPose::evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
     if (_skeleton) {
         _poses = _skeleton->getRelativeDefaultPoses();
     } else {
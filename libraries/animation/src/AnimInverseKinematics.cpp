@@ -214,10 +214,20 @@ void AnimInverseKinematics::computeTargets(const AnimVariantMap& animVars, std::
 }
 
 void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<IKTarget>& targets, float dt, JointChainInfoVec& jointChainInfoVec) {
-    // compute absolute poses that correspond to relative target poses
+    computeIKJointIndices(targets, jointChainInfoVec);
+
+    // compute absolute poses that correspond to relative target poses,
+    // but only for the joints the solvers can see: the rest of the skeleton isn't needed until after the solve
     AnimPoseVec absolutePoses;
     absolutePoses.resize(_relativePoses.size());
-    computeAbsolutePoses(absolutePoses);
+    for (auto i : _ikJointIndices) {
+        int parentIndex = _skeleton->getParentIndex(i);
+        if (parentIndex < 0) {
+            absolutePoses[i] = _relativePoses[i];
+        } else {
+            absolutePoses[i] = absolutePoses[parentIndex] * _relativePoses[i];
+        }
+    }
 
     // clear the accumulators before we start the IK solver
     for (auto& accumulator : _rotationAccumulators) {
@@ -227,6 +237,15 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
         accumulator.clearAndClean();
     }
 
+    // the last iteration interpolates joint chains that changed type, and draws them when debugging,
+    // so we can only stop early when it has none of that to do
+    bool canStopEarly = !context.getEnableDebugDrawIKChains();
+    for (const auto& prevJointChainInfo : _prevJointChainInfoVec) {
+        if (prevJointChainInfo.timer > 0.0f) {
+            canStopEarly = false;
+        }
+    }
+
     float maxError = 0.0f;
     int numLoops = 0;
     const int MAX_IK_LOOPS = 16;
@@ -299,20 +318,36 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
 
         // harvest accumulated rotations and apply the average
         // don't apply accumulators to hips, or parents of hips
-        for (int i = (_hipsIndex+1); i < (int)_relativePoses.size(); ++i) {
+        // (only joints on an IK chain have anything accumulated)
+        const float MIN_SETTLED_ROTATION_DOT = 1.0f - 5.0e-7f; // about a tenth of a degree
+        const float MAX_SETTLED_TRANSLATION_FRACTION = 1.0e-3f;
+        bool isSettled = true;
+        for (auto i : _ikJointIndices) {
+            if (i <= _hipsIndex) {
+                continue;
+            }
             if (_rotationAccumulators[i].size() > 0) {
-                _relativePoses[i].rot() = _rotationAccumulators[i].getAverage();
+                glm::quat rot = _rotationAccumulators[i].getAverage();
+                if (fabsf(glm::dot(rot, _relativePoses[i].rot())) < MIN_SETTLED_ROTATION_DOT) {
+                    isSettled = false;
+                }
+                _relativePoses[i].rot() = rot;
                 _rotationAccumulators[i].clear();
             }
             if (_translationAccumulators[i].size() > 0) {
-                _relativePoses[i].trans() = _translationAccumulators[i].getAverage();
+                glm::vec3 trans = _translationAccumulators[i].getAverage();
+                glm::vec3 prevTrans = _relativePoses[i].trans();
+                if (glm::length2(trans - prevTrans) > MAX_SETTLED_TRANSLATION_FRACTION * MAX_SETTLED_TRANSLATION_FRACTION * glm::length2(prevTrans)) {
+                    isSettled = false;
+                }
+                _relativePoses[i].trans() = trans;
                 _translationAccumulators[i].clear();
             }
         }
 
         // update the absolutePoses
-        for (int i = 0; i < (int)_relativePoses.size(); ++i) {
-            auto parentIndex = _skeleton->getParentIndex((int)i);
+        for (auto i : _ikJointIndices) {
+            auto parentIndex = _skeleton->getParentIndex(i);
             if (parentIndex != -1) {
                 absolutePoses[i] = absolutePoses[parentIndex] * _relativePoses[i];
             }
@@ -329,8 +364,14 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
                 }
             }
         }
+
+        // once no joint moves, further iterations would only repeat this one
+        if (isSettled && canStopEarly) {
+            break;
+        }
     }
     _maxErrorOnLastSolve = maxError;
+    _numIterationsOnLastSolve = numLoops;
 
     // finally set the relative rotation of each tip to agree with absolute target rotation
     for (auto& target: targets) {
@@ -380,6 +421,41 @@ void AnimInverseKinematics::solve(const AnimContext& context, const std::vector<
     }
 }
 
+void AnimInverseKinematics::computeIKJointIndices(const std::vector<IKTarget>& targets, const JointChainInfoVec& jointChainInfoVec) {
+    int numJoints = (int)_relativePoses.size();
+    _isIKJoint.assign(numJoints, false);
+    auto addWithAncestors = [&](int index) {
+        while (index >= 0 && index < numJoints && !_isIKJoint[index]) {
+            _isIKJoint[index] = true;
+            index = _skeleton->getParentIndex(index);
+        }
+    };
+
+    addWithAncestors(_hipsIndex);
+    for (const auto& target : targets) {
+        addWithAncestors(target.getIndex());
+    }
+    // the previous chains are blended in on the last iteration
+    for (const auto& jointChainInfo : jointChainInfoVec) {
+        for (const auto& info : jointChainInfo.jointInfoVec) {
+            addWithAncestors(info.jointIndex);
+        }
+    }
+    for (const auto& jointChainInfo : _prevJointChainInfoVec) {
+        for (const auto& info : jointChainInfo.jointInfoVec) {
+            addWithAncestors(info.jointIndex);
+        }
+    }
+
+    // parents always come before their children in the skeleton
+    _ikJointIndices.clear();
+    for (int i = 0; i < numJoints; ++i) {
+        if (_isIKJoint[i]) {
+            _ikJointIndices.push_back(i);
+        }
+    }
+}
+
 void AnimInverseKinematics::solveTargetWithCCD(const AnimContext& context, const IKTarget& target, const AnimPoseVec& absolutePoses,
                                                bool debug, JointChainInfo& jointChainInfoOut) const {
     size_t chainDepth = 0;
@@ -855,7 +931,7 @@ void AnimInverseKinematics::solveTargetWithSpline(const AnimContext& context, co
 }
 
 //virtual
-const AnimPoseVec& AnimInverseKinematics::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
+const AnimPoseVec& AnimInverseKinematics::evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
     // don't call this function, call overlay() instead
     assert(false);
     return _relativePoses;
@@ -863,6 +939,8 @@ const AnimPoseVec& AnimInverseKinematics::evaluate(const AnimVariantMap& animVar
 
 //virtual
 const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut, const AnimPoseVec& underPoses) {
+    ++_evaluationCount;
+
     // allows solutionSource to be overridden by an animVar
     auto solutionSource = animVars.lookup(_solutionSourceVar, (int)_solutionSource);
 
@@ -882,11 +960,11 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
         if (!underPoses.empty()) {
             // Sometimes the underpose itself can violate the constraints.  Rather than
             // clamp the animation we dynamically expand each constraint to accomodate it.
-            std::map<int, RotationConstraint*>::iterator constraintItr = _constraints.begin();
-            while (constraintItr != _constraints.end()) {
-                int index = constraintItr->first;
-                constraintItr->second->dynamicallyAdjustLimits(underPoses[index].rot());
-                ++constraintItr;
+            size_t numConstraints = std::min(_constraints.size(), underPoses.size());
+            for (size_t i = 0; i < numConstraints; ++i) {
+                if (_constraints[i]) {
+                    _constraints[i]->dynamicallyAdjustLimits(underPoses[i].rot());
+                }
             }
         }
     }
@@ -1040,8 +1118,10 @@ const AnimPoseVec& AnimInverseKinematics::overlay(const AnimVariantMap& animVars
 }
 
 void AnimInverseKinematics::clearIKJointLimitHistory() {
-    for (auto& pair : _constraints) {
-        pair.second->clearHistory();
+    for (auto constraint : _constraints) {
+        if (constraint) {
+            constraint->clearHistory();
+        }
     }
 }
 
@@ -1062,19 +1142,15 @@ void AnimInverseKinematics::clearSecondaryTarget(int jointIndex) {
 }
 
 RotationConstraint* AnimInverseKinematics::getConstraint(int index) const {
-    RotationConstraint* constraint = nullptr;
-    std::map<int, RotationConstraint*>::const_iterator constraintItr = _constraints.find(index);
-    if (constraintItr != _constraints.end()) {
-        constraint = constraintItr->second;
+    if (index >= 0 && index < (int)_constraints.size()) {
+        return _constraints[index];
     }
-    return constraint;
+    return nullptr;
 }
 
 void AnimInverseKinematics::clearConstraints() {
-    std::map<int, RotationConstraint*>::iterator constraintItr = _constraints.begin();
-    while (constraintItr != _constraints.end()) {
-        delete constraintItr->second;
-        ++constraintItr;
+    for (auto constraint : _constraints) {
+        delete constraint;
     }
     _constraints.clear();
 }
@@ -1151,6 +1227,7 @@ void AnimInverseKinematics::initConstraints() {
     */
 
     clearConstraints();
+    _constraints.resize(numJoints, nullptr);
     for (int i = 0; i < numJoints; ++i) {
         // compute the joint's baseName and remember whether its prefix was "Left" or not
         QString baseName = _skeleton->getJointName(i);
@@ -52,12 +52,13 @@ public:
                        const QString& typeVar, const QString& weightVar, float weight, const std::vector<float>& flexCoefficients,
                        const QString& poleVectorEnabledVar, const QString& poleReferenceVectorVar, const QString& poleVectorVar);
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
+    virtual const AnimPoseVec& evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
     virtual const AnimPoseVec& overlay(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut, const AnimPoseVec& underPoses) override;
 
     void clearIKJointLimitHistory();
 
     float getMaxErrorOnLastSolve() { return _maxErrorOnLastSolve; }
+    int getNumIterationsOnLastSolve() const { return _numIterationsOnLastSolve; }
 
     /**jsdoc
      * <p>Specifies the initial conditions of the IK solver.</p>
@@ -130,6 +131,7 @@ protected:
     void blendToPoses(const AnimPoseVec& targetPoses, const AnimPoseVec& underPose, float blendFactor);
     void preconditionRelativePosesToAvoidLimbLock(const AnimContext& context, const std::vector<IKTarget>& targets);
     void setSecondaryTargets(const AnimContext& context);
+    void computeIKJointIndices(const std::vector<IKTarget>& targets, const JointChainInfoVec& jointChainInfoVec);
 
     // used to pre-compute information about each joint influeced by a spline IK target.
     struct SplineJointInfo {
@@ -174,7 +176,7 @@ protected:
         int jointIndex; // cached joint index
     };
 
-    std::map<int, RotationConstraint*> _constraints;
+    std::vector<RotationConstraint*> _constraints; // indexed by joint, nullptr for unconstrained joints
     std::vector<RotationAccumulator> _rotationAccumulators;
     std::vector<TranslationAccumulator> _translationAccumulators;
     std::vector<IKTargetVar> _targetVarVec;
@@ -182,6 +184,10 @@ protected:
     AnimPoseVec _relativePoses; // current relative poses
     AnimPoseVec _limitCenterPoses;  // relative
 
+    // joints on any IK chain and their ancestors, parents first: the only joints solve() moves or reads
+    std::vector<int> _ikJointIndices;
+    std::vector<bool> _isIKJoint;
+
     std::map<int, AnimPose> _secondaryTargetsInRigFrame;
 
     mutable std::map<int, std::vector<SplineJointInfo>> _splineJointInfoMap;
@@ -194,6 +200,7 @@ protected:
     int _rightHandIndex { -1 };
 
     float _maxErrorOnLastSolve { FLT_MAX };
+    int _numIterationsOnLastSolve { 0 };
     bool _previousEnableDebugIKTargets { false };
     SolutionSource _solutionSource { SolutionSource::RelaxToUnderPoses };
     QString _solutionSourceVar;
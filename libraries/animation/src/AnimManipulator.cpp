@@ -32,11 +32,16 @@ AnimManipulator::~AnimManipulator() {
 
 }
 
-const AnimPoseVec& AnimManipulator::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
-    return overlay(animVars, context, dt, triggersOut, _skeleton->getRelativeDefaultPoses());
+const AnimPoseVec& AnimManipulator::evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
+    return manipulate(animVars, _skeleton->getRelativeDefaultPoses());
 }
 
 const AnimPoseVec& AnimManipulator::overlay(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut, const AnimPoseVec& underPoses) {
+    ++_evaluationCount;
+    return manipulate(animVars, underPoses);
+}
+
+const AnimPoseVec& AnimManipulator::manipulate(const AnimVariantMap& animVars, const AnimPoseVec& underPoses) {
     _alpha = animVars.lookup(_alphaVar, _alpha);
 
     _poses = underPoses;
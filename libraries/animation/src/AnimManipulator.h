@@ -22,7 +22,7 @@ public:
     AnimManipulator(const QString& id, float alpha);
     virtual ~AnimManipulator() override;
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
+    virtual const AnimPoseVec& evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
     virtual const AnimPoseVec& overlay(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut, const AnimPoseVec& underPoses) override;
 
     void setAlphaVar(const QString& alphaVar) { _alphaVar = alphaVar; }
@@ -57,6 +57,8 @@ protected:
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
 
+    const AnimPoseVec& manipulate(const AnimVariantMap& animVars, const AnimPoseVec& underPoses);
+
     AnimPose computeRelativePoseFromJointVar(const AnimVariantMap& animVars, const JointVar& jointVar,
                                              const AnimPose& defaultRelPose, const AnimPoseVec& underPoses);
 
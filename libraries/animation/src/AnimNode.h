@@ -66,7 +66,10 @@ public:
 
     AnimSkeleton::ConstPointer getSkeleton() const { return _skeleton; }
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) = 0;
+    const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
+        ++_evaluationCount;
+        return evaluateInternal(animVars, context, dt, triggersOut);
+    }
     virtual const AnimPoseVec& overlay(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut,
                                        const AnimPoseVec& underPoses) {
         return evaluate(animVars, context, dt, triggersOut);
@@ -74,6 +77,9 @@ public:
 
     void setCurrentFrame(float frame);
 
+    // for profiling, how many times this node has been evaluated or overlaid
+    uint64_t getEvaluationCount() const { return _evaluationCount; }
+
     template <typename F>
     bool traverse(F func) {
         if (func(shared_from_this())) {
@@ -100,6 +106,8 @@ public:
 
 protected:
 
+    virtual const AnimPoseVec& evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) = 0;
+
     virtual void setCurrentFrameInternal(float frame) {}
     virtual void setSkeletonInternal(AnimSkeleton::ConstPointer skeleton) { _skeleton = skeleton; }
 
@@ -115,6 +123,9 @@ protected:
     std::weak_ptr<AnimNode> _parent;
     std::vector<QString> _outputJointNames;
 
+    // overlay() implementations count their own evaluations
+    uint64_t _evaluationCount { 0 };
+
     // no copies
     AnimNode(const AnimNode&) = delete;
     AnimNode& operator=(const AnimNode&) = delete;
@@ -76,7 +76,7 @@ public:
     AnimOverlay(const QString& id, BoneSet boneSet, float alpha);
     virtual ~AnimOverlay() override;
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
+    virtual const AnimPoseVec& evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
 
     void setBoneSetVar(const QString& boneSetVar) { _boneSetVar = boneSetVar; }
     void setAlphaVar(const QString& alphaVar) { _alphaVar = alphaVar; }
@@ -34,7 +34,7 @@ AnimPoleVectorConstraint::~AnimPoleVectorConstraint() {
 
 }
 
-const AnimPoseVec& AnimPoleVectorConstraint::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
+const AnimPoseVec& AnimPoleVectorConstraint::evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
 
     assert(_children.size() == 1);
     if (_children.size() != 1) {
@@ -67,13 +67,60 @@ glm::vec3 AnimPose::xformVectorFast(const glm::vec3& rhs) const {
     return _rot * (_scale * rhs);
 }
 
+// Poses with a uniform, positive scale (nearly every joint) are multiplied and inverted directly from their parts.
+// Anything else goes through a matrix, which may shear, and is decomposed again.
+static const float UNIFORM_SCALE_EPSILON = 0.00001f;
+
+static bool isUniformPositiveScale(const glm::vec3& scale) {
+    return scale.x > 0.0f &&
+        fabsf(scale.y - scale.x) <= UNIFORM_SCALE_EPSILON * scale.x &&
+        fabsf(scale.z - scale.x) <= UNIFORM_SCALE_EPSILON * scale.x;
+}
+
+static bool isPositiveScale(const glm::vec3& scale) {
+    return scale.x > 0.0f && scale.y > 0.0f && scale.z > 0.0f;
+}
+
+// matches the quaternion the matrix path would decompose: normalized, with its largest component positive like quat_cast
+static glm::quat canonicalRotation(const glm::quat& rot) {
+    float largest = rot.w;
+    if (fabsf(rot.x) > fabsf(largest)) {
+        largest = rot.x;
+    }
+    if (fabsf(rot.y) > fabsf(largest)) {
+        largest = rot.y;
+    }
+    if (fabsf(rot.z) > fabsf(largest)) {
+        largest = rot.z;
+    }
+    glm::quat result = largest < 0.0f ? -rot : rot;
+
+    float lengthSquared = glm::length2(result);
+    if (glm::abs(lengthSquared - 1.0f) > EPSILON) {
+        float oneOverLength = 1.0f / sqrtf(lengthSquared);
+        result = glm::quat(result.w * oneOverLength, result.x * oneOverLength, result.y * oneOverLength, result.z * oneOverLength);
+    }
+    return result;
+}
+
 AnimPose AnimPose::operator*(const AnimPose& rhs) const {
+    if (isUniformPositiveScale(_scale) && isPositiveScale(rhs._scale)) {
+        float scale = _scale.x;
+        return AnimPose(scale * rhs._scale, canonicalRotation(_rot * rhs._rot), _trans + _rot * (scale * rhs._trans));
+    }
+
     glm::mat4 result;
     glm_mat4u_mul(*this, rhs, result);
     return AnimPose(result);
 }
 
 AnimPose AnimPose::inverse() const {
+    if (isUniformPositiveScale(_scale)) {
+        float oneOverScale = 1.0f / _scale.x;
+        glm::quat invRot = glm::inverse(_rot);
+        return AnimPose(glm::vec3(oneOverScale), canonicalRotation(invRot), -oneOverScale * (invRot * _trans));
+    }
+
     return AnimPose(glm::inverse(static_cast<glm::mat4>(*this)));
 }
 
@@ -21,7 +21,7 @@ AnimRandomSwitch::~AnimRandomSwitch() {
 
 }
 
-const AnimPoseVec& AnimRandomSwitch::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
+const AnimPoseVec& AnimRandomSwitch::evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
     float parentDebugAlpha = context.getDebugAlpha(_id);
 
     AnimRandomSwitch::RandomSwitchState::Pointer desiredState = _currentState;
@@ -30,7 +30,7 @@ public:
         const std::vector<float> midTargetFlexCoefficients);
 
 	virtual ~AnimSplineIK() override;
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
+    virtual const AnimPoseVec& evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
 
 protected:
 
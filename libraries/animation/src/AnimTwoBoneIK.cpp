@@ -44,7 +44,7 @@ AnimTwoBoneIK::~AnimTwoBoneIK() {
 
 }
 
-const AnimPoseVec& AnimTwoBoneIK::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
+const AnimPoseVec& AnimTwoBoneIK::evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) {
 
     assert(_children.size() == 1);
     if (_children.size() != 1) {
@@ -26,7 +26,7 @@ public:
                   const QString& endEffectorRotationVarVar, const QString& endEffectorPositionVarVar);
     virtual ~AnimTwoBoneIK() override;
 
-    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
+    virtual const AnimPoseVec& evaluateInternal(const AnimVariantMap& animVars, const AnimContext& context, float dt, AnimVariantMap& triggersOut) override;
 
 protected:
 
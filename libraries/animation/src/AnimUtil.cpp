@@ -13,10 +13,63 @@
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 
-// TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+// each pose is read and written as ten contiguous floats: scale (0-2), rot (3-6) and trans (7-9)
+static_assert(sizeof(AnimPose) == 10 * sizeof(float), "AnimPose is expected to be tightly packed");
+
+// the dot product of two quaternions, in every lane
+static inline __m128 dot4(__m128 a, __m128 b) {
+    __m128 m = _mm_mul_ps(a, b);
+    m = _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+}
 
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    assert(numPoses == 0 || ((const float*)&a->rot() == (const float*)a + 3 && (const float*)&a->trans() == (const float*)a + 7));
+
+    const __m128 vAlpha = _mm_set1_ps(alpha);
+    const __m128 vZero = _mm_setzero_ps();
+    const __m128 vSignBit = _mm_set1_ps(-0.0f);
+    for (size_t i = 0; i < numPoses; i++) {
+        const float* aFloats = (const float*)&a[i];
+        const float* bFloats = (const float*)&b[i];
+        float* resultFloats = (float*)&result[i];
+
+        // the scale and trans loads each pick up one component of rot as well
+        __m128 aScale = _mm_loadu_ps(aFloats);
+        __m128 bScale = _mm_loadu_ps(bFloats);
+        __m128 aRot = _mm_loadu_ps(aFloats + 3);
+        __m128 bRot = _mm_loadu_ps(bFloats + 3);
+        __m128 aTrans = _mm_loadu_ps(aFloats + 6);
+        __m128 bTrans = _mm_loadu_ps(bFloats + 6);
+
+        __m128 scale = _mm_add_ps(aScale, _mm_mul_ps(_mm_sub_ps(bScale, aScale), vAlpha));
+        __m128 trans = _mm_add_ps(aTrans, _mm_mul_ps(_mm_sub_ps(bTrans, aTrans), vAlpha));
+
+        // same as safeLerp(): flip b into the hemisphere of a, lerp and normalize
+        __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot4(aRot, bRot), vZero), vSignBit);
+        bRot = _mm_xor_ps(bRot, flip);
+        __m128 rot = _mm_add_ps(aRot, _mm_mul_ps(_mm_sub_ps(bRot, aRot), vAlpha));
+        rot = _mm_div_ps(rot, _mm_sqrt_ps(dot4(rot, rot)));
+
+        // rot is stored last, over the lanes of scale and trans that held its components
+        _mm_storeu_ps(resultFloats, scale);
+        _mm_storeu_ps(resultFloats + 6, trans);
+        _mm_storeu_ps(resultFloats + 3, rot);
+    }
+}
+
+#else
+
+void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+    blendScalar(numPoses, a, b, alpha, result);
+}
+
+#endif
+
+// TODO: use restrict keyword
+void blendScalar(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
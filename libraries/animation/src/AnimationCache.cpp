@@ -19,6 +19,7 @@
 #include <StatTracker.h>
 #include <Profile.h>
 
+#include "AnimClipData.h"
 #include "AnimationLogging.h"
 #include <FBXSerializer.h>
 
@@ -36,6 +37,50 @@ AnimationPointer AnimationCache::getAnimation(const QUrl& url) {
     return getResource(url).staticCast<Animation>();
 }
 
+std::shared_ptr<const AnimClipData> AnimationCache::getRetargetedAnimation(const AnimationPointer& animation,
+                                                                         const AnimSkeleton& skeleton, bool mirrored) {
+    assert(animation && animation->isLoaded());
+    auto animModel = animation->getHFMModelPointer();
+    RetargetedAnimationKey key { animModel.get(), AnimClipData::computeSkeletonSignature(skeleton), mirrored };
+
+    {
+        std::lock_guard<std::mutex> lock(_retargetedAnimationsMutex);
+        auto retargetedAnimation = findRetargetedAnimation(key);
+        if (retargetedAnimation) {
+            return retargetedAnimation;
+        }
+    }
+
+    // retarget outside of the lock, so that loading one animation doesn't hold up clips sharing another
+    auto retargetedAnimation = std::make_shared<const AnimClipData>(*animModel, skeleton, mirrored);
+
+    std::lock_guard<std::mutex> lock(_retargetedAnimationsMutex);
+    auto existingAnimation = findRetargetedAnimation(key);
+    if (existingAnimation) {
+        // another clip got there first
+        return existingAnimation;
+    }
+
+    // drop the entries of animations no clip plays anymore
+    for (auto it = _retargetedAnimations.begin(); it != _retargetedAnimations.end();) {
+        if (it.value().clipData.expired() || it.value().animModel.expired()) {
+            it = _retargetedAnimations.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    _retargetedAnimations.insert(key, { animModel, retargetedAnimation });
+    return retargetedAnimation;
+}
+
+std::shared_ptr<const AnimClipData> AnimationCache::findRetargetedAnimation(const RetargetedAnimationKey& key) const {
+    auto it = _retargetedAnimations.find(key);
+    if (it == _retargetedAnimations.end() || it.value().animModel.lock().get() != key.animModel) {
+        return nullptr;
+    }
+    return it.value().clipData.lock();
+}
+
 QSharedPointer<Resource> AnimationCache::createResource(const QUrl& url) {
     return QSharedPointer<Resource>(new Animation(url), &Resource::deleter);
 }
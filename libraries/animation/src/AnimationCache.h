@@ -12,6 +12,10 @@
 #ifndef hifi_AnimationCache_h
 #define hifi_AnimationCache_h
 
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QHash>
 #include <QtCore/QRunnable>
 #include <QtScript/QScriptEngine>
 #include <QtScript/QScriptValue>
@@ -21,6 +25,8 @@
 #include <ResourceCache.h>
 
 class Animation;
+class AnimClipData;
+class AnimSkeleton;
 
 using AnimationPointer = QSharedPointer<Animation>;
 
@@ -33,6 +39,12 @@ public:
     Q_INVOKABLE AnimationPointer getAnimation(const QString& url) { return getAnimation(QUrl(url)); }
     Q_INVOKABLE AnimationPointer getAnimation(const QUrl& url);
 
+    // The frames of a loaded animation retargeted onto skeleton, and mirrored if asked.  Clips playing the same animation
+    // on equivalent skeletons share one copy, which is kept for as long as any of them holds on to it.  A refreshed
+    // animation gets new copies.
+    std::shared_ptr<const AnimClipData> getRetargetedAnimation(const AnimationPointer& animation, const AnimSkeleton& skeleton,
+                                                               bool mirrored = false);
+
 protected:
     virtual QSharedPointer<Resource> createResource(const QUrl& url) override;
     QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override;
@@ -41,6 +53,28 @@ private:
     explicit AnimationCache(QObject* parent = NULL);
     virtual ~AnimationCache() { }
 
+    // keyed on the parsed animation rather than its URL, which stays the same when the animation is refreshed
+    struct RetargetedAnimationKey {
+        const HFMModel* animModel;
+        QByteArray skeletonSignature;
+        bool mirrored;
+
+        bool operator==(const RetargetedAnimationKey& other) const {
+            return animModel == other.animModel && skeletonSignature == other.skeletonSignature && mirrored == other.mirrored;
+        }
+        friend uint qHash(const RetargetedAnimationKey& key, uint seed) {
+            return qHash(key.animModel, seed) ^ qHash(key.skeletonSignature, seed) ^ (key.mirrored ? 1 : 0);
+        }
+    };
+    struct RetargetedAnimation {
+        // tells a parsed animation apart from a later one allocated at the same address
+        std::weak_ptr<const HFMModel> animModel;
+        std::weak_ptr<const AnimClipData> clipData;
+    };
+    std::shared_ptr<const AnimClipData> findRetargetedAnimation(const RetargetedAnimationKey& key) const;
+
+    std::mutex _retargetedAnimationsMutex;
+    QHash<RetargetedAnimationKey, RetargetedAnimation> _retargetedAnimations;
 };
 
 Q_DECLARE_METATYPE(AnimationPointer)
@@ -57,6 +91,7 @@ public:
     QString getType() const override { return "Animation"; }
 
     const HFMModel& getHFMModel() const { return *_hfmModel; }
+    HFMModel::Pointer getHFMModelPointer() const { return _hfmModel; }
 
     virtual bool isLoaded() const override;
 
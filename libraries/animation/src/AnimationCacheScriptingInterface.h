@@ -38,6 +38,9 @@ class AnimationCacheScriptingInterface : public ScriptableResourceCache, public
      * @property {number} numCached - Total number of cached resource. <em>Read-only.</em>
      * @property {number} sizeTotal - Size in bytes of all resources. <em>Read-only.</em>
      * @property {number} sizeCached - Size in bytes of all cached resources. <em>Read-only.</em>
+     * @property {number} numHits - Total number of requests for a resource that was already loaded or cached. <em>Read-only.</em>
+     * @property {number} numMisses - Total number of requests for a resource that had to be loaded. <em>Read-only.</em>
+     * @property {number} numEvictions - Total number of cached resources evicted to stay within budget. <em>Read-only.</em>
      *
      * @borrows ResourceCache.getResourceList as getResourceList
      * @borrows ResourceCache.updateTotalSize as updateTotalSize
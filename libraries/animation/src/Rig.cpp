@@ -2381,6 +2381,17 @@ void Rig::computeExternalPoses(const glm::mat4& modelOffsetMat) {
     _externalPoseSet = _internalPoseSet;
 }
 
+uint64_t Rig::getAnimNodeEvaluationCount() const {
+    uint64_t evaluationCount = 0;
+    if (_animNode) {
+        _animNode->traverse([&](AnimNode::Pointer node) {
+            evaluationCount += node->getEvaluationCount();
+            return true;
+        });
+    }
+    return evaluationCount;
+}
+
 void Rig::computeAvatarBoundingCapsule(
         const HFMModel& hfmModel,
         float& radiusOut,
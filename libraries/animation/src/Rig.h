@@ -239,6 +239,8 @@ public:
     const AnimContext::DebugAlphaMap& getDebugAlphaMap() const { return _lastContext.getDebugAlphaMap(); }
     const AnimVariantMap& getAnimVars() const { return _lastAnimVars; }
     const AnimContext::DebugStateMachineMap& getStateMachineMap() const { return _lastContext.getStateMachineMap(); }
+    // total over every node of the anim graph of how many times they were evaluated, for profiling
+    uint64_t getAnimNodeEvaluationCount() const;
     void initFlow(bool isActive);
     Flow& getFlow() { return _internalFlow; }
 
@@ -11,6 +11,8 @@
 
 #include "JSBaker.h"
 
+#include <array>
+
 #include <QtNetwork/QNetworkReply>
 
 #include <NetworkAccessManager.h>
@@ -98,7 +100,7 @@ void JSBaker::processScript() {
     bool success = bakeJS(_originalScript, outputJS);
     if (!success) {
         qCDebug(js_baking) << "Bake Failed";
-        handleError("Unterminated multi-line comment");
+        handleError("Unterminated multi-line comment or string");
         return;
     }
 
@@ -126,54 +128,140 @@ void JSBaker::processScript() {
     emit finished();
 }
 
+namespace {
+
+// classes of the bytes the minifier cares about, every byte of a multi-byte UTF-8 sequence is ALPHANUM
+enum CharacterClass : uint8_t {
+    ALPHANUM = 1 << 0,
+    // on both sides of a space, the space is kept
+    SPECIAL = 1 << 1,
+    // before and after a new line, maybe keep the new line (depends on the other side as well)
+    SPECIAL_PREVIOUS = 1 << 2,
+    SPECIAL_NEXT = 1 << 3,
+    SPACE_OR_TAB = 1 << 4,
+    QUOTE = 1 << 5
+};
+
+std::array<uint8_t, 256> buildCharacterClasses() {
+    std::array<uint8_t, 256> classes;
+    classes.fill(0);
+
+    // alphabet, numbers, '_', '$', '\\' and anything past printable ASCII
+    for (int c = 0; c < 256; ++c) {
+        if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z')
+            || c == '_' || c == '$' || c == '\\' || c > ASCII_CHARACTERS_UPPER_LIMIT) {
+            classes[c] |= ALPHANUM;
+        }
+    }
+    for (unsigned char c : { '\'', '$', '_', '/', '+', '-' }) {
+        classes[c] |= SPECIAL;
+    }
+    for (unsigned char c : { '\'', '$', '_', '}', ']', ')', '+', '-', '"' }) {
+        classes[c] |= SPECIAL_PREVIOUS;
+    }
+    for (unsigned char c : { '\'', '$', '_', '{', '[', '(', '+', '-' }) {
+        classes[c] |= SPECIAL_NEXT;
+    }
+    for (unsigned char c : { ' ', '\t' }) {
+        classes[c] |= SPACE_OR_TAB;
+    }
+    for (unsigned char c : { '"', '\'', '`' }) {
+        classes[c] |= QUOTE;
+    }
+    return classes;
+}
+
+const std::array<uint8_t, 256> CHARACTER_CLASSES = buildCharacterClasses();
+
+inline bool hasClass(char c, uint8_t characterClass) {
+    return (CHARACTER_CLASSES[(unsigned char)c] & characterClass) != 0;
+}
+
+inline bool canOmitSpace(char previousCharacter, char nextCharacter) {
+    return !(hasClass(previousCharacter, ALPHANUM | SPECIAL) && hasClass(nextCharacter, ALPHANUM | SPECIAL));
+}
+
+inline bool canOmitNewLine(char previousCharacter, char nextCharacter) {
+    return !(hasClass(previousCharacter, ALPHANUM | SPECIAL_PREVIOUS) && hasClass(nextCharacter, ALPHANUM | SPECIAL_NEXT));
+}
+
+}
+
 bool JSBaker::bakeJS(const QByteArray& inputFile, QByteArray& outputFile) {
-    // Read from inputFile and write to outputFile per character 
-    QTextStream in(inputFile, QIODevice::ReadOnly);
-    QTextStream out(&outputFile, QIODevice::WriteOnly);
+    // Works directly on the UTF-8 bytes: every byte of a multi-byte sequence is treated like a letter, which is how
+    // the non-ASCII character it encodes is treated, so the output matches minifying the decoded text
+    const char* in = inputFile.constData();
+    const char* const inEnd = in + inputFile.size();
+
+    // a leading byte order mark isn't part of the script
+    static const char UTF8_BOM[] = { '\xEF', '\xBB', '\xBF' };
+    if (inEnd - in >= 3 && memcmp(in, UTF8_BOM, sizeof(UTF8_BOM)) == 0) {
+        in += sizeof(UTF8_BOM);
+    }
+
+    // every input byte produces at most one output byte, plus the NUL read past the end below
+    outputFile.resize((int)(inEnd - in) + 1);
+    char* const outBegin = outputFile.data();
+    char* out = outBegin;
+
+    // reading past the end yields a NUL character
+    auto atEnd = [&] { return in >= inEnd; };
+    auto read = [&]() -> char { return in < inEnd ? *in++ : '\0'; };
 
     // Algorithm requires the knowledge of previous and next character for each character read
-    QChar currentCharacter;
-    QChar nextCharacter;
+    char currentCharacter = read();
+    char nextCharacter;
     // Initialize previousCharacter with new line
-    QChar previousCharacter = '\n';
+    char previousCharacter = '\n';
 
-    in >> currentCharacter;
-
-    while (!in.atEnd()) {
-        in >> nextCharacter;
+    while (!atEnd()) {
+        nextCharacter = read();
 
         if (currentCharacter == '\r') {
-            out << '\n';
+            *out++ = '\n';
         } else if (currentCharacter == '/') {
             // Check if single line comment i.e. //
             if (nextCharacter == '/') {
-                handleSingleLineComments(in);
+                // Skip up to and including the end of the line
+                auto endOfLine = (const char*)memchr(in, '\n', inEnd - in);
+                in = endOfLine ? endOfLine + 1 : inEnd;
 
                 //Start fresh after handling comments
                 previousCharacter = '\n';
-                in >> currentCharacter;
+                currentCharacter = read();
                 continue;
             } else if (nextCharacter == '*') {
                 // Check if multi line comment i.e. /*
-                bool success = handleMultiLineComments(in);
-                if (!success) {
+                // the character after each '*' is consumed, so "**/" does not close the comment
+                bool terminated = false;
+                while (!atEnd()) {
+                    auto star = (const char*)memchr(in, '*', inEnd - in);
+                    if (!star) {
+                        in = inEnd;
+                        break;
+                    }
+                    in = star + 1;
+                    if (read() == '/') {
+                        terminated = true;
+                        break;
+                    }
+                }
+                if (!terminated) {
                     // Errors present return false
                     return false;
                 }
                 //Start fresh after handling comments
                 previousCharacter = '\n';
-                in >> currentCharacter;
+                currentCharacter = read();
                 continue;
             } else {
                 // If '/' is not followed by '/' or '*' print '/'
-                out << currentCharacter;
+                *out++ = currentCharacter;
             }
-        } else if (isSpaceOrTab(currentCharacter)) {
-            // Check if white space or tab
-
+        } else if (hasClass(currentCharacter, SPACE_OR_TAB)) {
             // Skip multiple spaces or tabs
-            while (isSpaceOrTab(nextCharacter)) {
-                in >> nextCharacter;
+            while (hasClass(nextCharacter, SPACE_OR_TAB)) {
+                nextCharacter = read();
                 if (nextCharacter == '\n') {
                     break;
                 }
@@ -181,42 +269,45 @@ bool JSBaker::bakeJS(const QByteArray& inputFile, QByteArray& outputFile) {
 
             // check if space can be omitted
             if (!canOmitSpace(previousCharacter, nextCharacter)) {
-                out << ' ';
+                *out++ = ' ';
             }
         } else if (currentCharacter == '\n') {
-            // Check if new line
-
             //Skip multiple new lines
             //Skip new line followed by space or tab
-            while (nextCharacter == '\n' || isSpaceOrTab(nextCharacter)) {
-                in >> nextCharacter;
+            while (nextCharacter == '\n' || hasClass(nextCharacter, SPACE_OR_TAB)) {
+                nextCharacter = read();
             }
 
             // Check if new line can be omitted
             if (!canOmitNewLine(previousCharacter, nextCharacter)) {
-                out << '\n';
+                *out++ = '\n';
             }
-        } else if (isQuote(currentCharacter)) {
+        } else if (hasClass(currentCharacter, QUOTE)) {
             // Print the current quote and nextCharacter as is
-            out << currentCharacter;
-            out << nextCharacter;
-
-            // Store the type of quote we are processing
-            QChar quote = currentCharacter;
-
-            // Don't modify the quoted strings
-            while (nextCharacter != quote) {
-                in >> nextCharacter;
-                out << nextCharacter;
+            *out++ = currentCharacter;
+            *out++ = nextCharacter;
+
+            // Don't modify the quoted strings, copy everything up to and including the closing quote
+            if (nextCharacter != currentCharacter) {
+                auto closingQuote = (const char*)memchr(in, currentCharacter, inEnd - in);
+                if (!closingQuote) {
+                    // Unterminated string
+                    return false;
+                }
+                auto length = closingQuote + 1 - in;
+                memcpy(out, in, length);
+                out += length;
+                in += length;
+                nextCharacter = currentCharacter;
             }
 
             //Start fresh after handling quoted strings
             previousCharacter = nextCharacter;
-            in >> currentCharacter;
+            currentCharacter = read();
             continue;
         } else {
             // In all other cases write the currentCharacter to outputFile
-            out << currentCharacter;
+            *out++ = currentCharacter;
         }
 
         previousCharacter = currentCharacter;
@@ -225,80 +316,11 @@ bool JSBaker::bakeJS(const QByteArray& inputFile, QByteArray& outputFile) {
 
     //write currentCharacter to output file when nextCharacter reaches EOF
     if (currentCharacter != '\n') {
-        out << currentCharacter;
+        *out++ = currentCharacter;
     }
 
+    outputFile.resize((int)(out - outBegin));
+
     // Successful bake. Return true
     return true;
 }
-
-void JSBaker::handleSingleLineComments(QTextStream& in) {
-    QChar character;
-    while (!in.atEnd()) {
-        in >> character;
-        if (character == '\n') {
-            break;
-        }
-    }
-}
-
-bool JSBaker::handleMultiLineComments(QTextStream& in) {
-    QChar character;
-    while (!in.atEnd()) {
-        in >> character;
-        if (character == '*') {
-            if (in.read(1) == "/") {
-                return true;
-            }
-        }
-    }
-    return false;
-}
-
-bool JSBaker::canOmitSpace(QChar previousCharacter, QChar nextCharacter) {
-    return(!((isAlphanum(previousCharacter) || isNonAscii(previousCharacter) || isSpecialCharacter(previousCharacter)) &&
-        (isAlphanum(nextCharacter) || isNonAscii(nextCharacter) || isSpecialCharacter(nextCharacter)))
-           );
-}
-
-bool JSBaker::canOmitNewLine(QChar previousCharacter, QChar nextCharacter) {
-    return (!((isAlphanum(previousCharacter) || isNonAscii(previousCharacter) || isSpecialCharacterPrevious(previousCharacter)) &&
-        (isAlphanum(nextCharacter) || isNonAscii(nextCharacter) || isSpecialCharacterNext(nextCharacter)))
-            );
-}
-
-//Check if character is alphabet, number or one of the following: '_', '$', '\\' or a non-ASCII character
-bool JSBaker::isAlphanum(QChar c) {
-    return ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z')
-            || c == '_' || c == '$' || c == '\\' || c > ASCII_CHARACTERS_UPPER_LIMIT);
-}
-
-bool JSBaker::isNonAscii(QChar c) {
-    return ((int)c.toLatin1() > ASCII_CHARACTERS_UPPER_LIMIT);
-}
-
-// If previous and next characters are special characters, don't omit space
-bool JSBaker::isSpecialCharacter(QChar c) {
-    return (c == '\'' || c == '$' || c == '_' || c == '/' || c== '+' || c == '-');
-}
-
-// If previous character is a special character, maybe don't omit new line (depends on next character as well)
-bool JSBaker::isSpecialCharacterPrevious(QChar c) {
-    return (c == '\'' || c == '$' || c == '_' || c == '}' || c == ']' || c == ')' || c == '+' || c == '-'
-            || c == '"' || c == '\'');
-}
-
-// If next character is a special character, maybe don't omit new line (depends on previous character as well)
-bool JSBaker::isSpecialCharacterNext(QChar c) {
-    return (c == '\'' || c == '$' || c == '_' || c == '{' || c == '[' || c == '(' || c == '+' || c == '-');
-}
-
-// Check if white space or tab
-bool JSBaker::isSpaceOrTab(QChar c) {
-    return (c == ' ' || c == '\t');
-}
-
-// Check If the currentCharacter is " or ' or `
-bool JSBaker::isQuote(QChar c) {
-    return (c == '"' || c == '\'' || c == '`');
-}
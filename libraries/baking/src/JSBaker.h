@@ -45,20 +45,6 @@ private:
     QByteArray _originalScript;
     QString _bakedOutputDir;
     QString _bakedJSFilePath;
-
-    static void handleSingleLineComments(QTextStream& in);
-    static bool handleMultiLineComments(QTextStream& in);
-
-    static bool canOmitSpace(QChar previousCharacter, QChar nextCharacter);
-    static bool canOmitNewLine(QChar previousCharacter, QChar nextCharacter);
-
-    static bool isAlphanum(QChar c);
-    static bool isNonAscii(QChar c);
-    static bool isSpecialCharacter(QChar c);
-    static bool isSpecialCharacterPrevious(QChar c);
-    static bool isSpecialCharacterNext(QChar c);
-    static bool isSpaceOrTab(QChar c);
-    static bool isQuote(QChar c);
 };
 
 #endif // !hifi_JSBaker_h
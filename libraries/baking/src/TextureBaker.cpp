@@ -30,6 +30,8 @@ const QString BAKED_TEXTURE_KTX_EXT = ".ktx";
 const QString BAKED_TEXTURE_BCN_SUFFIX = "_bcn.ktx";
 const QString BAKED_META_TEXTURE_SUFFIX = ".texmeta.json";
 
+const int TEXTURE_BAKER_VERSION = 1;
+
 bool TextureBaker::_compressionEnabled = true;
 
 TextureBaker::TextureBaker(const QUrl& textureURL, image::TextureUsage::Type textureType,
@@ -167,74 +169,78 @@ void TextureBaker::processTexture() {
             gpu::BackendTarget::GLES32
         }};
         for (auto target : BACKEND_TARGETS) {
+            // The mips are written to disk as they are compressed rather than kept with the texture,
+            // the file is named after the compressed format once the texture is laid out
+            QString fileName;
+            QString outputError;
+            khronos::gl::texture::InternalFormat internalFormat;
+            auto output = [&](gpu::Texture& texture) {
+                ktx::Header header;
+                if (!gpu::Texture::evalKTXFormat(texture.getStoredMipFormat(), texture.getTexelFormat(), header)) {
+                    outputError = "Could not serialize " + _textureURL.toString() + " to KTX";
+                    return false;
+                }
+
+                internalFormat = header.getGLInternaFormat();
+                const char* name = khronos::gl::texture::toString(internalFormat);
+                if (name == nullptr) {
+                    outputError = "Could not determine internal format for compressed KTX: " + _textureURL.toString();
+                    return false;
+                }
+
+                fileName = _baseFilename + "_" + name + ".ktx";
+                texture.setSourceHash(hash);
+                if (!texture.setKtxOutput(_outputDirectory.absoluteFilePath(fileName).toStdString())) {
+                    outputError = "Could not write baked texture for " + _textureURL.toString();
+                    return false;
+                }
+                return true;
+            };
+
             auto processedTexture = image::processImage(buffer, _textureURL.toString().toStdString(), image::ColorChannel::NONE,
                                                         ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, _textureType, true,
-                                                        target, _abortProcessing);
+                                                        target, _abortProcessing, output);
             if (!processedTexture) {
-                handleError("Could not process texture " + _textureURL.toString());
+                handleError(outputError.isEmpty() ? "Could not process texture " + _textureURL.toString() : outputError);
                 return;
             }
-            processedTexture->setSourceHash(hash);
 
             if (shouldStop()) {
                 return;
             }
 
-            auto memKTX = gpu::Texture::serialize(*processedTexture);
-            if (!memKTX) {
-                handleError("Could not serialize " + _textureURL.toString() + " to KTX");
-                return;
-            }
-
-            const char* name = khronos::gl::texture::toString(memKTX->_header.getGLInternaFormat());
-            if (name == nullptr) {
-                handleError("Could not determine internal format for compressed KTX: " + _textureURL.toString());
-                return;
-            }
-
-            const char* data = reinterpret_cast<const char*>(memKTX->_storage->data());
-            const size_t length = memKTX->_storage->size();
-
-            auto fileName = _baseFilename + "_" + name + ".ktx";
-            auto filePath = _outputDirectory.absoluteFilePath(fileName);
-            QFile bakedTextureFile { filePath };
-            if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data, length) == -1) {
+            if (!processedTexture->finishKtxOutput()) {
                 handleError("Could not write baked texture for " + _textureURL.toString());
                 return;
             }
-            _outputFiles.push_back(filePath);
-            meta.availableTextureTypes[memKTX->_header.getGLInternaFormat()] = fileName;
+            _outputFiles.push_back(_outputDirectory.absoluteFilePath(fileName));
+            meta.availableTextureTypes[internalFormat] = fileName;
         }
     }
 
     // Uncompressed KTX
     if (_textureType == image::TextureUsage::Type::SKY_TEXTURE || _textureType == image::TextureUsage::Type::AMBIENT_TEXTURE) {
         buffer->reset();
+        auto fileName = _baseFilename + ".ktx";
+        auto filePath = _outputDirectory.absoluteFilePath(fileName);
+        auto output = [&](gpu::Texture& texture) {
+            texture.setSourceHash(hash);
+            return texture.setKtxOutput(filePath.toStdString());
+        };
+
         auto processedTexture = image::processImage(std::move(buffer), _textureURL.toString().toStdString(), image::ColorChannel::NONE,
-                                                    ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, _textureType, false, gpu::BackendTarget::GL45, _abortProcessing);
+                                                    ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, _textureType, false, gpu::BackendTarget::GL45,
+                                                    _abortProcessing, output);
         if (!processedTexture) {
             handleError("Could not process texture " + _textureURL.toString());
             return;
         }
-        processedTexture->setSourceHash(hash);
 
         if (shouldStop()) {
             return;
         }
 
-        auto memKTX = gpu::Texture::serialize(*processedTexture);
-        if (!memKTX) {
-            handleError("Could not serialize " + _textureURL.toString() + " to KTX");
-            return;
-        }
-
-        const char* data = reinterpret_cast<const char*>(memKTX->_storage->data());
-        const size_t length = memKTX->_storage->size();
-
-        auto fileName = _baseFilename + ".ktx";
-        auto filePath = _outputDirectory.absoluteFilePath(fileName);
-        QFile bakedTextureFile { filePath };
-        if (!bakedTextureFile.open(QIODevice::WriteOnly) || bakedTextureFile.write(data, length) == -1) {
+        if (!processedTexture->finishKtxOutput()) {
             handleError("Could not write baked texture for " + _textureURL.toString());
             return;
         }
@@ -27,6 +27,9 @@
 extern const QString BAKED_TEXTURE_KTX_EXT;
 extern const QString BAKED_META_TEXTURE_SUFFIX;
 
+// bump this whenever a change to the texture baker alters its output
+extern const int TEXTURE_BAKER_VERSION;
+
 class TextureBaker : public Baker {
     Q_OBJECT
 
@@ -46,6 +49,7 @@ public:
     virtual void setWasAborted(bool wasAborted) override;
 
     static void setCompressionEnabled(bool enabled) { _compressionEnabled = enabled; }
+    static bool isCompressionEnabled() { return _compressionEnabled; }
 
     void setMapChannel(graphics::Material::MapChannel mapChannel) { _mapChannel = mapChannel; }
     graphics::Material::MapChannel getMapChannel() const { return _mapChannel; }
@@ -69,7 +69,8 @@ void EntityEditPacketSender::queueEditAvatarEntityMessage(EntityTreePointer enti
 void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
                                                     EntityTreePointer entityTree,
                                                     EntityItemID entityItemID,
-                                                    const EntityItemProperties& properties) {
+                                                    const EntityItemProperties& properties,
+                                                    EditMessageBatch* batch) {
     if (properties.getEntityHostType() == entity::HostType::AVATAR) {
         if (!_myAvatar) {
             qCWarning(entities) << "Suppressing entity edit message: cannot send avatar entity edit with no myAvatar";
@@ -126,7 +127,11 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
                 qCDebug(entities) << "    properties:" << properties;
             #endif
 
-            queueOctreeEditMessage(type, bufferOut);
+            if (batch) {
+                batch->emplace_back(type, bufferOut);
+            } else {
+                queueOctreeEditMessage(type, bufferOut);
+            }
             if (type == PacketType::EntityAdd && !properties.getCertificateID().isEmpty()) {
                 emit addingEntityWithCertificate(properties.getCertificateID(), DependencyManager::get<AddressManager>()->getPlaceName());
             }
@@ -142,6 +147,13 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
     }
 }
 
+void EntityEditPacketSender::queueEditMessageBatch(EditMessageBatch& batch) {
+    if (!batch.empty()) {
+        queueOctreeEditMessages(batch);
+        batch.clear();
+    }
+}
+
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
 
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
@@ -23,6 +23,8 @@
 class EntityEditPacketSender :  public OctreeEditPacketSender {
     Q_OBJECT
 public:
+    using EditMessageBatch = std::vector<EditMessagePair>;
+
     EntityEditPacketSender();
 
     void setMyAvatar(AvatarData* myAvatar) { _myAvatar = myAvatar; }
@@ -32,8 +34,13 @@ public:
     /// which voxel-server node or nodes the packet should be sent to. Can be called even before voxel servers are known, in
     /// which case up to MaxPendingMessages will be buffered and processed when voxel servers are known.
     /// NOTE: EntityItemProperties assumes that all distances are in meter units
+    /// When batch is given the encoded messages are appended to it instead, to be queued later by queueEditMessageBatch()
     void queueEditEntityMessage(PacketType type, EntityTreePointer entityTree,
-                                EntityItemID entityItemID, const EntityItemProperties& properties);
+                                EntityItemID entityItemID, const EntityItemProperties& properties,
+                                EditMessageBatch* batch = nullptr);
+
+    /// Queues and clears messages gathered by queueEditEntityMessage(), which is cheaper than queueing them one by one
+    void queueEditMessageBatch(EditMessageBatch& batch);
 
 
     void queueEraseEntityMessage(const EntityItemID& entityItemID);
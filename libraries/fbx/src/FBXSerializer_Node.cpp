@@ -11,199 +11,180 @@
 
 #include "FBXSerializer.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <vector>
+
+#include <zlib.h>
+
 #include <QtCore/QBuffer>
-#include <QtCore/QDataStream>
+#include <QtCore/QFile>
 #include <QtCore/QIODevice>
 #include <QtCore/QStringList>
 #include <QtCore/QTextStream>
 #include <QtCore/QDebug>
-#include <QtCore/QtEndian>
 #include <QtCore/QFileInfo>
 
 #include <shared/NsightHelpers.h>
+#include <TBBHelpers.h>
 #include <hfm/ModelFormatLogging.h>
 
+namespace {
+
+// A compressed property array whose inflation is deferred until the whole node tree has been read,
+// so that all of a file's arrays can be inflated in parallel straight into their final storage.
+struct FBXInflateJob {
+    const char* source;
+    uLong sourceLength;
+    char* destination;
+    uLong destinationLength;
+    void (*swapToHostOrder)(char* data, uLong length);
+};
+
 template<class T>
-int streamSize() {
-    return sizeof(T);
+void swapArrayToHostOrder(char* data, uLong length) {
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    for (char* it = data, *end = data + length; it != end; it += sizeof(T)) {
+        std::reverse(it, it + sizeof(T));
+    }
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(length);
+#endif
 }
 
-template<bool>
-int streamSize() {
-    return 1;
-}
+// Reads a binary FBX document directly out of memory (a QBuffer's byte array or a mapped file)
+// without going through QDataStream.
+class FBXBinaryReader {
+public:
+    FBXBinaryReader(const char* data, qint64 size) : _data(data), _size(size) {}
 
-template<class T>
-QVariant readBinaryArray(QDataStream& in, int& position) {
-    quint32 arrayLength;
-    quint32 encoding;
-    quint32 compressedLength;
+    qint64 position() const { return _position; }
+    bool atEnd() const { return _position >= _size; }
+
+    const char* readRaw(qint64 length) {
+        if (length < 0 || length > _size - _position) {
+            throw QString("FBX file most likely corrupt: unexpected end of data");
+        }
+        const char* data = _data + _position;
+        _position += length;
+        return data;
+    }
+
+    template<class T>
+    T read() {
+        T value;
+        memcpy(&value, readRaw(sizeof(T)), sizeof(T));
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+        std::reverse(reinterpret_cast<char*>(&value), reinterpret_cast<char*>(&value) + sizeof(T));
+#endif
+        return value;
+    }
+
+    std::vector<FBXInflateJob> inflateJobs;
 
-    in >> arrayLength;
+private:
+    const char* _data;
+    qint64 _size;
+    qint64 _position { 0 };
+};
+
+template<class T>
+QVariant readBinaryArray(FBXBinaryReader& in) {
+    quint32 arrayLength = in.read<quint32>();
     if (arrayLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: binary data exceeds data limits");
     }
-    in >> encoding;
-    in >> compressedLength;
+    quint32 encoding = in.read<quint32>();
+    quint32 compressedLength = in.read<quint32>();
     if (compressedLength > std::numeric_limits<int>::max() / sizeof(T)) { // Upcoming byte containers are limited to max signed int
         throw QString("FBX file most likely corrupt: compressed binary data exceeds data limits");
     }
-    position += sizeof(quint32) * 3;
-
-    QVector<T> values;
-    if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
-        values.resize(arrayLength);
-        hifi::ByteArray arrayData;
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            arrayData = qUncompress(compressed);
-            if (arrayData.isEmpty() ||
-                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-        } else {
-            arrayData.resize(sizeof(T) * arrayLength);
-            position += sizeof(T) * arrayLength;
-            in.readRawData(arrayData.data(), arrayData.size());
-        }
 
-        if (arrayData.size() > 0) {
-            memcpy(&values[0], arrayData.constData(), arrayData.size());
-        }
-    } else {
-        values.reserve(arrayLength);
-        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
-            // preface encoded data with uncompressed length
-            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
-            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
-            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
-            position += compressedLength;
-            hifi::ByteArray uncompressed = qUncompress(compressed);
-            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
-                throw QString("corrupt fbx file");
-            }
-            QDataStream uncompressedIn(uncompressed);
-            uncompressedIn.setByteOrder(QDataStream::LittleEndian);
-            uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                uncompressedIn >> value;
-                values.append(value);
-            }
-        } else {
-            for (quint32 i = 0; i < arrayLength; i++) {
-                T value;
-                in >> value;
-                position += streamSize<T>();
-                values.append(value);
-            }
+    // the values are decoded straight into the vector handed back in the QVariant, whose storage is shared
+    // (not copied) as the property and its node are copied up the tree
+    QVector<T> values(arrayLength);
+    uLong dataLength = sizeof(T) * arrayLength;
+
+    if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+        const char* compressed = in.readRaw(compressedLength);
+        if (dataLength > 0) {
+            in.inflateJobs.push_back({ compressed, compressedLength, reinterpret_cast<char*>(values.data()), dataLength,
+                                       &swapArrayToHostOrder<T> });
         }
+    } else if (dataLength > 0) {
+        char* destination = reinterpret_cast<char*>(values.data());
+        memcpy(destination, in.readRaw(dataLength), dataLength);
+        swapArrayToHostOrder<T>(destination, dataLength);
     }
+
     return QVariant::fromValue(values);
 }
 
-QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
-    char ch;
-    in.device()->getChar(&ch);
-    position++;
+QVariant parseBinaryFBXProperty(FBXBinaryReader& in) {
+    char ch = in.read<char>();
     switch (ch) {
         case 'Y': {
-            qint16 value;
-            in >> value;
-            position += sizeof(qint16);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<qint16>());
         }
         case 'C': {
-            bool value;
-            in >> value;
-            position++;
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<quint8>() != 0);
         }
         case 'I': {
-            qint32 value;
-            in >> value;
-            position += sizeof(qint32);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<qint32>());
         }
         case 'F': {
-            float value;
-            in >> value;
-            position += sizeof(float);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<float>());
         }
         case 'D': {
-            double value;
-            in >> value;
-            position += sizeof(double);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<double>());
         }
         case 'L': {
-            qint64 value;
-            in >> value;
-            position += sizeof(qint64);
-            return QVariant::fromValue(value);
+            return QVariant::fromValue(in.read<qint64>());
         }
         case 'f': {
-            return readBinaryArray<float>(in, position);
+            return readBinaryArray<float>(in);
         }
         case 'd': {
-            return readBinaryArray<double>(in, position);
+            return readBinaryArray<double>(in);
         }
         case 'l': {
-            return readBinaryArray<qint64>(in, position);
+            return readBinaryArray<qint64>(in);
         }
         case 'i': {
-            return readBinaryArray<qint32>(in, position);
+            return readBinaryArray<qint32>(in);
         }
         case 'b': {
-            return readBinaryArray<bool>(in, position);
+            return readBinaryArray<bool>(in);
         }
         case 'S':
         case 'R': {
-            quint32 length;
-            in >> length;
-            position += sizeof(quint32) + length;
-            return QVariant::fromValue(in.device()->read(length));
+            quint32 length = in.read<quint32>();
+            return QVariant::fromValue(hifi::ByteArray(in.readRaw(length), length));
         }
         default:
             throw QString("Unknown property type: ") + ch;
     }
 }
 
-FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions = false) {
+FBXNode parseBinaryFBXNode(FBXBinaryReader& in, bool has64BitPositions = false) {
     qint64 endOffset;
     quint64 propertyCount;
-    quint64 propertyListLength;
-    quint8 nameLength;
 
     // FBX 2016 and beyond uses 64bit positions in the node headers, pre-2016 used 32bit values
     // our code generally doesn't care about the size that much, so we will use 64bit values
-    // from here on out, but if the file is an older format we read the stream into temp 32bit 
-    // values and then assign to our actual 64bit values.
+    // from here on out, but if the file is an older format we read the 32bit values and widen them.
     if (has64BitPositions) {
-        in >> endOffset;
-        in >> propertyCount;
-        in >> propertyListLength;
-        position += sizeof(quint64) * 3;
+        endOffset = in.read<qint64>();
+        propertyCount = in.read<quint64>();
+        in.read<quint64>(); // property list length
     } else {
-        qint32 tempEndOffset;
-        quint32 tempPropertyCount;
-        quint32 tempPropertyListLength;
-        in >> tempEndOffset;
-        in >> tempPropertyCount;
-        in >> tempPropertyListLength;
-        position += sizeof(quint32) * 3;
-        endOffset = tempEndOffset;
-        propertyCount = tempPropertyCount;
-        propertyListLength = tempPropertyListLength;
-    }
-    in >> nameLength;
-    position += sizeof(quint8);
+        endOffset = in.read<qint32>();
+        propertyCount = in.read<quint32>();
+        in.read<quint32>(); // property list length
+    }
+    quint8 nameLength = in.read<quint8>();
 
     FBXNode node;
     const int MIN_VALID_OFFSET = 40;
@@ -211,15 +192,14 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
         // use a null name to indicate a null node
         return node;
     }
-    node.name = in.device()->read(nameLength);
-    position += nameLength;
+    node.name = hifi::ByteArray(in.readRaw(nameLength), nameLength);
 
-    for (quint32 i = 0; i < propertyCount; i++) {
-        node.properties.append(parseBinaryFBXProperty(in, position));
+    for (quint64 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseBinaryFBXProperty(in));
     }
 
-    while (endOffset > position) {
-        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+    while (endOffset > in.position()) {
+        FBXNode child = parseBinaryFBXNode(in, has64BitPositions);
         if (!child.name.isNull()) {
             node.children.append(child);
         }
@@ -228,6 +208,30 @@ FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPosition
     return node;
 }
 
+void inflateBinaryFBXArrays(const std::vector<FBXInflateJob>& jobs) {
+    std::atomic<bool> corrupt { false };
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, jobs.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            const FBXInflateJob& job = jobs[i];
+            uLong inflatedLength = job.destinationLength;
+            int result = uncompress(reinterpret_cast<Bytef*>(job.destination), &inflatedLength,
+                                    reinterpret_cast<const Bytef*>(job.source), job.sourceLength);
+            if (result != Z_OK || inflatedLength != job.destinationLength) {
+                corrupt = true;
+            } else {
+                job.swapToHostOrder(job.destination, job.destinationLength);
+            }
+        }
+    });
+
+    if (corrupt) {
+        throw QString("corrupt fbx file");
+    }
+}
+
+}
+
 class Tokenizer {
 public:
 
@@ -369,9 +373,26 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
         }
         return top;
     }
-    QDataStream in(device);
-    in.setByteOrder(QDataStream::LittleEndian);
-    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
+
+    // read the binary document in place: straight out of the buffer when we're handed one (the common case
+    // from FBXSerializer::read), from a mapping when handed a file, and only otherwise by reading it all in
+    hifi::ByteArray readData;
+    const char* data = nullptr;
+    qint64 size = device->size() - device->pos();
+    uchar* mappedData = nullptr;
+    QFile* file = qobject_cast<QFile*>(device);
+
+    if (QBuffer* buffer = qobject_cast<QBuffer*>(device)) {
+        data = buffer->data().constData() + buffer->pos();
+    } else if (file && (mappedData = file->map(file->pos(), size))) {
+        data = reinterpret_cast<const char*>(mappedData);
+    } else {
+        readData = device->readAll();
+        data = readData.constData();
+        size = readData.size();
+    }
+
+    FBXBinaryReader in(data, size);
 
     // see http://code.blender.org/index.php/2013/08/fbx-binary-file-format-specification/ for an explanation
     // of the FBX binary format
@@ -380,24 +401,34 @@ FBXNode FBXSerializer::parseFBX(QIODevice* device) {
     //   Bytes 0 - 20: Kaydara FBX Binary  \x00(file - magic, with 2 spaces at the end, then a NULL terminator).
     //   Bytes 21 - 22: [0x1A, 0x00](unknown but all observed files show these bytes).
     //   Bytes 23 - 26 : unsigned int, the version number. 7300 for version 7.3 for example.
-    in.skipRawData(FBX_HEADER_BYTES_BEFORE_VERSION);
-    int position = FBX_HEADER_BYTES_BEFORE_VERSION;
-    quint32 fileVersion;
-    in >> fileVersion;
-    position += sizeof(fileVersion);
-    qCDebug(modelformat) << "fileVersion:" << fileVersion;
-    bool has64BitPositions = (fileVersion >= FBX_VERSION_2016);
-
-    // parse the top-level node
     FBXNode top;
-    while (device->bytesAvailable()) {
-        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
-        if (next.name.isNull()) {
-            return top;
+    try {
+        in.readRaw(FBX_HEADER_BYTES_BEFORE_VERSION);
+        quint32 fileVersion = in.read<quint32>();
+        qCDebug(modelformat) << "fileVersion:" << fileVersion;
+        bool has64BitPositions = (fileVersion >= FBX_VERSION_2016);
+
+        // parse the top-level node
+        while (!in.atEnd()) {
+            FBXNode next = parseBinaryFBXNode(in, has64BitPositions);
+            if (next.name.isNull()) {
+                break;
+            } else {
+                top.children.append(next);
+            }
+        }
 
-        } else {
-            top.children.append(next);
+        // the compressed arrays still point into the document, so inflate them before letting go of it
+        inflateBinaryFBXArrays(in.inflateJobs);
+    } catch (...) {
+        if (mappedData) {
+            file->unmap(mappedData);
         }
+        throw;
+    }
+
+    if (mappedData) {
+        file->unmap(mappedData);
     }
 
     return top;
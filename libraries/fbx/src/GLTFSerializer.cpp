@@ -20,6 +20,7 @@
 #include <QtCore/qjsonvalue.h>
 #include <QtCore/qpair.h>
 #include <QtCore/qlist.h>
+#include <QtCore/QtEndian>
 
 
 #include <QtNetwork/QNetworkAccessManager>
@@ -30,6 +31,7 @@
 
 #include <shared/NsightHelpers.h>
 #include <NetworkAccessManager.h>
+#include <TBBHelpers.h>
 #include <ResourceManager.h>
 #include <PathUtils.h>
 #include <image/ColorChannel.h>
@@ -127,26 +129,36 @@ bool GLTFSerializer::getObjectArrayVal(const QJsonObject& object, const QString&
 }
 
 hifi::ByteArray GLTFSerializer::setGLBChunks(const hifi::ByteArray& data) {
-    int byte = 4; 
-    int jsonStart = data.indexOf("JSON", Qt::CaseSensitive);
-    int binStart = data.indexOf("BIN", Qt::CaseSensitive);
-    int jsonLength, binLength;
-    hifi::ByteArray jsonLengthChunk, binLengthChunk;
-
-    jsonLengthChunk = data.mid(jsonStart - byte, byte);
-    QDataStream tempJsonLen(jsonLengthChunk);
-    tempJsonLen.setByteOrder(QDataStream::LittleEndian);
-    tempJsonLen >> jsonLength;
-    hifi::ByteArray jsonChunk = data.mid(jsonStart + byte, jsonLength);
-
-    if (binStart != -1) {
-        binLengthChunk = data.mid(binStart - byte, byte);
+    // see https://github.com/KhronosGroup/glTF/tree/master/specification/2.0#glb-file-format-specification
+    // a 12 byte header (magic, version, length) is followed by chunks of (length, type, data)
+    static const int GLB_HEADER_LENGTH = 12;
+    static const int GLB_CHUNK_HEADER_LENGTH = 8;
+    static const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;
+    static const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;
+
+    // hold on to the document so that the chunks below can refer to it in place instead of being copied out
+    _glbData = data;
+
+    hifi::ByteArray jsonChunk;
+    int chunkStart = GLB_HEADER_LENGTH;
+    while (chunkStart + GLB_CHUNK_HEADER_LENGTH <= _glbData.size()) {
+        const char* chunkHeader = _glbData.constData() + chunkStart;
+        quint32 chunkLength = qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(chunkHeader));
+        quint32 chunkType = qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(chunkHeader + 4));
+        int chunkDataStart = chunkStart + GLB_CHUNK_HEADER_LENGTH;
+
+        if (chunkLength > (quint32)(_glbData.size() - chunkDataStart)) {
+            qWarning(modelformat) << "GLB chunk exceeds the size of the file" << _url;
+            break;
+        }
 
-        QDataStream tempBinLen(binLengthChunk);
-        tempBinLen.setByteOrder(QDataStream::LittleEndian);
-        tempBinLen >> binLength;
+        if (chunkType == GLB_CHUNK_TYPE_JSON && jsonChunk.isNull()) {
+            jsonChunk = hifi::ByteArray::fromRawData(_glbData.constData() + chunkDataStart, chunkLength);
+        } else if (chunkType == GLB_CHUNK_TYPE_BIN && _glbBinary.isNull()) {
+            _glbBinary = hifi::ByteArray::fromRawData(_glbData.constData() + chunkDataStart, chunkLength);
+        }
 
-        _glbBinary = data.mid(binStart + byte, binLength);
+        chunkStart = chunkDataStart + chunkLength;
     }
     return jsonChunk;
 }
@@ -325,6 +337,7 @@ bool GLTFSerializer::addBufferView(const QJsonObject& object) {
     getIntVal(object, "buffer", bufferview.buffer, bufferview.defined);
     getIntVal(object, "byteLength", bufferview.byteLength, bufferview.defined);
     getIntVal(object, "byteOffset", bufferview.byteOffset, bufferview.defined);
+    getIntVal(object, "byteStride", bufferview.byteStride, bufferview.defined);
     getIntVal(object, "target", bufferview.target, bufferview.defined);
     
     _file.bufferviews.push_back(bufferview);
@@ -748,35 +761,78 @@ glm::mat4 GLTFSerializer::getModelTransform(const GLTFNode& node) {
 
 void GLTFSerializer::getSkinInverseBindMatrices(std::vector<std::vector<float>>& inverseBindMatrixValues) {
     for (auto &skin : _file.skins) {
-        GLTFAccessor& indicesAccessor = _file.accessors[skin.inverseBindMatrices];
-        GLTFBufferView& indicesBufferview = _file.bufferviews[indicesAccessor.bufferView];
-        GLTFBuffer& indicesBuffer = _file.buffers[indicesBufferview.buffer];
-        int accBoffset = indicesAccessor.defined["byteOffset"] ? indicesAccessor.byteOffset : 0;
+        const GLTFAccessor& indicesAccessor = _file.accessors[skin.inverseBindMatrices];
         QVector<float> matrices;
-        addArrayOfType(indicesBuffer.blob, 
-            indicesBufferview.byteOffset + accBoffset, 
-            indicesAccessor.count, 
-            matrices,
-            indicesAccessor.type, 
-            indicesAccessor.componentType);
+        addArrayFromAccessor(indicesAccessor, matrices);
         inverseBindMatrixValues.push_back(matrices.toStdVector());
     }
 }
 
 void GLTFSerializer::generateTargetData(int index, float weight, QVector<glm::vec3>& returnVector) {
-    GLTFAccessor& accessor = _file.accessors[index];
-    GLTFBufferView& bufferview = _file.bufferviews[accessor.bufferView];
-    GLTFBuffer& buffer = _file.buffers[bufferview.buffer];
-    int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
-    QVector<float> storedValues;
-    addArrayOfType(buffer.blob, 
-        bufferview.byteOffset + accBoffset, 
-        accessor.count, 
-        storedValues,
-        accessor.type,
-        accessor.componentType);
-    for (int n = 0; n < storedValues.size(); n = n + 3) {
-        returnVector.push_back(glm::vec3(weight * storedValues[n], weight * storedValues[n + 1], weight * storedValues[n + 2]));
+    const GLTFAccessor& accessor = _file.accessors[index];
+    QVector<glm::vec3> storedValues;
+    addVecArrayFromAccessor(accessor, storedValues);
+    returnVector.reserve(returnVector.size() + storedValues.size());
+    for (const glm::vec3& value : storedValues) {
+        returnVector.push_back(weight * value);
+    }
+}
+
+void GLTFSerializer::decodePrimitive(const GLTFMeshPrimitive& primitive, PrimitiveData& data) const {
+    if (!primitive.defined.value("indices") || primitive.indices < 0 || primitive.indices >= _file.accessors.size()) {
+        return;
+    }
+
+    data.hasIndices = addArrayFromAccessor(_file.accessors[primitive.indices], data.indices);
+    if (!data.hasIndices) {
+        return;
+    }
+
+    for (auto it = primitive.attributes.values.constBegin(); it != primitive.attributes.values.constEnd(); ++it) {
+        const QString& key = it.key();
+        int accessorIdx = it.value();
+        if (accessorIdx < 0 || accessorIdx >= _file.accessors.size()) {
+            continue;
+        }
+
+        const GLTFAccessor& accessor = _file.accessors[accessorIdx];
+        bool success = true;
+
+        if (key == "POSITION") {
+            success = addVecArrayFromAccessor(accessor, data.vertices);
+        } else if (key == "NORMAL") {
+            success = addVecArrayFromAccessor(accessor, data.normals);
+        } else if (key == "COLOR_0") {
+            QVector<float> colors;
+            success = addArrayFromAccessor(accessor, colors);
+            int stride = (accessor.type == GLTFAccessorType::VEC4) ? 4 : 3;
+            data.colors.reserve(colors.size() / stride);
+            for (int n = 0; success && n + stride <= colors.size(); n += stride) {
+                data.colors.push_back(glm::vec3(colors[n], colors[n + 1], colors[n + 2]));
+            }
+        } else if (key == "TANGENT") {
+            QVector<float> tangents;
+            success = addArrayFromAccessor(accessor, tangents);
+            // tangents can be a vec3 or a vec4 which includes a w component (of -1 or 1)
+            int stride = (accessor.type == GLTFAccessorType::VEC4) ? 4 : 3;
+            data.tangents.reserve(tangents.size() / stride);
+            for (int n = 0; success && n + stride <= tangents.size(); n += stride) {
+                float tanW = stride == 4 ? tangents[n + 3] : 1;
+                data.tangents.push_back(glm::vec3(tanW * tangents[n], tangents[n + 1], tanW * tangents[n + 2]));
+            }
+        } else if (key == "TEXCOORD_0") {
+            success = addVecArrayFromAccessor(accessor, data.texCoords);
+        } else if (key == "TEXCOORD_1") {
+            success = addVecArrayFromAccessor(accessor, data.texCoords1);
+        } else if (key == "JOINTS_0") {
+            success = addArrayFromAccessor(accessor, data.joints);
+        } else if (key == "WEIGHTS_0") {
+            success = addArrayFromAccessor(accessor, data.weights);
+        }
+
+        if (!success) {
+            qWarning(modelformat) << "There was a problem reading glTF" << key << "data for model " << _url;
+        }
     }
 }
 
@@ -933,8 +989,26 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
     }
 
     
+    // Decode the vertex data of every mesh primitive up front and in parallel, so that building
+    // each hfm::Mesh below only has to move the decoded attributes into place
+    std::vector<const GLTFMeshPrimitive*> primitives;
+    for (int nodeIndex : sortedNodes) {
+        auto& node = _file.nodes[nodeIndex];
+        if (node.defined["mesh"]) {
+            for (const auto& primitive : _file.meshes[node.mesh].primitives) {
+                primitives.push_back(&primitive);
+            }
+        }
+    }
+
+    std::vector<PrimitiveData> primitiveData(primitives.size());
+    tbb::parallel_for((size_t)0, primitives.size(), [&](size_t i) {
+        decodePrimitive(*primitives[i], primitiveData[i]);
+    });
+
     // Build meshes
     nodecount = 0;
+    size_t primitiveIndex = 0;
     for (int nodeIndex : sortedNodes) {
         auto& node = _file.nodes[nodeIndex];
 
@@ -942,6 +1016,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
             foreach(auto &primitive, _file.meshes[node.mesh].primitives) {
                 hfmModel.meshes.append(HFMMesh());
                 HFMMesh& mesh = hfmModel.meshes[hfmModel.meshes.size() - 1];
+                PrimitiveData& data = primitiveData[primitiveIndex++];
                 if (!hfmModel.hasSkeletonJoints) { 
                     HFMCluster cluster;
                     cluster.jointIndex = nodecount;
@@ -965,168 +1040,21 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
 
                 HFMMeshPart part = HFMMeshPart();
 
-                int indicesAccessorIdx = primitive.indices;
-
-                GLTFAccessor& indicesAccessor = _file.accessors[indicesAccessorIdx];
-                GLTFBufferView& indicesBufferview = _file.bufferviews[indicesAccessor.bufferView];
-                GLTFBuffer& indicesBuffer = _file.buffers[indicesBufferview.buffer];
-
-                int indicesAccBoffset = indicesAccessor.defined["byteOffset"] ? indicesAccessor.byteOffset : 0;
-
-                QVector<int> raw_indices;
-                QVector<glm::vec3> raw_vertices;
-                QVector<glm::vec3> raw_normals;
-
-                bool success = addArrayOfType(indicesBuffer.blob, 
-                    indicesBufferview.byteOffset + indicesAccBoffset, 
-                    indicesAccessor.count, 
-                    part.triangleIndices, 
-                    indicesAccessor.type, 
-                    indicesAccessor.componentType);
-
-                if (!success) {
+                if (!data.hasIndices) {
                     qWarning(modelformat) << "There was a problem reading glTF INDICES data for model " << _url;
                     continue;
                 }
 
-                QList<QString> keys = primitive.attributes.values.keys();
-                QVector<uint16_t> clusterJoints;
-                QVector<float> clusterWeights;
-
-                foreach(auto &key, keys) {
-                    int accessorIdx = primitive.attributes.values[key];
-
-                    GLTFAccessor& accessor = _file.accessors[accessorIdx];
-                    GLTFBufferView& bufferview = _file.bufferviews[accessor.bufferView];
-                    GLTFBuffer& buffer = _file.buffers[bufferview.buffer];
-
-                    int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
-                    if (key == "POSITION") {
-                        QVector<float> vertices;
-                        success = addArrayOfType(buffer.blob, 
-                            bufferview.byteOffset + accBoffset, 
-                            accessor.count, vertices, 
-                            accessor.type, 
-                            accessor.componentType);
-                        if (!success) {
-                            qWarning(modelformat) << "There was a problem reading glTF POSITION data for model " << _url;
-                            continue;
-                        }
-                        for (int n = 0; n < vertices.size(); n = n + 3) {
-                            mesh.vertices.push_back(glm::vec3(vertices[n], vertices[n + 1], vertices[n + 2]));
-                        }
-                    } else if (key == "NORMAL") {
-                        QVector<float> normals;
-                        success = addArrayOfType(buffer.blob, 
-                            bufferview.byteOffset + accBoffset, 
-                            accessor.count, 
-                            normals, 
-                            accessor.type, 
-                            accessor.componentType);
-                        if (!success) {
-                            qWarning(modelformat) << "There was a problem reading glTF NORMAL data for model " << _url;
-                            continue;
-                        }
-                        for (int n = 0; n < normals.size(); n = n + 3) {
-                            mesh.normals.push_back(glm::vec3(normals[n], normals[n + 1], normals[n + 2]));
-                        }
-                    } else if (key == "COLOR_0") {
-                        QVector<float> colors;
-                        success = addArrayOfType(buffer.blob, 
-                            bufferview.byteOffset + accBoffset, 
-                            accessor.count, 
-                            colors,
-                            accessor.type, 
-                            accessor.componentType);
-                        if (!success) {
-                            qWarning(modelformat) << "There was a problem reading glTF COLOR_0 data for model " << _url;
-                            continue;
-                        }
-                        int stride = (accessor.type == GLTFAccessorType::VEC4) ? 4 : 3;
-                        for (int n = 0; n < colors.size() - 3; n += stride) {
-                            mesh.colors.push_back(glm::vec3(colors[n], colors[n + 1], colors[n + 2]));
-                        }
-                    } else if (key == "TANGENT") {
-                        QVector<float> tangents;
-                        success = addArrayOfType(buffer.blob, 
-                            bufferview.byteOffset + accBoffset, 
-                            accessor.count, 
-                            tangents,
-                            accessor.type, 
-                            accessor.componentType);
-                        if (!success) {
-                            qWarning(modelformat) << "There was a problem reading glTF TANGENT data for model " << _url;
-                            continue;
-                        }
-                        // tangents can be a vec3 or a vec4 which includes a w component (of -1 or 1)
-                        int stride = (accessor.type == GLTFAccessorType::VEC4) ? 4 : 3;
-                        for (int n = 0; n < tangents.size() - 3; n += stride) {
-                            float tanW = stride == 4 ? tangents[n + 3] : 1; 
-                            mesh.tangents.push_back(glm::vec3(tanW * tangents[n], tangents[n + 1], tanW * tangents[n + 2]));
-                        }
-                    } else if (key == "TEXCOORD_0") {
-                        QVector<float> texcoords;
-                        success = addArrayOfType(buffer.blob, 
-                            bufferview.byteOffset + accBoffset, 
-                            accessor.count, 
-                            texcoords, 
-                            accessor.type, 
-                            accessor.componentType);
-                        if (!success) {
-                            qWarning(modelformat) << "There was a problem reading glTF TEXCOORD_0 data for model " << _url;
-                            continue;
-                        }
-                        for (int n = 0; n < texcoords.size(); n = n + 2) {
-                            mesh.texCoords.push_back(glm::vec2(texcoords[n], texcoords[n + 1]));
-                        }
-                    } else if (key == "TEXCOORD_1") {
-                        QVector<float> texcoords;
-                        success = addArrayOfType(buffer.blob, 
-                            bufferview.byteOffset + accBoffset, 
-                            accessor.count, 
-                            texcoords, 
-                            accessor.type, 
-                            accessor.componentType);
-                        if (!success) {
-                            qWarning(modelformat) << "There was a problem reading glTF TEXCOORD_1 data for model " << _url;
-                            continue;
-                        }
-                        for (int n = 0; n < texcoords.size(); n = n + 2) {
-                            mesh.texCoords1.push_back(glm::vec2(texcoords[n], texcoords[n + 1]));
-                        }
-                    } else if (key == "JOINTS_0") {
-                        QVector<uint16_t> joints;
-                        success = addArrayOfType(buffer.blob,
-                            bufferview.byteOffset + accBoffset,
-                            accessor.count,
-                            joints,
-                            accessor.type, 
-                            accessor.componentType);
-                        if (!success) {
-                            qWarning(modelformat) << "There was a problem reading glTF JOINTS_0 data for model " << _url;
-                            continue;
-                        }
-                        for (int n = 0; n < joints.size(); n++) {
-                            clusterJoints.push_back(joints[n]);
-                        }
-                    } else if (key == "WEIGHTS_0") {
-                        QVector<float> weights;
-                        success = addArrayOfType(buffer.blob, 
-                            bufferview.byteOffset + accBoffset, 
-                            accessor.count, 
-                            weights,
-                            accessor.type, 
-                            accessor.componentType);
-                        if (!success) {
-                            qWarning(modelformat) << "There was a problem reading glTF WEIGHTS_0 data for model " << _url;
-                            continue;
-                        }
-                        for (int n = 0; n < weights.size(); n++) {
-                            clusterWeights.push_back(weights[n]);
-                        }
-                    }
-                }
-            
+                part.triangleIndices = std::move(data.indices);
+                mesh.vertices = std::move(data.vertices);
+                mesh.normals = std::move(data.normals);
+                mesh.colors = std::move(data.colors);
+                mesh.tangents = std::move(data.tangents);
+                mesh.texCoords = std::move(data.texCoords);
+                mesh.texCoords1 = std::move(data.texCoords1);
+                const QVector<uint16_t>& clusterJoints = data.joints;
+                const QVector<float>& clusterWeights = data.weights;
+
                 // Build weights (adapted from FBXSerializer.cpp)
                 if (hfmModel.hasSkeletonJoints) {
                     int numClusterIndices = clusterJoints.size();
@@ -1398,7 +1326,10 @@ HFMTexture GLTFSerializer::getHFMTexture(const GLTFTexture& texture) {
             int offset = imagesBufferview.byteOffset;
             int length = imagesBufferview.byteLength;
 
-            fbxtex.content = _glbBinary.mid(offset, length);
+            // the binary chunk refers to the GLB document in place, so take a deep copy of the image
+            // that can outlive this serializer
+            hifi::ByteArray image = _glbBinary.mid(offset, length);
+            fbxtex.content = hifi::ByteArray(image.constData(), image.size());
             fbxtex.filename = textureUrl.toEncoded().append(texture.source);
         }
 
@@ -1473,85 +1404,202 @@ void GLTFSerializer::setHFMMaterial(HFMMaterial& fbxmat, const GLTFMaterial& mat
 
 }
 
-template<typename T, typename L>
-bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count,
-                           QVector<L>& outarray, int accessorType) {
-    
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
+namespace {
 
-    int bufferCount = 0;
+int getAccessorComponentCount(int accessorType) {
     switch (accessorType) {
     case GLTFAccessorType::SCALAR:
-        bufferCount = 1;
-        break;
+        return 1;
     case GLTFAccessorType::VEC2:
-        bufferCount = 2;
-        break;
+        return 2;
     case GLTFAccessorType::VEC3:
-        bufferCount = 3;
-        break;
+        return 3;
     case GLTFAccessorType::VEC4:
-        bufferCount = 4;
-        break;
+        return 4;
     case GLTFAccessorType::MAT2:
-        bufferCount = 4;
-        break;
+        return 4;
     case GLTFAccessorType::MAT3:
-        bufferCount = 9;
-        break;
+        return 9;
     case GLTFAccessorType::MAT4:
-        bufferCount = 16;
-        break;
+        return 16;
     default:
+        return 0;
+    }
+}
+
+// checks that count elements of elementSize bytes, spaced byteStride apart (or tightly packed if byteStride is 0),
+// lie within a view of viewSize bytes.  count comes straight from the document, so this has to hold before
+// anything is allocated for the elements
+bool stridedElementsFit(int count, int byteStride, int elementSize, int viewSize) {
+    if (count <= 0 || elementSize <= 0) {
+        return false;
+    }
+
+    qint64 stride = byteStride > 0 ? byteStride : elementSize;
+    if (stride < elementSize) {
+        return false;
+    }
+    qint64 end = (qint64)(count - 1) * stride + elementSize;
+    return end <= viewSize;
+}
+
+// copies count elements of elementSize bytes, spaced byteStride apart in view (or tightly packed if byteStride is 0),
+// to destination, as a single copy when they are tightly packed.  The elements must fit the view.
+void copyStridedElements(const hifi::ByteArray& view, int count, int byteStride, int elementSize, char* destination) {
+    int stride = byteStride > 0 ? byteStride : elementSize;
+    const char* source = view.constData();
+    if (stride == elementSize) {
+        memcpy(destination, source, (size_t)count * elementSize);
+    } else {
+        for (int i = 0; i < count; i++) {
+            memcpy(destination + (size_t)i * elementSize, source + (size_t)i * stride, elementSize);
+        }
+    }
+}
+
+}
+
+template<typename T, typename L>
+bool GLTFSerializer::readArray(const hifi::ByteArray& view, int count, int byteStride,
+                               QVector<L>& outarray, int accessorType) const {
+    int bufferCount = getAccessorComponentCount(accessorType);
+    if (bufferCount == 0) {
         qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-        blobstream.unsetDevice();
         return false;
     }
-    for (int i = 0; i < count; i++) {
-        for (int j = 0; j < bufferCount; j++) {
-            if (!blobstream.atEnd()) {
-                T value;
-                blobstream >> value;
-                outarray.push_back(value);
-            } else {
-                blobstream.unsetDevice();
-                return false;
-            }
+
+    int elementSize = sizeof(T) * bufferCount;
+    if (!stridedElementsFit(count, byteStride, elementSize, view.size())) {
+        qWarning(modelformat) << "glTF accessor of" << count << "elements does not fit its buffer view" << _url;
+        return false;
+    }
+
+    // count * elementSize is now known to be no more than the size of the view
+    int oldSize = outarray.size();
+    if (std::is_same<T, L>::value) {
+        // same component type as we're asked for, copy straight into the output
+        outarray.resize(oldSize + count * bufferCount);
+        copyStridedElements(view, count, byteStride, elementSize, reinterpret_cast<char*>(outarray.data() + oldSize));
+    } else {
+        std::vector<T> values((size_t)count * bufferCount);
+        copyStridedElements(view, count, byteStride, elementSize, reinterpret_cast<char*>(values.data()));
+        outarray.reserve(oldSize + (int)values.size());
+        for (const T& value : values) {
+            outarray.push_back((L)value);
         }
     }
 
-    blobstream.unsetDevice();
     return true;
 }
+
 template<typename T>
-bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
-                                QVector<T>& outarray, int accessorType, int componentType) {
+bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& view, int count, int byteStride,
+                                    QVector<T>& outarray, int accessorType, int componentType) const {
     
     switch (componentType) {
-    case GLTFAccessorComponentType::BYTE: {}
+    case GLTFAccessorComponentType::BYTE: {
+        return readArray<int8_t>(view, count, byteStride, outarray, accessorType);
+    }
     case GLTFAccessorComponentType::UNSIGNED_BYTE: {
-        return readArray<uchar>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<uchar>(view, count, byteStride, outarray, accessorType);
     }
     case GLTFAccessorComponentType::SHORT: {
-        return readArray<short>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<short>(view, count, byteStride, outarray, accessorType);
     }
     case GLTFAccessorComponentType::UNSIGNED_INT: {
-        return readArray<uint>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<uint>(view, count, byteStride, outarray, accessorType);
     }
     case GLTFAccessorComponentType::UNSIGNED_SHORT: {
-        return readArray<ushort>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<ushort>(view, count, byteStride, outarray, accessorType);
     }
     case GLTFAccessorComponentType::FLOAT: {
-        return readArray<float>(bin, byteOffset, count, outarray, accessorType);
+        return readArray<float>(view, count, byteStride, outarray, accessorType);
     }
     }
     return false;
 }
 
+bool GLTFSerializer::getAccessorView(const GLTFAccessor& accessor, hifi::ByteArray& view, int& byteStride) const {
+    if (!accessor.defined.value("bufferView") || accessor.bufferView < 0 || accessor.bufferView >= _file.bufferviews.size()) {
+        return false;
+    }
+
+    const GLTFBufferView& bufferview = _file.bufferviews[accessor.bufferView];
+    if (bufferview.buffer < 0 || bufferview.buffer >= _file.buffers.size() || !bufferview.defined.value("byteLength")) {
+        return false;
+    }
+
+    // the buffer view has to lie within its buffer, and the accessor within its buffer view
+    const hifi::ByteArray& blob = _file.buffers[bufferview.buffer].blob;
+    int accessorOffset = accessor.defined.value("byteOffset") ? accessor.byteOffset : 0;
+    if (bufferview.byteOffset < 0 || bufferview.byteLength < 0 ||
+        (qint64)bufferview.byteOffset + bufferview.byteLength > blob.size() ||
+        accessorOffset < 0 || accessorOffset > bufferview.byteLength) {
+        return false;
+    }
+
+    byteStride = bufferview.defined.value("byteStride") ? bufferview.byteStride : 0;
+    if (byteStride < 0) {
+        return false;
+    }
+
+    view = hifi::ByteArray::fromRawData(blob.constData() + bufferview.byteOffset + accessorOffset,
+                                        bufferview.byteLength - accessorOffset);
+    return true;
+}
+
+template<typename T>
+bool GLTFSerializer::addArrayFromAccessor(const GLTFAccessor& accessor, QVector<T>& outarray) const {
+    hifi::ByteArray view;
+    int byteStride;
+    if (!getAccessorView(accessor, view, byteStride)) {
+        return false;
+    }
+    return addArrayOfType(view, accessor.count, byteStride, outarray, accessor.type, accessor.componentType);
+}
+
+template<typename V>
+bool GLTFSerializer::addVecArrayFromAccessor(const GLTFAccessor& accessor, QVector<V>& outarray) const {
+    // V is one of the tightly packed glm float vectors
+    const int componentCount = (int)(sizeof(V) / sizeof(float));
+
+    if (accessor.componentType == GLTFAccessorComponentType::FLOAT &&
+        getAccessorComponentCount(accessor.type) == componentCount) {
+        // the accessor is laid out exactly like V, copy its elements straight into the output
+        hifi::ByteArray view;
+        int byteStride;
+        if (!getAccessorView(accessor, view, byteStride)) {
+            return false;
+        }
+        if (!stridedElementsFit(accessor.count, byteStride, sizeof(V), view.size())) {
+            qWarning(modelformat) << "glTF accessor of" << accessor.count << "elements does not fit its buffer view" << _url;
+            return false;
+        }
+
+        int oldSize = outarray.size();
+        outarray.resize(oldSize + accessor.count);
+        copyStridedElements(view, accessor.count, byteStride, sizeof(V), reinterpret_cast<char*>(outarray.data() + oldSize));
+        return true;
+    }
+
+    // otherwise convert the components one at a time and assemble them
+    QVector<float> values;
+    if (!addArrayFromAccessor(accessor, values)) {
+        return false;
+    }
+    int accessorComponentCount = getAccessorComponentCount(accessor.type);
+    int copiedComponentCount = std::min(componentCount, accessorComponentCount);
+    outarray.reserve(outarray.size() + values.size() / accessorComponentCount);
+    for (int n = 0; n + accessorComponentCount <= values.size(); n += accessorComponentCount) {
+        V value(0.0f);
+        for (int c = 0; c < copiedComponentCount; c++) {
+            value[c] = values[n + c];
+        }
+        outarray.push_back(value);
+    }
+    return true;
+}
+
 void GLTFSerializer::retriangulate(const QVector<int>& inIndices, const QVector<glm::vec3>& in_vertices,
                                const QVector<glm::vec3>& in_normals, QVector<int>& outIndices, 
                                QVector<glm::vec3>& out_vertices, QVector<glm::vec3>& out_normals) {
@@ -206,6 +206,7 @@ struct GLTFBufferView {
     int buffer; //required
     int byteLength; //required
     int byteOffset { 0 };
+    int byteStride { 0 };
     int target;
     QMap<QString, bool> defined;
     void dump() {
@@ -218,6 +219,9 @@ struct GLTFBufferView {
         if (defined["byteOffset"]) {
             qCDebug(modelformat) << "byteOffset: " << byteOffset;
         }
+        if (defined["byteStride"]) {
+            qCDebug(modelformat) << "byteStride: " << byteStride;
+        }
         if (defined["target"]) {
             qCDebug(modelformat) << "target: " << target;
         }
@@ -722,8 +726,23 @@ public:
 
     HFMModel::Pointer read(const hifi::ByteArray& data, const hifi::VariantHash& mapping, const hifi::URL& url = hifi::URL()) override;
 private:
+    // the vertex data of one mesh primitive, decoded from its accessors ahead of building the hfm::Mesh
+    struct PrimitiveData {
+        bool hasIndices { false };
+        QVector<int> indices;
+        QVector<glm::vec3> vertices;
+        QVector<glm::vec3> normals;
+        QVector<glm::vec3> colors;
+        QVector<glm::vec3> tangents;
+        QVector<glm::vec2> texCoords;
+        QVector<glm::vec2> texCoords1;
+        QVector<uint16_t> joints;
+        QVector<float> weights;
+    };
+
     GLTFFile _file;
     hifi::URL _url;
+    hifi::ByteArray _glbData;
     hifi::ByteArray _glbBinary;
 
     glm::mat4 getModelTransform(const GLTFNode& node);
@@ -731,6 +750,7 @@ private:
     void generateTargetData(int index, float weight, QVector<glm::vec3>& returnVector);
 
     bool buildGeometry(HFMModel& hfmModel, const hifi::VariantHash& mapping, const hifi::URL& url);
+    void decodePrimitive(const GLTFMeshPrimitive& primitive, PrimitiveData& data) const;
     bool parseGLTF(const hifi::ByteArray& data);
     
     bool getStringVal(const QJsonObject& object, const QString& fieldname, 
@@ -780,12 +800,25 @@ private:
     bool readBinary(const QString& url, hifi::ByteArray& outdata);
 
     template<typename T, typename L>
-    bool readArray(const hifi::ByteArray& bin, int byteOffset, int count,
-                   QVector<L>& outarray, int accessorType);
+    bool readArray(const hifi::ByteArray& view, int count, int byteStride,
+                   QVector<L>& outarray, int accessorType) const;
     
     template<typename T>
-    bool addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
-                        QVector<T>& outarray, int accessorType, int componentType);
+    bool addArrayOfType(const hifi::ByteArray& view, int count, int byteStride,
+                        QVector<T>& outarray, int accessorType, int componentType) const;
+
+    // sets view to the bytes of the accessor's buffer view from the accessor's offset on, failing if the
+    // buffer view does not lie within its buffer
+    bool getAccessorView(const GLTFAccessor& accessor, hifi::ByteArray& view, int& byteStride) const;
+
+    // appends the scalar components of an accessor to outarray, converted to T
+    template<typename T>
+    bool addArrayFromAccessor(const GLTFAccessor& accessor, QVector<T>& outarray) const;
+
+    // appends the elements of a float vector accessor (POSITION, NORMAL, TEXCOORD_n) to outarray,
+    // copying them in bulk when the accessor layout matches V
+    template<typename V>
+    bool addVecArrayFromAccessor(const GLTFAccessor& accessor, QVector<V>& outarray) const;
 
     void retriangulate(const QVector<int>& in_indices, const QVector<glm::vec3>& in_vertices, 
                        const QVector<glm::vec3>& in_normals, QVector<int>& out_indices, 
@@ -15,6 +15,7 @@
 #include <bitset>
 
 #include <QMetaType>
+#include <QTemporaryFile>
 #include <QUrl>
 
 #include <functional>
@@ -377,6 +378,41 @@ public:
         friend class Deserializer;
     };
 
+    // Writes every mip assigned to it straight into a KTX file instead of keeping it in memory.
+    // The file is built under a temporary name and only replaces filename once finish() succeeds,
+    // it is removed if the storage goes away before that.
+    class KtxOutputStorage : public Storage {
+    public:
+        KtxOutputStorage(const std::string& filename);
+        ~KtxOutputStorage() override;
+
+        // Lays out and maps the file for everything but the mips of texture, with the face size of each mip level.
+        // A size of 0 leaves the level out of the file.
+        bool open(const Texture& texture, const std::vector<Size>& mipFaceSizes);
+        // Fails unless every face of every laid out mip was assigned
+        bool finish();
+
+        PixelsPointer getMipFace(uint16 level, uint8 face = 0) const override { return PixelsPointer(); }
+        Size getMipFaceSize(uint16 level, uint8 face = 0) const override;
+        bool isMipAvailable(uint16 level, uint8 face = 0) const override;
+        void assignMipData(uint16 level, const storage::StoragePointer& storage) override;
+        void assignMipFaceData(uint16 level, uint8 face, const storage::StoragePointer& storage) override;
+
+        void reset() override { }
+
+    protected:
+        const std::string _filename;
+        QTemporaryFile _file;
+        uint8_t* _mappedData { nullptr };
+
+        struct MipLayout {
+            size_t offset { 0 }; // of the first face, from the start of the file
+            Size faceSize { 0 };
+            std::vector<bool> assignedFaces;
+        };
+        std::vector<MipLayout> _mips;
+    };
+
     uint16 minAvailableMipLevel() const { return _storage->minAvailableMipLevel(); };
 
     static const uint16 MAX_NUM_MIPS = 0;
@@ -546,6 +582,12 @@ public:
     void setKtxBacking(const std::string& filename);
     void setKtxBacking(const cache::FilePointer& cacheEntry);
 
+    // Write the mips assigned from now on straight into a KTX file rather than keeping them, see KtxOutputStorage.
+    // The format, size, usage, sampler, irradiance and source hash of the texture go into the file now and must be final.
+    bool setKtxOutput(const std::string& filename);
+    // Complete the file started by setKtxOutput once every mip has been assigned
+    bool finishKtxOutput();
+
     // Usage is a a set of flags providing Semantic about the usage of the Texture.
     void setUsage(const Usage& usage) { _usage = usage; }
     Usage getUsage() const { return _usage; }
@@ -574,6 +616,9 @@ public:
 
     // Serialize a texture into a KTX file
     static ktx::KTXUniquePointer serialize(const Texture& texture);
+    // Serialize a texture into a KTX file on disk, writing each mip straight into the mapped file
+    // instead of building the whole KTX in memory first
+    static bool serialize(const std::string& filename, const Texture& texture);
 
     static TexturePointer build(const ktx::KTXDescriptor& descriptor);
     static TexturePointer unserialize(const std::string& ktxFile);
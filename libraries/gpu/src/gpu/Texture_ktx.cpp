@@ -13,6 +13,7 @@
 #include "Texture.h"
 
 #include <QtCore/QByteArray>
+#include <QtCore/QFile>
 
 #include <ktx/KTX.h>
 
@@ -22,6 +23,7 @@ using namespace gpu;
 
 using PixelsPointer = Texture::PixelsPointer;
 using KtxStorage = Texture::KtxStorage;
+using KtxOutputStorage = Texture::KtxOutputStorage;
 
 std::vector<std::pair<std::shared_ptr<storage::FileStorage>, std::shared_ptr<std::mutex>>> KtxStorage::_cachedKtxFiles;
 std::mutex KtxStorage::_cachedKtxFilesMutex;
@@ -341,21 +343,19 @@ void Texture::setKtxBacking(const cache::FilePointer& cacheEntry) {
 }
 
 
-ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
-    ktx::Header header;
-
+static bool evalKTXHeader(const Texture& texture, ktx::Header& header, uint32_t& numFaces) {
     // From texture format to ktx format description
     auto texelFormat = texture.getTexelFormat();
     auto mipFormat = texture.getStoredMipFormat();
 
     if (!Texture::evalKTXFormat(mipFormat, texelFormat, header)) {
-        return nullptr;
+        return false;
     }
 
     // Set Dimensions
-    uint32_t numFaces = 1;
+    numFaces = 1;
     switch (texture.getType()) {
-    case TEX_1D: {
+    case Texture::TEX_1D: {
             if (texture.isArray()) {
                 header.set1DArray(texture.getWidth(), texture.getNumSlices());
             } else {
@@ -363,7 +363,7 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
             }
             break;
         }
-    case TEX_2D: {
+    case Texture::TEX_2D: {
             if (texture.isArray()) {
                 header.set2DArray(texture.getWidth(), texture.getHeight(), texture.getNumSlices());
             } else {
@@ -371,7 +371,7 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
             }
             break;
         }
-    case TEX_3D: {
+    case Texture::TEX_3D: {
             if (texture.isArray()) {
                 header.set3DArray(texture.getWidth(), texture.getHeight(), texture.getDepth(), texture.getNumSlices());
             } else {
@@ -379,7 +379,7 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
             }
             break;
         }
-    case TEX_CUBE: {
+    case Texture::TEX_CUBE: {
             if (texture.isArray()) {
                 header.setCubeArray(texture.getWidth(), texture.getHeight(), texture.getNumSlices());
             } else {
@@ -389,31 +389,15 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
             break;
         }
     default:
-        return nullptr;
+        return false;
     }
 
     // Number level of mips coming
     header.numberOfMipmapLevels = texture.getNumMips();
+    return true;
+}
 
-    ktx::Images images;
-    uint32_t imageOffset = 0;
-    for (uint32_t level = 0; level < header.numberOfMipmapLevels; level++) {
-        auto mip = texture.accessStoredMipFace(level);
-        if (mip) {
-            if (numFaces == 1) {
-                images.emplace_back(ktx::Image(imageOffset, (uint32_t)mip->getSize(), 0, mip->readData()));
-            } else {
-                ktx::Image::FaceBytes cubeFaces(Texture::CUBE_FACE_COUNT);
-                cubeFaces[0] = mip->readData();
-                for (uint32_t face = 1; face < Texture::CUBE_FACE_COUNT; face++) {
-                    cubeFaces[face] = texture.accessStoredMipFace(level, face)->readData();
-                }
-                images.emplace_back(ktx::Image(imageOffset, (uint32_t)mip->getSize(), 0, cubeFaces));
-            }
-            imageOffset += static_cast<uint32_t>(mip->getSize()) + ktx::IMAGE_SIZE_WIDTH;
-        }
-    }
-
+static ktx::KeyValues evalKTXKeyValues(const Texture& texture) {
     GPUKTXPayload gpuKeyval;
     gpuKeyval._samplerDesc = texture.getSampler().getDesc();
     gpuKeyval._usage = texture.getUsage();
@@ -443,6 +427,37 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
         keyValues.emplace_back(SOURCE_HASH_KEY, static_cast<uint32>(binaryHash.size()), (ktx::Byte*) binaryHash.data());
     }
 
+    return keyValues;
+}
+
+ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
+    ktx::Header header;
+    uint32_t numFaces = 1;
+    if (!evalKTXHeader(texture, header, numFaces)) {
+        return nullptr;
+    }
+
+    ktx::Images images;
+    uint32_t imageOffset = 0;
+    for (uint32_t level = 0; level < header.numberOfMipmapLevels; level++) {
+        auto mip = texture.accessStoredMipFace(level);
+        if (mip) {
+            if (numFaces == 1) {
+                images.emplace_back(ktx::Image(imageOffset, (uint32_t)mip->getSize(), 0, mip->readData()));
+            } else {
+                ktx::Image::FaceBytes cubeFaces(Texture::CUBE_FACE_COUNT);
+                cubeFaces[0] = mip->readData();
+                for (uint32_t face = 1; face < Texture::CUBE_FACE_COUNT; face++) {
+                    cubeFaces[face] = texture.accessStoredMipFace(level, face)->readData();
+                }
+                images.emplace_back(ktx::Image(imageOffset, (uint32_t)mip->getSize(), 0, cubeFaces));
+            }
+            imageOffset += static_cast<uint32_t>(mip->getSize()) + ktx::IMAGE_SIZE_WIDTH;
+        }
+    }
+
+    auto keyValues = evalKTXKeyValues(texture);
+
     auto ktxBuffer = ktx::KTX::create(header, images, keyValues);
 #if 0
     auto expectedMipCount = texture.evalNumMips();
@@ -473,6 +488,187 @@ ktx::KTXUniquePointer Texture::serialize(const Texture& texture) {
     return ktxBuffer;
 }
 
+KtxOutputStorage::KtxOutputStorage(const std::string& filename) :
+    _filename(filename),
+    _file(QString::fromStdString(filename) + ".XXXXXX") {
+}
+
+KtxOutputStorage::~KtxOutputStorage() {
+    // an unfinished file is removed along with _file
+    if (_mappedData) {
+        _file.unmap(_mappedData);
+    }
+}
+
+bool KtxOutputStorage::open(const Texture& texture, const std::vector<Size>& mipFaceSizes) {
+    ktx::Header header;
+    uint32_t numFaces = 1;
+    if (!evalKTXHeader(texture, header, numFaces)) {
+        return false;
+    }
+    auto keyValues = evalKTXKeyValues(texture);
+
+    // The size of every mip is known before touching any texel, so the whole file can be laid out and allocated up front
+    ktx::ImageDescriptors descriptors;
+    _mips.assign(header.numberOfMipmapLevels, MipLayout());
+    size_t imageOffset = 0;
+    for (uint16 level = 0; level < header.numberOfMipmapLevels && level < mipFaceSizes.size(); level++) {
+        auto faceSize = (uint32_t)mipFaceSizes[level];
+        if (faceSize == 0) {
+            continue;
+        }
+        ktx::ImageHeader imageHeader { numFaces == Texture::CUBE_FACE_COUNT, imageOffset, faceSize, ktx::evalPadding(faceSize * numFaces) };
+        descriptors.emplace_back(imageHeader, ktx::ImageHeader::FaceOffsets(numFaces, 0));
+
+        auto& mip = _mips[level];
+        mip.offset = imageOffset + ktx::IMAGE_SIZE_WIDTH;
+        mip.faceSize = faceSize;
+        mip.assignedFaces.assign(numFaces, false);
+        imageOffset += ktx::IMAGE_SIZE_WIDTH + ktx::evalPaddedSize(imageHeader._imageSize);
+    }
+
+    const size_t storageSize = ktx::KTX::evalStorageSize(header, descriptors, keyValues);
+    const size_t keyValuesSize = ktx::KeyValue::serializedKeyValuesByteSize(keyValues);
+
+    if (!_file.open() || !_file.resize(storageSize)) {
+        qCWarning(gpulogging) << "Could not allocate KTX file" << _file.fileName() << _file.errorString();
+        return false;
+    }
+    _mappedData = _file.map(0, storageSize);
+    if (!_mappedData) {
+        qCWarning(gpulogging) << "Could not map KTX file" << _file.fileName() << _file.errorString();
+        return false;
+    }
+
+    auto destHeader = reinterpret_cast<ktx::Header*>(_mappedData);
+    memcpy(destHeader, &header, sizeof(ktx::Header));
+    destHeader->bytesOfKeyValueData = keyValues.empty() ? 0 :
+        (uint32_t)ktx::KTX::writeKeyValues(_mappedData + sizeof(ktx::Header), keyValuesSize, keyValues);
+
+    const size_t imagesOffset = sizeof(ktx::Header) + destHeader->bytesOfKeyValueData;
+    for (auto& mip : _mips) {
+        if (mip.faceSize == 0) {
+            continue;
+        }
+        mip.offset += imagesOffset;
+        // the imageSize written in the ktx is the FACE size
+        *reinterpret_cast<uint32_t*>(_mappedData + mip.offset - ktx::IMAGE_SIZE_WIDTH) = (uint32_t)mip.faceSize;
+    }
+    return true;
+}
+
+bool KtxOutputStorage::finish() {
+    if (!_mappedData) {
+        return false;
+    }
+    for (const auto& mip : _mips) {
+        if (std::find(mip.assignedFaces.begin(), mip.assignedFaces.end(), false) != mip.assignedFaces.end()) {
+            qCWarning(gpulogging) << "Missing mips in KTX file" << QString::fromStdString(_filename);
+            return false;
+        }
+    }
+
+    _file.unmap(_mappedData);
+    _mappedData = nullptr;
+    _file.close();
+
+    // QTemporaryFile::rename never replaces an existing file
+    auto filename = QString::fromStdString(_filename);
+    _file.setAutoRemove(false);
+    if ((QFile::exists(filename) && !QFile::remove(filename)) || !_file.rename(filename)) {
+        qCWarning(gpulogging) << "Could not write KTX file" << filename << _file.errorString();
+        _file.remove();
+        return false;
+    }
+    return true;
+}
+
+Size KtxOutputStorage::getMipFaceSize(uint16 level, uint8 face) const {
+    return level < _mips.size() ? _mips[level].faceSize : 0;
+}
+
+bool KtxOutputStorage::isMipAvailable(uint16 level, uint8 face) const {
+    return level < _mips.size() && face < _mips[level].assignedFaces.size() && _mips[level].assignedFaces[face];
+}
+
+void KtxOutputStorage::assignMipData(uint16 level, const storage::StoragePointer& storage) {
+    if (level >= _mips.size() || _mips[level].assignedFaces.empty()) {
+        qCWarning(gpulogging) << "Invalid level to be written to KTX file" << level;
+        return;
+    }
+
+    // The bytes assigned here contain all the faces of the mip, see MemoryStorage::assignMipData
+    auto faceCount = (uint8)_mips[level].assignedFaces.size();
+    auto sizePerFace = storage->size() / faceCount;
+    if (sizePerFace == 0) {
+        return;
+    }
+    for (uint8 face = 0; face < faceCount; face++) {
+        assignMipFaceData(level, face, storage->createView(sizePerFace, face * sizePerFace));
+    }
+}
+
+void KtxOutputStorage::assignMipFaceData(uint16 level, uint8 face, const storage::StoragePointer& storage) {
+    if (!_mappedData || level >= _mips.size() || face >= _mips[level].assignedFaces.size()) {
+        qCWarning(gpulogging) << "Invalid face to be written to KTX file, level" << level << "face" << face;
+        return;
+    }
+
+    // Sources can be larger than the face, e.g. QImage pads its lines
+    auto& mip = _mips[level];
+    memcpy(_mappedData + mip.offset + face * mip.faceSize, storage->data(), std::min<size_t>(storage->size(), mip.faceSize));
+    mip.assignedFaces[face] = true;
+    bumpStamp();
+}
+
+bool Texture::setKtxOutput(const std::string& filename) {
+    std::vector<Size> mipFaceSizes;
+    for (uint16 level = 0; level < getNumMips(); level++) {
+        mipFaceSizes.push_back(evalStoredMipFaceSize(level, getStoredMipFormat()));
+    }
+
+    auto output = new KtxOutputStorage(filename);
+    std::unique_ptr<Storage> newStorage(output);
+    newStorage->setFormat(getStoredMipFormat());
+    newStorage->assignTexture(this);
+    if (!output->open(*this, mipFaceSizes)) {
+        return false;
+    }
+    setStorage(newStorage);
+    return true;
+}
+
+bool Texture::finishKtxOutput() {
+    auto output = dynamic_cast<KtxOutputStorage*>(_storage.get());
+    return output && output->finish();
+}
+
+bool Texture::serialize(const std::string& filename, const Texture& texture) {
+    std::vector<Size> mipFaceSizes;
+    for (uint16 level = 0; level < texture.getNumMips(); level++) {
+        mipFaceSizes.push_back(texture.isStoredMipFaceAvailable(level) ? texture.getStoredMipFaceSize(level) : 0);
+    }
+
+    KtxOutputStorage output(filename);
+    if (!output.open(texture, mipFaceSizes)) {
+        return false;
+    }
+
+    // Only one face of one mip is held outside of the texture at any time
+    for (uint16 level = 0; level < mipFaceSizes.size(); level++) {
+        if (mipFaceSizes[level] == 0) {
+            continue;
+        }
+        for (uint8 face = 0; face < texture.getNumFaces(); face++) {
+            auto mip = texture.accessStoredMipFace(level, face);
+            if (mip) {
+                output.assignMipFaceData(level, face, mip);
+            }
+        }
+    }
+    return output.finish();
+}
+
 TexturePointer Texture::build(const ktx::KTXDescriptor& descriptor) {
     Format mipFormat = Format::COLOR_BGRA_32;
     Format texelFormat = Format::COLOR_SRGBA_32;
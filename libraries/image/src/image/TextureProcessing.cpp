@@ -23,6 +23,7 @@
 #include <Profile.h>
 #include <StatTracker.h>
 #include <GLMHelpers.h>
+#include <TBBHelpers.h>
 
 #include "TGAReader.h"
 #if !defined(Q_OS_ANDROID)
@@ -135,63 +136,75 @@ TextureUsage::TextureLoader TextureUsage::getTextureLoaderForType(Type type) {
 }
 
 gpu::TexturePointer TextureUsage::createStrict2DTextureFromImage(Image&& srcImage, const std::string& srcImageName,
-                                                                 bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return process2DTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, true, abortProcessing);
+                                                                 bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                                 const TextureOutput& output) {
+    return process2DTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, true, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::create2DTextureFromImage(Image&& srcImage, const std::string& srcImageName,
-                                                           bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return process2DTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing);
+                                                           bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                           const TextureOutput& output) {
+    return process2DTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::createAlbedoTextureFromImage(Image&& srcImage, const std::string& srcImageName,
-                                                               bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return process2DTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing);
+                                                               bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                               const TextureOutput& output) {
+    return process2DTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::createEmissiveTextureFromImage(Image&& srcImage, const std::string& srcImageName,
-                                                                 bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return process2DTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing);
+                                                                 bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                                 const TextureOutput& output) {
+    return process2DTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::createLightmapTextureFromImage(Image&& srcImage, const std::string& srcImageName,
-                                                                 bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return process2DTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing);
+                                                                 bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                                 const TextureOutput& output) {
+    return process2DTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::createNormalTextureFromNormalImage(Image&& srcImage, const std::string& srcImageName,
-                                                                     bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return process2DTextureNormalMapFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing);
+                                                                     bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                                     const TextureOutput& output) {
+    return process2DTextureNormalMapFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::createNormalTextureFromBumpImage(Image&& srcImage, const std::string& srcImageName,
-                                                                   bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return process2DTextureNormalMapFromImage(std::move(srcImage), srcImageName, compress, target, true, abortProcessing);
+                                                                   bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                                   const TextureOutput& output) {
+    return process2DTextureNormalMapFromImage(std::move(srcImage), srcImageName, compress, target, true, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::createRoughnessTextureFromImage(Image&& srcImage, const std::string& srcImageName,
-                                                                  bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return process2DTextureGrayscaleFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing);
+                                                                  bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                                  const TextureOutput& output) {
+    return process2DTextureGrayscaleFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::createRoughnessTextureFromGlossImage(Image&& srcImage, const std::string& srcImageName,
-                                                                       bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return process2DTextureGrayscaleFromImage(std::move(srcImage), srcImageName, compress, target, true, abortProcessing);
+                                                                       bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                                       const TextureOutput& output) {
+    return process2DTextureGrayscaleFromImage(std::move(srcImage), srcImageName, compress, target, true, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::createMetallicTextureFromImage(Image&& srcImage, const std::string& srcImageName,
-                                                                 bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return process2DTextureGrayscaleFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing);
+                                                                 bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                                 const TextureOutput& output) {
+    return process2DTextureGrayscaleFromImage(std::move(srcImage), srcImageName, compress, target, false, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::createCubeTextureFromImage(Image&& srcImage, const std::string& srcImageName,
-                                                             bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return processCubeTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, CUBE_DEFAULT, abortProcessing);
+                                                             bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                             const TextureOutput& output) {
+    return processCubeTextureColorFromImage(std::move(srcImage), srcImageName, compress, target, CUBE_DEFAULT, abortProcessing, output);
 }
 
 gpu::TexturePointer TextureUsage::createAmbientCubeTextureAndIrradianceFromImage(Image&& image, const std::string& srcImageName,
-                                                                        bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing) {
-    return processCubeTextureColorFromImage(std::move(image), srcImageName, compress, target, CUBE_GENERATE_IRRADIANCE | CUBE_GGX_CONVOLVE, abortProcessing);
+                                                                        bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                                        const TextureOutput& output) {
+    return processCubeTextureColorFromImage(std::move(image), srcImageName, compress, target, CUBE_GENERATE_IRRADIANCE | CUBE_GGX_CONVOLVE, abortProcessing, output);
 }
 
 static float denormalize(float value, const float minValue) {
@@ -340,7 +353,8 @@ void mapToRedChannel(Image& image, ColorChannel sourceChannel) {
 
 gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::string& filename, ColorChannel sourceChannel,
                                  int maxNumPixels, TextureUsage::Type textureType,
-                                 bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing) {
+                                 bool compress, BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                 const TextureUsage::TextureOutput& output) {
 
     Image image = processRawImageData(*content.get(), filename);
     // Texture content can take up a lot of memory. Here we release our ownership of that content
@@ -376,7 +390,7 @@ gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::
     }
 
     auto loader = TextureUsage::getTextureLoaderForType(textureType);
-    auto texture = loader(std::move(image), filename, compress, target, abortProcessing);
+    auto texture = loader(std::move(image), filename, compress, target, abortProcessing, output);
 
     return texture;
 }
@@ -501,63 +515,61 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
 };
 
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
+        // nvtt splits each mip into independent tiles of blocks, spread them over the shared pool
+        tbb::parallel_for(0, count, [&](int i) {
             if (!_abortProcessing.load()) {
                 task(context, i);
-            } else {
-                break;
             }
-        }
+        });
     }
 };
 #endif
 
 void convertToFloatFromPacked(const unsigned char* source, int width, int height, size_t srcLineByteStride, gpu::Element sourceFormat,
                               glm::vec4* output, size_t outputLinePixelStride) {
-    glm::vec4* outputIt;
     auto unpackFunc = getHDRUnpackingFunction(sourceFormat);
 
-    outputLinePixelStride -= width;
-    outputIt = output;
-    for (auto lineNb = 0; lineNb < height; lineNb++) {
-        const uint32* srcPixelIt = reinterpret_cast<const uint32*>(source + lineNb * srcLineByteStride);
-        const uint32* srcPixelEnd = srcPixelIt + width;
-
-        while (srcPixelIt < srcPixelEnd) {
-            *outputIt = glm::vec4(unpackFunc(*srcPixelIt), 1.0f);
-            ++srcPixelIt;
-            ++outputIt;
+    // lines are independent, so they're converted in parallel
+    tbb::parallel_for(tbb::blocked_range<int>(0, height), [&](const tbb::blocked_range<int>& lines) {
+        for (auto lineNb = lines.begin(); lineNb < lines.end(); lineNb++) {
+            const uint32* srcPixelIt = reinterpret_cast<const uint32*>(source + lineNb * srcLineByteStride);
+            const uint32* srcPixelEnd = srcPixelIt + width;
+            glm::vec4* outputIt = output + lineNb * outputLinePixelStride;
+
+            while (srcPixelIt < srcPixelEnd) {
+                *outputIt = glm::vec4(unpackFunc(*srcPixelIt), 1.0f);
+                ++srcPixelIt;
+                ++outputIt;
+            }
         }
-        outputIt += outputLinePixelStride;
-    }
+    });
 }
 
 void convertToPackedFromFloat(unsigned char* output, int width, int height, size_t outputLineByteStride, gpu::Element outputFormat,
                               const glm::vec4* source, size_t srcLinePixelStride) {
-    const glm::vec4* sourceIt;
     auto packFunc = getHDRPackingFunction(outputFormat);
 
-    srcLinePixelStride -= width;
-    sourceIt = source;
-    for (auto lineNb = 0; lineNb < height; lineNb++) {
-        uint32* outPixelIt = reinterpret_cast<uint32*>(output + lineNb * outputLineByteStride);
-        uint32* outPixelEnd = outPixelIt + width;
+    tbb::parallel_for(tbb::blocked_range<int>(0, height), [&](const tbb::blocked_range<int>& lines) {
+        for (auto lineNb = lines.begin(); lineNb < lines.end(); lineNb++) {
+            uint32* outPixelIt = reinterpret_cast<uint32*>(output + lineNb * outputLineByteStride);
+            uint32* outPixelEnd = outPixelIt + width;
+            const glm::vec4* sourceIt = source + lineNb * srcLinePixelStride;
 
-        while (outPixelIt < outPixelEnd) {
-            *outPixelIt = packFunc(*sourceIt);
-            ++outPixelIt;
-            ++sourceIt;
+            while (outPixelIt < outPixelEnd) {
+                *outPixelIt = packFunc(*sourceIt);
+                ++outPixelIt;
+                ++sourceIt;
+            }
         }
-        sourceIt += srcLinePixelStride;
-    }
+    });
 }
 
 nvtt::OutputHandler* getNVTTCompressionOutputHandler(gpu::Texture* outputTexture, int face, nvtt::CompressionOptions& compressionOptions) {
@@ -622,8 +634,9 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
+    // each mip is filtered from the previous one, so they're compressed one at a time as they're built,
+    // with the dispatcher spreading the tiles of each over the pool
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     context.setTaskDispatcher(&dispatcher);
 
     context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
@@ -757,8 +770,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         MyErrorHandler errorHandler;
         outputOptions.setErrorHandler(&errorHandler);
 
-        SequentialTaskDispatcher dispatcher(abortProcessing);
-        nvtt::Compressor context;
+        ParallelTaskDispatcher dispatcher(abortProcessing);
+        nvtt::Context context;
+        context.setTaskDispatcher(&dispatcher);
 
         context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
         if (buildMips) {
@@ -827,6 +841,8 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
                 } else {
                     texture->assignStoredMip(i + baseMipLevel, mipMaps[i].uiEncodingBitsBytes, static_cast<const gpu::Byte*>(mipMaps[i].paucEncodingBits.get()));
                 }
+                // the texture holds its own copy, or has already written it out
+                mipMaps[i].paucEncodingBits.reset();
             }
         }
 
@@ -887,7 +903,8 @@ void processTextureAlpha(const Image& srcImage, bool& validAlpha, bool& alphaAsM
 }
 
 gpu::TexturePointer TextureUsage::process2DTextureColorFromImage(Image&& srcImage, const std::string& srcImageName, bool compress,
-                                                                 BackendTarget target, bool isStrict, const std::atomic<bool>& abortProcessing) {
+                                                                 BackendTarget target, bool isStrict, const std::atomic<bool>& abortProcessing,
+                                                                 const TextureOutput& output) {
     PROFILE_RANGE(resource_parse, "process2DTextureColorFromImage");
     Image image = processSourceImage(std::move(srcImage), false, target);
 
@@ -945,7 +962,14 @@ gpu::TexturePointer TextureUsage::process2DTextureColorFromImage(Image&& srcImag
         }
         theTexture->setUsage(usage.build());
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.getByteCount(), image.getBits());
+        if (output) {
+            // only the converted mips go to the output, never a placeholder for mip 0
+            if (!output(*theTexture)) {
+                return nullptr;
+            }
+        } else {
+            theTexture->assignStoredMip(0, image.getByteCount(), image.getBits());
+        }
         convertToTextureWithMips(theTexture.get(), std::move(image), target, abortProcessing);
     }
 
@@ -1029,7 +1053,8 @@ Image processBumpMap(Image&& image) {
 
 gpu::TexturePointer TextureUsage::process2DTextureNormalMapFromImage(Image&& srcImage, const std::string& srcImageName,
                                                                      bool compress, BackendTarget target, bool isBumpMap,
-                                                                     const std::atomic<bool>& abortProcessing) {
+                                                                     const std::atomic<bool>& abortProcessing,
+                                                                     const TextureOutput& output) {
     PROFILE_RANGE(resource_parse, "process2DTextureNormalMapFromImage");
     Image image = processSourceImage(std::move(srcImage), false, target);
 
@@ -1060,7 +1085,14 @@ gpu::TexturePointer TextureUsage::process2DTextureNormalMapFromImage(Image&& src
         theTexture = gpu::Texture::create2D(formatGPU, image.getWidth(), image.getHeight(), gpu::Texture::MAX_NUM_MIPS, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR));
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.getByteCount(), image.getBits());
+        if (output) {
+            // only the converted mips go to the output, never a placeholder for mip 0
+            if (!output(*theTexture)) {
+                return nullptr;
+            }
+        } else {
+            theTexture->assignStoredMip(0, image.getByteCount(), image.getBits());
+        }
         convertToTextureWithMips(theTexture.get(), std::move(image), target, abortProcessing);
     }
 
@@ -1069,7 +1101,8 @@ gpu::TexturePointer TextureUsage::process2DTextureNormalMapFromImage(Image&& src
 
 gpu::TexturePointer TextureUsage::process2DTextureGrayscaleFromImage(Image&& srcImage, const std::string& srcImageName,
                                                                      bool compress, BackendTarget target, bool isInvertedPixels,
-                                                                     const std::atomic<bool>& abortProcessing) {
+                                                                     const std::atomic<bool>& abortProcessing,
+                                                                     const TextureOutput& output) {
     PROFILE_RANGE(resource_parse, "process2DTextureGrayscaleFromImage");
     Image image = processSourceImage(std::move(srcImage), false, target);
 
@@ -1100,7 +1133,14 @@ gpu::TexturePointer TextureUsage::process2DTextureGrayscaleFromImage(Image&& src
         theTexture = gpu::Texture::create2D(formatGPU, image.getWidth(), image.getHeight(), gpu::Texture::MAX_NUM_MIPS, gpu::Sampler(gpu::Sampler::FILTER_MIN_MAG_MIP_LINEAR));
         theTexture->setSource(srcImageName);
         theTexture->setStoredMipFormat(formatMip);
-        theTexture->assignStoredMip(0, image.getByteCount(), image.getBits());
+        if (output) {
+            // only the converted mips go to the output, never a placeholder for mip 0
+            if (!output(*theTexture)) {
+                return nullptr;
+            }
+        } else {
+            theTexture->assignStoredMip(0, image.getByteCount(), image.getBits());
+        }
         convertToTextureWithMips(theTexture.get(), std::move(image), target, abortProcessing);
     }
 
@@ -1498,7 +1538,8 @@ void convolveForGGX(const std::vector<Image>& faces, gpu::Texture* texture, Back
 
 gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcImage, const std::string& srcImageName,
                                                                    bool compress, BackendTarget target, int options,
-                                                                   const std::atomic<bool>& abortProcessing) {
+                                                                   const std::atomic<bool>& abortProcessing,
+                                                                   const TextureOutput& output) {
     PROFILE_RANGE(resource_parse, "processCubeTextureColorFromImage");
 
     // Take a local copy to force move construction
@@ -1594,6 +1635,10 @@ gpu::TexturePointer TextureUsage::processCubeTextureColorFromImage(Image&& srcIm
             theTexture->overrideIrradiance(irradiance);
         }
         
+        if (output && !output(*theTexture)) {
+            return nullptr;
+        }
+
         if (options & CUBE_GGX_CONVOLVE) {
             // Performs and convolution AND mip map generation
             convolveForGGX(faces, theTexture.get(), target, abortProcessing);
@@ -75,39 +75,59 @@ enum Type {
     UNUSED_TEXTURE
 };
 
-using TextureLoader = std::function<gpu::TexturePointer(Image&&, const std::string&, bool, gpu::BackendTarget, const std::atomic<bool>&)>;
+// Called on a texture once everything but its mips is set, before the first of them is produced, so that they can be
+// sent elsewhere as they are compressed instead of being kept, e.g. with gpu::Texture::setKtxOutput.
+// Processing fails if it returns false.
+using TextureOutput = std::function<bool(gpu::Texture& texture)>;
+
+using TextureLoader = std::function<gpu::TexturePointer(Image&&, const std::string&, bool, gpu::BackendTarget, const std::atomic<bool>&, const TextureOutput&)>;
 TextureLoader getTextureLoaderForType(Type type);
 
 gpu::TexturePointer create2DTextureFromImage(Image&& image, const std::string& srcImageName,
-                                             bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                             bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                             const TextureOutput& output);
 gpu::TexturePointer createStrict2DTextureFromImage(Image&& image, const std::string& srcImageName,
-                                                   bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                                   bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                   const TextureOutput& output);
 gpu::TexturePointer createAlbedoTextureFromImage(Image&& image, const std::string& srcImageName,
-                                                 bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                                 bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                 const TextureOutput& output);
 gpu::TexturePointer createEmissiveTextureFromImage(Image&& image, const std::string& srcImageName,
-                                                   bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                                   bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                   const TextureOutput& output);
 gpu::TexturePointer createNormalTextureFromNormalImage(Image&& image, const std::string& srcImageName,
-                                                       bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                                       bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                       const TextureOutput& output);
 gpu::TexturePointer createNormalTextureFromBumpImage(Image&& image, const std::string& srcImageName,
-                                                     bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                                     bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                     const TextureOutput& output);
 gpu::TexturePointer createRoughnessTextureFromImage(Image&& image, const std::string& srcImageName,
-                                                    bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                                    bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                    const TextureOutput& output);
 gpu::TexturePointer createRoughnessTextureFromGlossImage(Image&& image, const std::string& srcImageName,
-                                                         bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                                         bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                         const TextureOutput& output);
 gpu::TexturePointer createMetallicTextureFromImage(Image&& image, const std::string& srcImageName,
-                                                   bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                                   bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                   const TextureOutput& output);
 gpu::TexturePointer createCubeTextureFromImage(Image&& image, const std::string& srcImageName,
-                                               bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                               bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                               const TextureOutput& output);
 gpu::TexturePointer createAmbientCubeTextureAndIrradianceFromImage(Image&& image, const std::string& srcImageName,
-                                                                   bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing);
+                                                                   bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                                   const TextureOutput& output);
 gpu::TexturePointer createLightmapTextureFromImage(Image&& image, const std::string& srcImageName,
-                                                   bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing); 
+                                                   bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing,
+                                                   const TextureOutput& output);
 gpu::TexturePointer process2DTextureColorFromImage(Image&& srcImage, const std::string& srcImageName, bool compress,
-                                                   gpu::BackendTarget target, bool isStrict, const std::atomic<bool>& abortProcessing);
+                                                   gpu::BackendTarget target, bool isStrict, const std::atomic<bool>& abortProcessing,
+                                                   const TextureOutput& output);
 gpu::TexturePointer process2DTextureNormalMapFromImage(Image&& srcImage, const std::string& srcImageName, bool compress,
-                                                       gpu::BackendTarget target, bool isBumpMap, const std::atomic<bool>& abortProcessing);
+                                                       gpu::BackendTarget target, bool isBumpMap, const std::atomic<bool>& abortProcessing,
+                                                       const TextureOutput& output);
 gpu::TexturePointer process2DTextureGrayscaleFromImage(Image&& srcImage, const std::string& srcImageName, bool compress,
-                                                       gpu::BackendTarget target, bool isInvertedPixels, const std::atomic<bool>& abortProcessing);
+                                                       gpu::BackendTarget target, bool isInvertedPixels, const std::atomic<bool>& abortProcessing,
+                                                       const TextureOutput& output);
 
 enum CubeTextureOptions {
     CUBE_DEFAULT = 0x0,
@@ -115,14 +135,16 @@ enum CubeTextureOptions {
     CUBE_GGX_CONVOLVE = 0x2
 };
 gpu::TexturePointer processCubeTextureColorFromImage(Image&& srcImage, const std::string& srcImageName, bool compress,
-                                                     gpu::BackendTarget target, int option, const std::atomic<bool>& abortProcessing);
+                                                     gpu::BackendTarget target, int option, const std::atomic<bool>& abortProcessing,
+                                                     const TextureOutput& output);
 } // namespace TextureUsage
 
 const QStringList getSupportedFormats();
 
 gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::string& url, ColorChannel sourceChannel,
                                  int maxNumPixels, TextureUsage::Type textureType,
-                                 bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false);
+                                 bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false,
+                                 const TextureUsage::TextureOutput& output = TextureUsage::TextureOutput());
 
 void convertToTextureWithMips(gpu::Texture* texture, Image&& image, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false, int face = -1);
 void convertToTexture(gpu::Texture* texture, Image&& image, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false, int face = -1, int mipLevel = 0);
@@ -11,16 +11,14 @@
 
 #include "TextureCache.h"
 
+#include <memory>
 #include <mutex>
 
-#include <QtConcurrent/QtConcurrentRun>
-
 #include <QCryptographicHash>
 #include <QImageReader>
-#include <QRunnable>
-#include <QThreadPool>
 #include <QNetworkReply>
 #include <QPainter>
+#include <QThread>
 #include <QUrlQuery>
 
 #if DEBUG_DUMP_TEXTURE_LOADS
@@ -326,7 +324,7 @@ gpu::TexturePointer TextureCache::getImageTexture(const QString& path, image::Te
 #endif
     auto target = getBackendTarget();
 
-    return gpu::TexturePointer(loader(std::move(image), path.toStdString(), shouldCompress, target, false));
+    return gpu::TexturePointer(loader(std::move(image), path.toStdString(), shouldCompress, target, false, image::TextureUsage::TextureOutput()));
 }
 
 QSharedPointer<Resource> TextureCache::createResource(const QUrl& url) {
@@ -455,12 +453,12 @@ gpu::TexturePointer NetworkTexture::getFallbackTexture() const {
     return getFallbackTextureForType(_type);
 }
 
-class ImageReader : public QRunnable {
+class ImageReader {
 public:
     ImageReader(const QWeakPointer<Resource>& resource, const QUrl& url,
                 const QByteArray& data, size_t extraHash, int maxNumPixels,
                 image::ColorChannel sourceChannel);
-    void run() override final;
+    void run();
     void read();
 
 private:
@@ -499,7 +497,7 @@ void NetworkTexture::makeRequest() {
 
     if (isLocalUrl(_activeUrl)) {
         auto self = _self;
-        QtConcurrent::run(QThreadPool::globalInstance(), [self] {
+        scheduleDecode(ResourceDecodeScheduler::Type::Texture, [self] {
             auto resource = self.lock();
             if (!resource) {
                 return;
@@ -797,11 +795,8 @@ void NetworkTexture::ktxMipRequestFinished() {
             auto data = _ktxMipRequest->getData();
             auto mipLevel = _ktxMipLevelRangeInFlight.first;
             auto texture = _textureSource->getGPUTexture();
-            DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture] {
+            scheduleDecode(ResourceDecodeScheduler::Type::Texture, [self, data, mipLevel, url, texture] {
                 PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Mip Data", 0xffff0000, 0, { { "url", url.toString() } });
-                DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
-                CounterStat counter("Processing");
 
                 auto originalPriority = QThread::currentThread()->priority();
                 if (originalPriority == QThread::InheritPriority) {
@@ -865,11 +860,8 @@ void NetworkTexture::handleFinishedInitialLoad() {
 
     auto self = _self;
     auto url = _url;
-    DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-    QtConcurrent::run(QThreadPool::globalInstance(), [self, ktxHeaderData, ktxHighMipData, url] {
+    scheduleDecode(ResourceDecodeScheduler::Type::Texture, [self, ktxHeaderData, ktxHighMipData, url] {
         PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Initial Data", 0xffff0000, 0, { { "url", url.toString() } });
-        DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
-        CounterStat counter("Processing");
 
         auto originalPriority = QThread::currentThread()->priority();
         if (originalPriority == QThread::InheritPriority) {
@@ -1101,7 +1093,10 @@ void NetworkTexture::loadTextureContent(const QByteArray& content) {
         return;
     }
 
-    QThreadPool::globalInstance()->start(new ImageReader(_self, _url, content, _extraHash, _maxNumPixels, _sourceChannel));
+    auto reader = std::make_shared<ImageReader>(_self, _url, content, _extraHash, _maxNumPixels, _sourceChannel);
+    scheduleDecode(ResourceDecodeScheduler::Type::Texture, [reader] {
+        reader->run();
+    });
 }
 
 void NetworkTexture::refresh() {
@@ -1134,7 +1129,6 @@ ImageReader::ImageReader(const QWeakPointer<Resource>& resource, const QUrl& url
     _maxNumPixels(maxNumPixels),
     _sourceChannel(sourceChannel)
 {
-    DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     listSupportedImageFormats();
 
 #if DEBUG_DUMP_TEXTURE_LOADS
@@ -1167,8 +1161,6 @@ void ImageReader::listSupportedImageFormats() {
 
 void ImageReader::run() {
     PROFILE_RANGE_EX(resource_parse_image, __FUNCTION__, 0xffff0000, 0, { { "url", _url.toString() } });
-    DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
-    CounterStat counter("Processing");
 
     auto originalPriority = QThread::currentThread()->priority();
     if (originalPriority == QThread::InheritPriority) {
@@ -52,6 +52,9 @@ public:
 
     QString getType() const override { return "NetworkTexture"; }
 
+    // The decoded texture lives in GPU memory, so it is charged against the GPU cache budget
+    qint64 getGPUBytes() const override { return getBytes(); }
+
     int getOriginalWidth() const { return _originalWidth; }
     int getOriginalHeight() const { return _originalHeight; }
     int getWidth() const { return _width; }
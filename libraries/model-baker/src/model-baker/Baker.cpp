@@ -124,6 +124,9 @@ namespace baker {
         using Output = VaryingSet4<hfm::Model::Pointer, MaterialMapping, std::vector<hifi::ByteArray>, std::vector<std::vector<hifi::ByteArray>>>;
         using JobModel = Task::ModelIO<BakerEngineBuilder, Input, Output>;
         void build(JobModel& model, const Varying& input, Varying& output) {
+            // the baker jobs only communicate through their varyings, so independent ones can run at the same time
+            model.setParallel(true);
+
             const auto& hfmModelIn = input.getN<Input>(0);
             const auto& mapping = input.getN<Input>(1);
             const auto& materialMappingBaseURL = input.getN<Input>(2);
@@ -35,6 +35,8 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <TBBHelpers.h>
+
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
@@ -220,32 +222,34 @@ void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Inp
     auto& dracoBytesPerMesh = output.edit0();
     auto& materialLists = output.edit1();
 
-    dracoBytesPerMesh.reserve(meshes.size());
-    materialLists.reserve(meshes.size());
-    for (size_t i = 0; i < meshes.size(); i++) {
-        const auto& mesh = meshes[i];
-        const auto& normals = baker::safeGet(normalsPerMesh, i);
-        const auto& tangents = baker::safeGet(tangentsPerMesh, i);
-        dracoBytesPerMesh.emplace_back();
-        auto& dracoBytes = dracoBytesPerMesh.back();
-        materialLists.push_back(createMaterialList(mesh));
-        const auto& materialList = materialLists.back();
+    // Meshes are encoded independently into pre-sized slots, so the output does not depend on scheduling
+    dracoBytesPerMesh.resize(meshes.size());
+    materialLists.resize(meshes.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, meshes.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            const auto& mesh = meshes[i];
+            const auto& normals = baker::safeGet(normalsPerMesh, i);
+            const auto& tangents = baker::safeGet(tangentsPerMesh, i);
+            auto& dracoBytes = dracoBytesPerMesh[i];
+            auto& materialList = materialLists[i];
+            materialList = createMaterialList(mesh);
 
-        auto dracoMesh = createDracoMesh(mesh, normals, tangents, materialList);
+            auto dracoMesh = createDracoMesh(mesh, normals, tangents, materialList);
 
-        if (dracoMesh) {
-            draco::Encoder encoder;
+            if (dracoMesh) {
+                draco::Encoder encoder;
 
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
-            encoder.SetSpeedOptions(_encodeSpeed, _decodeSpeed);
+                encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
+                encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
+                encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
+                encoder.SetSpeedOptions(_encodeSpeed, _decodeSpeed);
 
-            draco::EncoderBuffer buffer;
-            encoder.EncodeMeshToBuffer(*dracoMesh, &buffer);
+                draco::EncoderBuffer buffer;
+                encoder.EncodeMeshToBuffer(*dracoMesh, &buffer);
 
-            dracoBytes = hifi::ByteArray(buffer.data(), (int)buffer.size());
+                dracoBytes = hifi::ByteArray(buffer.data(), (int)buffer.size());
+            }
         }
-    }
+    });
 #endif // not Q_OS_ANDROID
 }
@@ -13,6 +13,8 @@
 
 #include <set>
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -21,14 +23,16 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
     const auto& meshes = input.get2();
     const auto& materials = input.get3();
     auto& tangentsPerBlendshapePerMeshOut = output;
-    
-    tangentsPerBlendshapePerMeshOut.reserve(normalsPerBlendshapePerMesh.size());
+
+    // Pre-size the outputs and flatten the (mesh, blendshape) pairs that need work so that models with
+    // a single mesh and many blendshapes still spread across the thread pool.
+    // Every pair writes only to its own slot, so the result does not depend on scheduling.
+    std::vector<std::pair<size_t, size_t>> blendshapeIndices;
+    tangentsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
     for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
-        const auto& normalsPerBlendshape = baker::safeGet(normalsPerBlendshapePerMesh, i);
         const auto& blendshapes = blendshapesPerMesh[i];
         const auto& mesh = meshes[i];
-        tangentsPerBlendshapePerMeshOut.emplace_back();
-        auto& tangentsPerBlendshapeOut = tangentsPerBlendshapePerMeshOut[tangentsPerBlendshapePerMeshOut.size()-1];
+        tangentsPerBlendshapePerMeshOut[i].resize(blendshapes.size());
 
         // Check if we actually need to calculate the tangents, or just append empty arrays
         bool needTangents = false;
@@ -40,23 +44,30 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
             }
         }
 
+        const auto& normalsPerBlendshape = baker::safeGet(normalsPerBlendshapePerMesh, i);
         for (size_t j = 0; j < blendshapes.size(); j++) {
-            const auto& blendshape = blendshapes[j];
+            // Blendshapes that already have tangents are always copied; otherwise we need normals to calculate them
+            if (!blendshapes[j].tangents.empty() || (needTangents && !baker::safeGet(normalsPerBlendshape, j).empty())) {
+                blendshapeIndices.emplace_back(i, j);
+            }
+        }
+    }
+
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, blendshapeIndices.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t k = range.begin(); k < range.end(); k++) {
+            const auto i = blendshapeIndices[k].first;
+            const auto j = blendshapeIndices[k].second;
+            const auto& mesh = meshes[i];
+            const auto& blendshape = blendshapesPerMesh[i][j];
             const auto& tangentsIn = blendshape.tangents;
-            const auto& normals = baker::safeGet(normalsPerBlendshape, j);
-            tangentsPerBlendshapeOut.emplace_back();
-            auto& tangentsOut = tangentsPerBlendshapeOut[tangentsPerBlendshapeOut.size()-1];
+            const auto& normals = baker::safeGet(baker::safeGet(normalsPerBlendshapePerMesh, i), j);
+            auto& tangentsOut = tangentsPerBlendshapePerMeshOut[i][j];
 
             // Check if we already have tangents
             if (!tangentsIn.empty()) {
                 tangentsOut = tangentsIn.toStdVector();
                 continue;
             }
-
-            // Check if we can and should calculate tangents (we need normals to calculate the tangents)
-            if (normals.empty() || !needTangents) {
-                continue;
-            }
             tangentsOut.resize(normals.size());
 
             // Create lookup to get index in blend shape from vertex index in mesh
@@ -91,5 +102,5 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
                 }
             });
         }
-    }
+    });
 }
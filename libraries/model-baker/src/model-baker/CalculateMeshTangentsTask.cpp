@@ -11,6 +11,8 @@
 
 #include "CalculateMeshTangentsTask.h"
 
+#include <TBBHelpers.h>
+
 #include "ModelMath.h"
 
 bool needTangents(const hfm::Mesh& mesh, const QHash<QString, hfm::Material>& materials) {
@@ -30,29 +32,31 @@ void CalculateMeshTangentsTask::run(const baker::BakeContextPointer& context, co
     const auto& materials = input.get2();
     auto& tangentsPerMeshOut = output;
 
-    tangentsPerMeshOut.reserve(meshes.size());
-    for (int i = 0; i < (int)meshes.size(); i++) {
-        const auto& mesh = meshes[i];
-        const auto& tangentsIn = mesh.tangents;
-        const auto& normals = baker::safeGet(normalsPerMesh, i);
-        tangentsPerMeshOut.emplace_back();
-        auto& tangentsOut = tangentsPerMeshOut[tangentsPerMeshOut.size()-1];
+    // Each mesh writes only to its own pre-sized slot, so the result does not depend on scheduling
+    tangentsPerMeshOut.resize(meshes.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, meshes.size()), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i < range.end(); i++) {
+            const auto& mesh = meshes[i];
+            const auto& tangentsIn = mesh.tangents;
+            const auto& normals = baker::safeGet(normalsPerMesh, i);
+            auto& tangentsOut = tangentsPerMeshOut[i];
 
-        // Check if we already have tangents and therefore do not need to do any calculation
-        // Otherwise confirm if we have the normals needed, and need to calculate the tangents
-        if (!tangentsIn.empty()) {
-            tangentsOut = tangentsIn.toStdVector();
-        } else if (!normals.empty() && needTangents(mesh, materials)) {
-            tangentsOut.resize(normals.size());
-            baker::calculateTangents(mesh,
-            [&mesh, &normals, &tangentsOut](int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal) {
-                outVertices[0] = mesh.vertices[firstIndex];
-                outVertices[1] = mesh.vertices[secondIndex];
-                outNormal = normals[firstIndex];
-                outTexCoords[0] = mesh.texCoords[firstIndex];
-                outTexCoords[1] = mesh.texCoords[secondIndex];
-                return &(tangentsOut[firstIndex]);
-            });
+            // Check if we already have tangents and therefore do not need to do any calculation
+            // Otherwise confirm if we have the normals needed, and need to calculate the tangents
+            if (!tangentsIn.empty()) {
+                tangentsOut = tangentsIn.toStdVector();
+            } else if (!normals.empty() && needTangents(mesh, materials)) {
+                tangentsOut.resize(normals.size());
+                baker::calculateTangents(mesh,
+                [&mesh, &normals, &tangentsOut](int firstIndex, int secondIndex, glm::vec3* outVertices, glm::vec2* outTexCoords, glm::vec3& outNormal) {
+                    outVertices[0] = mesh.vertices[firstIndex];
+                    outVertices[1] = mesh.vertices[secondIndex];
+                    outNormal = normals[firstIndex];
+                    outTexCoords[0] = mesh.texCoords[firstIndex];
+                    outTexCoords[1] = mesh.texCoords[secondIndex];
+                    return &(tangentsOut[firstIndex]);
+                });
+            }
         }
-    }
+    });
 }
@@ -10,14 +10,17 @@
 //
 
 #include "ModelCache.h"
+
+#include <memory>
+
+#include <QThread>
+
 #include <Finally.h>
 #include <FSTReader.h>
 
 #include <gpu/Batch.h>
 #include <gpu/Stream.h>
 
-#include <QThreadPool>
-
 #include <Gzip.h>
 
 #include "ModelNetworkingLogging.h"
@@ -85,16 +88,14 @@ namespace std {
     };
 }
 
-class GeometryReader : public QRunnable {
+class GeometryReader {
 public:
     GeometryReader(const ModelLoader& modelLoader, QWeakPointer<Resource>& resource, const QUrl& url, const GeometryMappingPair& mapping,
                    const QByteArray& data, bool combineParts, const QString& webMediaType) :
         _modelLoader(modelLoader), _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts), _webMediaType(webMediaType) {
-
-        DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     }
 
-    virtual void run() override;
+    void run();
 
 private:
     ModelLoader _modelLoader;
@@ -107,8 +108,6 @@ private:
 };
 
 void GeometryReader::run() {
-    DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
-    CounterStat counter("Processing");
     PROFILE_RANGE_EX(resource_parse_geometry, "GeometryReader::run", 0xFF00FF00, 0, { { "url", _url.toString() } });
     auto originalPriority = QThread::currentThread()->priority();
     if (originalPriority == QThread::InheritPriority) {
@@ -287,7 +286,10 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
             _url = _effectiveBaseURL;
             _textureBaseURL = _effectiveBaseURL;
         }
-        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()));
+        auto reader = std::make_shared<GeometryReader>(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType());
+        scheduleDecode(ResourceDecodeScheduler::Type::Model, [reader] {
+            reader->run();
+        });
     }
 }
 
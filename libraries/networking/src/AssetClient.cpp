@@ -11,6 +11,7 @@
 
 #include "AssetClient.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include <QtCore/QBuffer>
@@ -392,6 +393,11 @@ AssetUpload* AssetClient::createUpload(const QByteArray& data) {
     return upload;
 }
 
+void AssetClient::setDownloadChunking(int64_t chunkSize, int maxParallelRanges) {
+    _downloadChunkSize = std::max(chunkSize, (int64_t)0);
+    _maxParallelRanges = std::max(maxParallelRanges, 1);
+}
+
 MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end,
                                 ReceivedAssetCallback callback, ProgressCallback progressCallback) {
     Q_ASSERT(QThread::currentThread() == thread());
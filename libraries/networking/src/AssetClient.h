@@ -16,6 +16,7 @@
 #include <QtQml/QJSEngine>
 #include <QString>
 
+#include <atomic>
 #include <map>
 
 #include <DependencyManager.h>
@@ -48,6 +49,9 @@ using GetInfoCallback = std::function<void(bool responseReceived, AssetUtils::As
 using UploadResultCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const QString& hash)>;
 using ProgressCallback = std::function<void(qint64 totalReceived, qint64 total)>;
 
+const int64_t DEFAULT_DOWNLOAD_CHUNK_SIZE = 1024 * 1024; // 1MB
+const int DEFAULT_MAX_PARALLEL_RANGES = 4;
+
 class AssetClient : public QObject, public Dependency {
     Q_OBJECT
 public:
@@ -63,6 +67,12 @@ public:
     Q_INVOKABLE AssetUpload* createUpload(const QString& filename);
     Q_INVOKABLE AssetUpload* createUpload(const QByteArray& data);
 
+    // Assets larger than the chunk size are downloaded as several ranges, up to maxParallelRanges at a time.
+    // A chunk size of 0 disables ranged downloads.
+    void setDownloadChunking(int64_t chunkSize, int maxParallelRanges);
+    int64_t getDownloadChunkSize() const { return _downloadChunkSize; }
+    int getMaxParallelRanges() const { return _maxParallelRanges; }
+
 public slots:
     void initCaching();
 
@@ -119,6 +129,9 @@ private:
 
     QString _cacheDir;
 
+    std::atomic<int64_t> _downloadChunkSize { DEFAULT_DOWNLOAD_CHUNK_SIZE };
+    std::atomic<int> _maxParallelRanges { DEFAULT_MAX_PARALLEL_RANGES };
+
     friend class AssetRequest;
     friend class AssetUpload;
     friend class MappingRequest;
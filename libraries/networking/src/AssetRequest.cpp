@@ -12,8 +12,10 @@
 #include "AssetRequest.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 
 #include <StatTracker.h>
 #include <Trace.h>
@@ -38,6 +40,23 @@ AssetRequest::~AssetRequest() {
     if (_assetRequestID) {
         assetClient->cancelGetAssetRequest(_assetRequestID);
     }
+    if (_assetInfoRequestID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+    }
+    cancelRanges();
+}
+
+static AssetRequest::Error errorFromServerError(AssetUtils::AssetServerError serverError) {
+    switch (serverError) {
+        case AssetUtils::AssetServerError::NoError:
+            return AssetRequest::NoError;
+        case AssetUtils::AssetServerError::AssetNotFound:
+            return AssetRequest::NotFound;
+        case AssetUtils::AssetServerError::InvalidByteRange:
+            return AssetRequest::InvalidByteRange;
+        default:
+            return AssetRequest::UnknownError;
+    }
 }
 
 void AssetRequest::start() {
@@ -75,6 +94,48 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    auto assetClient = DependencyManager::get<AssetClient>();
+    if (_byteRange.isSet() || assetClient->getDownloadChunkSize() <= 0) {
+        requestAsset();
+        return;
+    }
+
+    // resume a ranged download that was interrupted, the size of the asset was cached along with its first ranges
+    bool isSizeValid = false;
+    auto assetSize = AssetUtils::loadFromCache(getSizeCacheUrl()).toLongLong(&isSizeValid);
+    if (isSizeValid && assetSize > 0) {
+        requestRanges(assetSize);
+        return;
+    }
+
+    requestAssetInfo();
+}
+
+void AssetRequest::requestAssetInfo() {
+    // ask for the size of the asset before requesting any of it, so that large ones are split in ranges from the start.
+    // A whole-asset request can't be stopped once the server has started sending it.
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    _assetInfoRequestID = DependencyManager::get<AssetClient>()->getAssetInfo(_hash,
+        [this, that](bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info) {
+
+        if (!that) {
+            return;
+        }
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived) {
+            fail(NetworkError);
+        } else if (serverError != AssetUtils::AssetServerError::NoError) {
+            fail(errorFromServerError(serverError));
+        } else if (info.size <= DependencyManager::get<AssetClient>()->getDownloadChunkSize()) {
+            requestAsset();
+        } else {
+            requestRanges(info.size);
+        }
+    });
+}
+
+void AssetRequest::requestAsset() {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
@@ -92,17 +153,7 @@ void AssetRequest::start() {
         if (!responseReceived) {
             _error = NetworkError;
         } else if (serverError != AssetUtils::AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetUtils::AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetUtils::AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
+            _error = errorFromServerError(serverError);
         } else {
             if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
                 // the hash of the received data does not match what we expect, so we return an error
@@ -135,6 +186,179 @@ void AssetRequest::start() {
     });
 }
 
+QUrl AssetRequest::getSizeCacheUrl() const {
+    QUrl url = getUrl();
+    url.setQuery("size");
+    return url;
+}
+
+QUrl AssetRequest::getRangeCacheUrl(const ByteRange& range) const {
+    QUrl url = getUrl();
+    url.setQuery(QString("range=%1-%2").arg(range.fromInclusive).arg(range.toExclusive));
+    return url;
+}
+
+void AssetRequest::requestRanges(int64_t assetSize) {
+    auto chunkSize = DependencyManager::get<AssetClient>()->getDownloadChunkSize();
+
+    _data = QByteArray(assetSize, Qt::Uninitialized);
+    _ranges.clear();
+    _queuedRanges.clear();
+
+    for (int64_t offset = 0; offset < assetSize; offset += chunkSize) {
+        RangeRequest rangeRequest;
+        rangeRequest.range.fromInclusive = offset;
+        rangeRequest.range.toExclusive = std::min(offset + chunkSize, assetSize);
+
+        // ranges completed by a previous, interrupted download of this asset don't need to be requested again
+        auto cachedRange = AssetUtils::loadFromCache(getRangeCacheUrl(rangeRequest.range));
+        if (cachedRange.size() == rangeRequest.range.size()) {
+            memcpy(_data.data() + offset, cachedRange.constData(), cachedRange.size());
+            rangeRequest.received = true;
+            _totalReceived += cachedRange.size();
+        } else {
+            _queuedRanges.push_back(_ranges.size());
+        }
+        _ranges.push_back(rangeRequest);
+    }
+
+    qCDebug(asset_client) << "Requesting" << _queuedRanges.size() << "of" << _ranges.size() << "ranges of" << _hash;
+    AssetUtils::saveToCache(getSizeCacheUrl(), QByteArray::number((qlonglong)assetSize));
+
+    if (_queuedRanges.empty()) {
+        finishRanges();
+    } else {
+        emit progress(_totalReceived, assetSize);
+        requestNextRanges();
+    }
+}
+
+void AssetRequest::requestNextRanges() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto maxRangesInFlight = assetClient->getMaxParallelRanges();
+
+    while (_state == WaitingForData && !_queuedRanges.empty() && _numPendingRequests < maxRangesInFlight) {
+        auto rangeIndex = _queuedRanges.front();
+        _queuedRanges.pop_front();
+
+        const auto& range = _ranges[rangeIndex].range;
+        auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+        ++_numPendingRequests;
+        auto messageID = assetClient->getAsset(_hash, range.fromInclusive, range.toExclusive,
+            [this, that, rangeIndex](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+            if (!that) {
+                return;
+            }
+            handleRangeReply(rangeIndex, responseReceived, serverError, data);
+        }, [](qint64 totalReceived, qint64 total) {});
+
+        if (messageID != INVALID_MESSAGE_ID) {
+            _ranges[rangeIndex].messageID = messageID;
+        }
+    }
+}
+
+void AssetRequest::handleRangeReply(size_t rangeIndex, bool responseReceived, AssetUtils::AssetServerError serverError,
+                                    const QByteArray& data) {
+    static const int MAX_RANGE_RETRIES = 3;
+    static const int RANGE_RETRY_DELAY_MS = 250;
+
+    if (_state != WaitingForData) {
+        return;
+    }
+
+    auto& rangeRequest = _ranges[rangeIndex];
+    rangeRequest.messageID = INVALID_MESSAGE_ID;
+    --_numPendingRequests;
+
+    if (!responseReceived || serverError != AssetUtils::AssetServerError::NoError
+        || data.size() != rangeRequest.range.size()) {
+
+        if (responseReceived && serverError != AssetUtils::AssetServerError::NoError) {
+            // the server won't give a different answer if we ask again
+            fail(errorFromServerError(serverError));
+        } else if (++rangeRequest.retries > MAX_RANGE_RETRIES) {
+            fail(responseReceived ? SizeVerificationFailed : NetworkError);
+        } else {
+            // only this range is requested again, the ones we already have are kept
+            qCDebug(asset_client) << "Retrying range" << rangeRequest.range.fromInclusive << "to"
+                                  << rangeRequest.range.toExclusive << "of" << _hash;
+            // queued only once the delay is over, so that the replies of the other ranges don't request it right away
+            ++_numDelayedRanges;
+            QTimer::singleShot(RANGE_RETRY_DELAY_MS, this, [this, rangeIndex] {
+                --_numDelayedRanges;
+                if (_state == WaitingForData) {
+                    _queuedRanges.push_front(rangeIndex);
+                    requestNextRanges();
+                }
+            });
+        }
+        return;
+    }
+
+    memcpy(_data.data() + rangeRequest.range.fromInclusive, data.constData(), data.size());
+    rangeRequest.received = true;
+    _totalReceived += data.size();
+    emit progress(_totalReceived, _data.size());
+
+    AssetUtils::saveToCache(getRangeCacheUrl(rangeRequest.range), data);
+
+    if (_queuedRanges.empty() && _numPendingRequests == 0 && _numDelayedRanges == 0) {
+        finishRanges();
+    } else {
+        requestNextRanges();
+    }
+}
+
+void AssetRequest::finishRanges() {
+    if (AssetUtils::hashData(_data).toHex() != _hash) {
+        // the hash of the reassembled data does not match what we expect, so we return an error
+        _error = HashVerificationFailed;
+    } else {
+        AssetUtils::saveToCache(getUrl(), _data);
+    }
+
+    // the whole asset is now cached (or the ranges were corrupted), either way we don't need the ranges anymore
+    for (const auto& rangeRequest : _ranges) {
+        AssetUtils::removeFromCache(getRangeCacheUrl(rangeRequest.range));
+    }
+    AssetUtils::removeFromCache(getSizeCacheUrl());
+    _ranges.clear();
+
+    if (_error != NoError) {
+        qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+        _data.clear();
+    }
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::cancelRanges() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    for (auto& rangeRequest : _ranges) {
+        if (rangeRequest.messageID != INVALID_MESSAGE_ID) {
+            assetClient->cancelGetAssetRequest(rangeRequest.messageID);
+            rangeRequest.messageID = INVALID_MESSAGE_ID;
+        }
+    }
+    _queuedRanges.clear();
+    _numPendingRequests = 0;
+}
+
+void AssetRequest::fail(Error error) {
+    // completed ranges are left in the cache so that the next request for this asset can resume from them
+    cancelRanges();
+
+    _error = error;
+    _data.clear();
+    qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+
+    _state = Finished;
+    emit finished(this);
+}
+
 
 const QString AssetRequest::getErrorString() const {
     QString result;
@@ -12,6 +12,9 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <deque>
+#include <vector>
+
 #include <QByteArray>
 #include <QObject>
 #include <QString>
@@ -62,6 +65,27 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    struct RangeRequest {
+        ByteRange range;
+        MessageID messageID { INVALID_MESSAGE_ID };
+        int retries { 0 };
+        bool received { false };
+    };
+
+    void requestAssetInfo();
+    void requestAsset();
+    void requestRanges(int64_t assetSize);
+    void requestNextRanges();
+    void handleRangeReply(size_t rangeIndex, bool responseReceived, AssetUtils::AssetServerError serverError,
+                          const QByteArray& data);
+    void finishRanges();
+    void cancelRanges();
+    void fail(Error error);
+
+    // the on-disk cache keys of the asset size and of each completed range, used to resume interrupted downloads
+    QUrl getSizeCacheUrl() const;
+    QUrl getRangeCacheUrl(const ByteRange& range) const;
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -69,7 +93,11 @@ private:
     QString _hash;
     QByteArray _data;
     int _numPendingRequests { 0 };
+    int _numDelayedRanges { 0 };
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
+    MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
+    std::vector<RangeRequest> _ranges;
+    std::deque<size_t> _queuedRanges;
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
 };
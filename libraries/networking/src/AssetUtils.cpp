@@ -13,8 +13,10 @@
 
 #include <memory>
 
-#include <QtCore/QCryptographicHash>
+#include <openssl/sha.h>
+
 #include <QtCore/QDateTime>
+#include <QtCore/QFile>
 #include <QtCore/QFileInfo> // for baseName
 #include <QtNetwork/QAbstractNetworkCache>
 
@@ -58,8 +60,67 @@ QUrl getATPUrl(const QString& input) {
     return QUrl();
 }
 
+AssetHasher::AssetHasher() :
+    _context(new SHA256_CTX())
+{
+    reset();
+}
+
+AssetHasher::~AssetHasher() {
+    delete _context;
+}
+
+void AssetHasher::reset() {
+    SHA256_Init(_context);
+}
+
+void AssetHasher::addData(const char* data, qint64 length) {
+    if (length > 0) {
+        SHA256_Update(_context, data, (size_t)length);
+    }
+}
+
+bool AssetHasher::addData(QIODevice& device) {
+    QByteArray chunk(HASH_CHUNK_SIZE, Qt::Uninitialized);
+
+    while (!device.atEnd()) {
+        auto bytesRead = device.read(chunk.data(), chunk.size());
+        if (bytesRead < 0) {
+            return false;
+        }
+        addData(chunk.constData(), bytesRead);
+    }
+
+    return true;
+}
+
+QByteArray AssetHasher::result() {
+    QByteArray hash(SHA256_HASH_LENGTH, Qt::Uninitialized);
+    SHA256_Final(reinterpret_cast<unsigned char*>(hash.data()), _context);
+    reset();
+    return hash;
+}
+
 QByteArray hashData(const QByteArray& data) {
-    return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+    AssetHasher hasher;
+    hasher.addData(data);
+    return hasher.result();
+}
+
+QByteArray hashDevice(QIODevice& device) {
+    AssetHasher hasher;
+    if (!hasher.addData(device)) {
+        return QByteArray();
+    }
+    return hasher.result();
+}
+
+QByteArray hashFile(const QString& filePath) {
+    QFile file { filePath };
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return hashDevice(file);
 }
 
 QByteArray loadFromCache(const QUrl& url) {
@@ -96,6 +157,13 @@ bool saveToCache(const QUrl& url, const QByteArray& file) {
     return false;
 }
 
+bool removeFromCache(const QUrl& url) {
+    if (auto cache = NetworkAccessManager::getInstance().cache()) {
+        return cache->remove(url);
+    }
+    return false;
+}
+
 bool isValidFilePath(const AssetPath& filePath) {
     QRegExp filePathRegex { ASSET_FILE_PATH_REGEX_STRING };
     return filePathRegex.exactMatch(filePath);
@@ -19,6 +19,9 @@
 #include <QtCore/QByteArray>
 #include <QtCore/QUrl>
 
+class QIODevice;
+struct SHA256state_st;
+
 namespace AssetUtils {
 
 using DataOffset = int64_t;
@@ -30,6 +33,7 @@ using AssetPathList = QStringList;
 const size_t SHA256_HASH_LENGTH = 32;
 const size_t SHA256_HASH_HEX_LENGTH = 64;
 const uint64_t MAX_UPLOAD_SIZE = 1000 * 1000 * 1000; // 1GB
+const qint64 HASH_CHUNK_SIZE = 1024 * 1024; // 1MB
 
 const QString ASSET_FILE_PATH_REGEX_STRING = "^(\\/[^\\/\\0]+)+$";
 const QString ASSET_PATH_REGEX_STRING = "^\\/([^\\/\\0]+(\\/)?)+$";
@@ -79,10 +83,42 @@ using Mappings = std::map<AssetPath, AssetHash>;
 QUrl getATPUrl(const QString& input);
 AssetHash extractAssetHash(const QString& input);
 
+// Incrementally computes the SHA256 hash of asset data, so large assets can be hashed chunk by chunk
+// as they are read instead of from a single in-memory copy.
+// Backed by OpenSSL, which picks SHA-NI / AVX2 code paths at runtime when the CPU supports them.
+class AssetHasher {
+public:
+    AssetHasher();
+    ~AssetHasher();
+
+    AssetHasher(const AssetHasher&) = delete;
+    AssetHasher& operator=(const AssetHasher&) = delete;
+
+    void addData(const char* data, qint64 length);
+    void addData(const QByteArray& data) { addData(data.constData(), data.size()); }
+
+    // Reads the device until its end in HASH_CHUNK_SIZE chunks, returns false on a read error
+    bool addData(QIODevice& device);
+
+    // Returns the raw (non hex) hash, the hasher is reset and can be reused afterwards
+    QByteArray result();
+
+private:
+    void reset();
+
+    ::SHA256state_st* _context;
+};
+
 QByteArray hashData(const QByteArray& data);
 
+// Hash the remaining content of a device or the file at filePath without loading it all in memory.
+// Returns an empty QByteArray if the content could not be read.
+QByteArray hashDevice(QIODevice& device);
+QByteArray hashFile(const QString& filePath);
+
 QByteArray loadFromCache(const QUrl& url);
 bool saveToCache(const QUrl& url, const QByteArray& file);
+bool removeFromCache(const QUrl& url);
 
 bool isValidFilePath(const AssetPath& path);
 bool isValidPath(const AssetPath& path);
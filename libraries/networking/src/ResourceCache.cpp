@@ -144,6 +144,7 @@ void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
     _pendingRequests.clear();
     _loadingRequests.clear();
+    _decodeScheduler.clear();
 }
 
 ScriptableResourceCache::ScriptableResourceCache(QSharedPointer<ResourceCache> resourceCache) {
@@ -281,11 +282,10 @@ void ResourceCache::clearATPAssets() {
         }
     }
     {
-        QWriteLocker locker(&_unusedResourcesLock);
+        std::lock_guard<std::recursive_mutex> lock(_unusedResourcesMutex);
         for (auto& resource : _unusedResources.values()) {
             if (resource->getURL().scheme() == URL_SCHEME_ATP) {
-                _unusedResources.remove(resource->getLRUKey());
-                _unusedResourcesSize -= resource->getBytes();
+                unlinkUnusedResource(resource.data());
             }
         }
     }
@@ -369,6 +369,7 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         }
     }
     if (resource) {
+        ++_numHits;
         removeUnusedResource(resource);
     }
 
@@ -377,6 +378,7 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
     }
 
     if (!resource) {
+        ++_numMisses;
         resource = createResource(url);
         resource->setExtra(extra);
         resource->setExtraHash(extraHash);
@@ -402,68 +404,129 @@ void ResourceCache::setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize) {
     resetUnusedResourceCounter();
 }
 
+void ResourceCache::setUnusedResourceGPUCacheSize(qint64 unusedResourcesMaxGPUSize) {
+    _unusedResourcesMaxGPUSize = glm::clamp(unusedResourcesMaxGPUSize, MIN_UNUSED_MAX_SIZE, MAX_UNUSED_MAX_SIZE);
+    reserveUnusedResource(0);
+    resetUnusedResourceCounter();
+}
+
+void ResourceCache::linkUnusedResource(const QSharedPointer<Resource>& resource) {
+    auto gpuBytes = glm::clamp(resource->getGPUBytes(), (qint64)0, resource->getBytes());
+    resource->_lruBytes = resource->getBytes() - gpuBytes;
+    resource->_lruGPUBytes = gpuBytes;
+
+    // insert at the head, as the most recently used
+    resource->_lruPrev = nullptr;
+    resource->_lruNext = _unusedResourcesHead;
+    if (_unusedResourcesHead) {
+        _unusedResourcesHead->_lruPrev = resource.data();
+    } else {
+        _unusedResourcesTail = resource.data();
+    }
+    _unusedResourcesHead = resource.data();
+
+    _unusedResources.insert(resource.data(), resource);
+    _unusedResourcesSize += resource->_lruBytes + resource->_lruGPUBytes;
+    _unusedResourcesGPUSize += resource->_lruGPUBytes;
+}
+
+QSharedPointer<Resource> ResourceCache::unlinkUnusedResource(Resource* resource) {
+    auto resourceRef = _unusedResources.take(resource);
+    if (!resourceRef) {
+        return resourceRef;
+    }
+
+    if (resource->_lruPrev) {
+        resource->_lruPrev->_lruNext = resource->_lruNext;
+    } else {
+        _unusedResourcesHead = resource->_lruNext;
+    }
+    if (resource->_lruNext) {
+        resource->_lruNext->_lruPrev = resource->_lruPrev;
+    } else {
+        _unusedResourcesTail = resource->_lruPrev;
+    }
+    resource->_lruPrev = resource->_lruNext = nullptr;
+
+    _unusedResourcesSize -= resource->_lruBytes + resource->_lruGPUBytes;
+    _unusedResourcesGPUSize -= resource->_lruGPUBytes;
+    return resourceRef;
+}
+
 void ResourceCache::addUnusedResource(const QSharedPointer<Resource>& resource) {
+    auto gpuBytes = glm::clamp(resource->getGPUBytes(), (qint64)0, resource->getBytes());
+    auto cpuBytes = resource->getBytes() - gpuBytes;
+
     // If it doesn't fit or its size is unknown, remove it from the cache.
-    if (resource->getBytes() == 0 || resource->getBytes() > _unusedResourcesMaxSize) {
+    if (resource->getBytes() == 0 || cpuBytes > _unusedResourcesMaxSize || gpuBytes > _unusedResourcesMaxGPUSize) {
         resource->setCache(nullptr);
         removeResource(resource->getURL(), resource->getExtraHash(), resource->getBytes());
         resetTotalResourceCounter();
         return;
     }
-    reserveUnusedResource(resource->getBytes());
-    
-    resource->setLRUKey(++_lastLRUKey);
+    reserveUnusedResource(cpuBytes, gpuBytes);
 
     {
-        QWriteLocker locker(&_unusedResourcesLock);
-        _unusedResources.insert(resource->getLRUKey(), resource);
-        _unusedResourcesSize += resource->getBytes();
+        std::lock_guard<std::recursive_mutex> lock(_unusedResourcesMutex);
+        unlinkUnusedResource(resource.data());
+        linkUnusedResource(resource);
     }
 
     resetUnusedResourceCounter();
 }
 
 void ResourceCache::removeUnusedResource(const QSharedPointer<Resource>& resource) {
-    QWriteLocker locker(&_unusedResourcesLock);
-    if (_unusedResources.contains(resource->getLRUKey())) {
-        _unusedResources.remove(resource->getLRUKey());
-        _unusedResourcesSize -= resource->getBytes();
-
-        locker.unlock();
+    std::unique_lock<std::recursive_mutex> lock(_unusedResourcesMutex);
+    if (unlinkUnusedResource(resource.data())) {
+        lock.unlock();
         resetUnusedResourceCounter();
     }
 }
 
-void ResourceCache::reserveUnusedResource(qint64 resourceSize) {
-    QWriteLocker locker(&_unusedResourcesLock);
-    while (!_unusedResources.empty() &&
-           _unusedResourcesSize + resourceSize > _unusedResourcesMaxSize) {
-        // unload the oldest resource
-        QMap<int, QSharedPointer<Resource> >::iterator it = _unusedResources.begin();
-        
-        it.value()->setCache(nullptr);
-        auto size = it.value()->getBytes();
+void ResourceCache::reserveUnusedResource(qint64 resourceSize, qint64 resourceGPUSize) {
+    std::unique_lock<std::recursive_mutex> lock(_unusedResourcesMutex);
+    while (true) {
+        bool overCPUBudget = (_unusedResourcesSize - _unusedResourcesGPUSize) + resourceSize > _unusedResourcesMaxSize;
+        bool overGPUBudget = _unusedResourcesGPUSize + resourceGPUSize > _unusedResourcesMaxGPUSize;
+        if (!overCPUBudget && !overGPUBudget) {
+            break;
+        }
+
+        // unload the least recently used resource that frees memory in a budget we are over
+        Resource* candidate = _unusedResourcesTail;
+        while (candidate && !((overCPUBudget && candidate->_lruBytes > 0) || (overGPUBudget && candidate->_lruGPUBytes > 0))) {
+            candidate = candidate->_lruPrev;
+        }
+        if (!candidate) {
+            break;
+        }
 
-        locker.unlock();
-        removeResource(it.value()->getURL(), it.value()->getExtraHash(), size);
-        locker.relock();
+        auto resource = unlinkUnusedResource(candidate);
+        resource->setCache(nullptr);
+        ++_numEvictions;
 
-        _unusedResourcesSize -= size;
-        _unusedResources.erase(it);
+        lock.unlock();
+        removeResource(resource->getURL(), resource->getExtraHash(), resource->getBytes());
+        resource.reset();
+        lock.lock();
     }
 }
 
 void ResourceCache::clearUnusedResources() {
     // the unused resources may themselves reference resources that will be added to the unused
     // list on destruction, so keep clearing until there are no references left
-    QWriteLocker locker(&_unusedResourcesLock);
+    std::lock_guard<std::recursive_mutex> lock(_unusedResourcesMutex);
     while (!_unusedResources.isEmpty()) {
-        foreach (const QSharedPointer<Resource>& resource, _unusedResources) {
+        auto unusedResources = _unusedResources;
+        _unusedResources.clear();
+        _unusedResourcesHead = _unusedResourcesTail = nullptr;
+        foreach (const QSharedPointer<Resource>& resource, unusedResources) {
+            resource->_lruPrev = resource->_lruNext = nullptr;
             resource->setCache(nullptr);
         }
-        _unusedResources.clear();
     }
     _unusedResourcesSize = 0;
+    _unusedResourcesGPUSize = 0;
 }
 
 void ResourceCache::resetTotalResourceCounter() {
@@ -477,7 +540,7 @@ void ResourceCache::resetTotalResourceCounter() {
 
 void ResourceCache::resetUnusedResourceCounter() {
     {
-        QReadLocker locker(&_unusedResourcesLock);
+        std::lock_guard<std::recursive_mutex> lock(_unusedResourcesMutex);
         _numUnusedResources = _unusedResources.size();
     }
 
@@ -564,6 +627,7 @@ Resource::Resource(const Resource& other) :
     _failedToLoad(other._failedToLoad),
     _loaded(other._loaded),
     _loadPriorities(other._loadPriorities),
+    _cachedLoadPriority(other._cachedLoadPriority.load()),
     _bytesReceived(other._bytesReceived),
     _bytesTotal(other._bytesTotal),
     _bytes(other._bytes),
@@ -600,6 +664,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
         _loadPriorities.insert(owner, priority);
+        updateCachedLoadPriority();
     }
 }
 
@@ -611,11 +676,13 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    updateCachedLoadPriority();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!_failedToLoad) {
         _loadPriorities.remove(owner);
+        updateCachedLoadPriority();
     }
 }
 
@@ -636,6 +703,10 @@ float Resource::getLoadPriority() {
     return highestPriority;
 }
 
+void Resource::updateCachedLoadPriority() {
+    _cachedLoadPriority = getLoadPriority();
+}
+
 void Resource::refresh() {
     if (_request && !(_loaded || _failedToLoad)) {
         return;
@@ -712,6 +783,7 @@ void Resource::attemptRequest() {
 void Resource::finishedLoading(bool success) {
     if (success) {
         _loadPriorities.clear();
+        updateCachedLoadPriority();
         _loaded = true;
     } else {
         _failedToLoad = true;
@@ -724,6 +796,12 @@ void Resource::setSize(const qint64& bytes) {
     _bytes = bytes;
 }
 
+void Resource::scheduleDecode(ResourceDecodeScheduler::Type type, ResourceDecodeScheduler::Work work) {
+    auto& scheduler = DependencyManager::get<ResourceCacheSharedItems>()->getDecodeScheduler();
+    updateCachedLoadPriority();
+    scheduler.schedule(type, _self, _cachedLoadPriority, work);
+}
+
 void Resource::reinsert() {
     QWriteLocker locker(&_cache->_resourcesLock);
     _cache->_resources[_url].insert(_extraHash, _self);
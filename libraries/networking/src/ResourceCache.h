@@ -32,6 +32,7 @@
 
 #include <DependencyManager.h>
 
+#include "ResourceDecodeScheduler.h"
 #include "ResourceManager.h"
 
 Q_DECLARE_METATYPE(size_t)
@@ -55,6 +56,9 @@ static const qint64 DEFAULT_UNUSED_MAX_SIZE = 1024 * BYTES_PER_MEGABYTES;
 static const qint64 MIN_UNUSED_MAX_SIZE = 0;
 static const qint64 MAX_UNUSED_MAX_SIZE = MAXIMUM_CACHE_SIZE;
 
+// Only resources that hold GPU memory (textures) count against the GPU budget, which is off by default
+static const qint64 DEFAULT_UNUSED_MAX_GPU_SIZE = 0;
+
 // We need to make sure that these items are available for all instances of
 // ResourceCache derived classes. Since we can't count on the ordering of
 // static members destruction, we need to use this Dependency manager implemented
@@ -77,6 +81,8 @@ public:
     uint32_t getLoadingRequestsCount() const;
     void clear();
 
+    ResourceDecodeScheduler& getDecodeScheduler() { return _decodeScheduler; }
+
 private:
     ResourceCacheSharedItems() = default;
 
@@ -85,6 +91,8 @@ private:
     QList<QWeakPointer<Resource>> _loadingRequests;
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
+
+    ResourceDecodeScheduler _decodeScheduler;
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -199,6 +207,9 @@ class ResourceCache : public QObject {
     Q_PROPERTY(size_t numCached READ getNumCachedResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeTotal READ getSizeTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeCached READ getSizeCachedResources NOTIFY dirty)
+    Q_PROPERTY(size_t numHits READ getNumHits NOTIFY dirty)
+    Q_PROPERTY(size_t numMisses READ getNumMisses NOTIFY dirty)
+    Q_PROPERTY(size_t numEvictions READ getNumEvictions NOTIFY dirty)
 
 public:
 
@@ -207,14 +218,23 @@ public:
     size_t getNumCachedResources() const { return _numUnusedResources; }
     size_t getSizeCachedResources() const { return _unusedResourcesSize; }
 
+    size_t getNumHits() const { return _numHits; }
+    size_t getNumMisses() const { return _numMisses; }
+    size_t getNumEvictions() const { return _numEvictions; }
+
     Q_INVOKABLE QVariantList getResourceList();
 
     static void setRequestLimit(uint32_t limit);
     static uint32_t getRequestLimit() { return DependencyManager::get<ResourceCacheSharedItems>()->getRequestLimit(); }
     
+    /// Budget for the CPU memory held by unused resources
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
     qint64 getUnusedResourceCacheSize() const { return _unusedResourcesMaxSize; }
 
+    /// Budget for the GPU memory held by unused resources
+    void setUnusedResourceGPUCacheSize(qint64 unusedResourcesMaxGPUSize);
+    qint64 getUnusedResourceGPUCacheSize() const { return _unusedResourcesMaxGPUSize; }
+
     static QList<QSharedPointer<Resource>> getLoadingRequests();
     static uint32_t getPendingRequestCount();
     static uint32_t getLoadingRequestCount();
@@ -275,9 +295,13 @@ private:
     friend class Resource;
     friend class ScriptableResourceCache;
 
-    void reserveUnusedResource(qint64 resourceSize);
+    void reserveUnusedResource(qint64 resourceSize, qint64 resourceGPUSize = 0);
     void removeResource(const QUrl& url, size_t extraHash, qint64 size = 0);
 
+    // Must be called with _unusedResourcesMutex held
+    void linkUnusedResource(const QSharedPointer<Resource>& resource);
+    QSharedPointer<Resource> unlinkUnusedResource(Resource* resource);
+
     void resetTotalResourceCounter();
     void resetUnusedResourceCounter();
     void resetResourceCounters();
@@ -285,18 +309,26 @@ private:
     // Resources
     QHash<QUrl, QHash<size_t, QWeakPointer<Resource>>> _resources;
     QReadWriteLock _resourcesLock { QReadWriteLock::Recursive };
-    int _lastLRUKey = 0;
 
     std::atomic<size_t> _numTotalResources { 0 };
     std::atomic<qint64> _totalResourcesSize { 0 };
 
-    // Cached resources
-    QMap<int, QSharedPointer<Resource>> _unusedResources;
-    QReadWriteLock _unusedResourcesLock { QReadWriteLock::Recursive };
+    // Cached resources, kept alive by the hash and ordered by an intrusive list running
+    // from the most (head) to the least (tail) recently used, so touch and eviction are O(1)
+    QHash<Resource*, QSharedPointer<Resource>> _unusedResources;
+    Resource* _unusedResourcesHead { nullptr };
+    Resource* _unusedResourcesTail { nullptr };
+    std::recursive_mutex _unusedResourcesMutex;
     qint64 _unusedResourcesMaxSize = DEFAULT_UNUSED_MAX_SIZE;
+    qint64 _unusedResourcesMaxGPUSize = DEFAULT_UNUSED_MAX_GPU_SIZE;
 
     std::atomic<size_t> _numUnusedResources { 0 };
     std::atomic<qint64> _unusedResourcesSize { 0 };
+    std::atomic<qint64> _unusedResourcesGPUSize { 0 };
+
+    std::atomic<size_t> _numHits { 0 };
+    std::atomic<size_t> _numMisses { 0 };
+    std::atomic<size_t> _numEvictions { 0 };
 };
 
 /// Wrapper to expose resource caches to JS/QML
@@ -311,11 +343,17 @@ class ScriptableResourceCache : public QObject {
      * @property {number} numCached - Total number of cached resource. <em>Read-only.</em>
      * @property {number} sizeTotal - Size in bytes of all resources. <em>Read-only.</em>
      * @property {number} sizeCached - Size in bytes of all cached resources. <em>Read-only.</em>
+     * @property {number} numHits - Total number of requests for a resource that was already loaded or cached. <em>Read-only.</em>
+     * @property {number} numMisses - Total number of requests for a resource that had to be loaded. <em>Read-only.</em>
+     * @property {number} numEvictions - Total number of cached resources evicted to stay within budget. <em>Read-only.</em>
      */
     Q_PROPERTY(size_t numTotal READ getNumTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t numCached READ getNumCachedResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeTotal READ getSizeTotalResources NOTIFY dirty)
     Q_PROPERTY(size_t sizeCached READ getSizeCachedResources NOTIFY dirty)
+    Q_PROPERTY(size_t numHits READ getNumHits NOTIFY dirty)
+    Q_PROPERTY(size_t numMisses READ getNumMisses NOTIFY dirty)
+    Q_PROPERTY(size_t numEvictions READ getNumEvictions NOTIFY dirty)
 
 public:
     ScriptableResourceCache(QSharedPointer<ResourceCache> resourceCache);
@@ -390,6 +428,9 @@ private:
     size_t getSizeTotalResources() const { return _resourceCache->getSizeTotalResources(); }
     size_t getNumCachedResources() const { return _resourceCache->getNumCachedResources(); }
     size_t getSizeCachedResources() const { return _resourceCache->getSizeCachedResources(); }
+    size_t getNumHits() const { return _resourceCache->getNumHits(); }
+    size_t getNumMisses() const { return _resourceCache->getNumMisses(); }
+    size_t getNumEvictions() const { return _resourceCache->getNumEvictions(); }
 };
 
 /// Base class for resources.
@@ -404,9 +445,6 @@ public:
 
     virtual QString getType() const { return "Resource"; }
 
-    /// Returns the key last used to identify this resource in the unused map.
-    int getLRUKey() const { return _lruKey; }
-
     /// Makes sure that the resource has started loading.
     void ensureLoading();
 
@@ -422,6 +460,10 @@ public:
     /// Returns the highest load priority across all owners.
     float getLoadPriority();
 
+    /// Returns the highest load priority as of the last change to the owners' priorities.  Unlike getLoadPriority,
+    /// this can be called from any thread.
+    float getCachedLoadPriority() const { return _cachedLoadPriority; }
+
     /// Checks whether the resource has loaded.
     virtual bool isLoaded() const { return _loaded; }
 
@@ -437,6 +479,9 @@ public:
     /// For loaded resources, returns the number of actual bytes (defaults to total bytes if not explicitly set).
     qint64 getBytes() const { return _bytes; }
 
+    /// For loaded resources, returns how many of the actual bytes are held in GPU memory.
+    virtual qint64 getGPUBytes() const { return 0; }
+
     /// For loading resources, returns the load progress.
     float getProgress() const { return (_bytesTotal <= 0) ? 0.0f : (float)_bytesReceived / _bytesTotal; }
     
@@ -502,6 +547,10 @@ protected:
     /// Called when the download is finished and processed, sets the number of actual bytes.
     void setSize(const qint64& bytes);
 
+    /// Queues the decoding of downloaded data on the shared decode pool, at the current load priority.
+    /// The work is dropped if this resource is released before it starts.
+    void scheduleDecode(ResourceDecodeScheduler::Type type, ResourceDecodeScheduler::Work work);
+
     /// Called when the download is finished and processed.
     /// This should be called by subclasses that override downloadFinished to mark the end of processing.
     Q_INVOKABLE void finishedLoading(bool success);
@@ -525,6 +574,7 @@ protected:
     bool _loaded = false;
 
     QHash<QPointer<QObject>, float> _loadPriorities;
+    std::atomic<float> _cachedLoadPriority { 0.0f };
     QWeakPointer<Resource> _self;
     QPointer<ResourceCache> _cache;
 
@@ -545,15 +595,20 @@ private:
     friend class ResourceCache;
     friend class ScriptableResource;
     
-    void setLRUKey(int lruKey) { _lruKey = lruKey; }
-    
     void retry();
     void reinsert();
 
+    // keeps the priority the decode workers read up to date, call whenever _loadPriorities changes
+    void updateCachedLoadPriority();
+
     bool isInScript() const { return _isInScript; }
     void setInScript(bool isInScript) { _isInScript = isInScript; }
     
-    int _lruKey{ 0 };
+    // Links and charged sizes of the resource while it is in its cache's unused list
+    Resource* _lruPrev { nullptr };
+    Resource* _lruNext { nullptr };
+    qint64 _lruBytes { 0 };
+    qint64 _lruGPUBytes { 0 };
     QTimer* _replyTimer{ nullptr };
     unsigned int _attempts{ 0 };
     static const int MAX_ATTEMPTS = 8;
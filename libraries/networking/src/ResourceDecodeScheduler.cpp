@@ -0,0 +1,213 @@
+//
+//  ResourceDecodeScheduler.cpp
+//  libraries/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourceDecodeScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QRunnable>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <StatTracker.h>
+
+#include "ResourceCache.h"
+
+namespace {
+    class DecodeRunnable : public QRunnable {
+    public:
+        DecodeRunnable(std::function<void()> function) : _function(function) {}
+        void run() override { _function(); }
+
+    private:
+        std::function<void()> _function;
+    };
+}
+
+// the application sizes the pool from the threads it hasn't reserved for anything else, until then use the minimum
+static const int DEFAULT_DECODE_THREAD_COUNT = 1;
+
+ResourceDecodeScheduler::ResourceDecodeScheduler() {
+    setThreadCount(DEFAULT_DECODE_THREAD_COUNT);
+}
+
+ResourceDecodeScheduler::~ResourceDecodeScheduler() {
+    clear();
+    waitForDone();
+}
+
+void ResourceDecodeScheduler::schedule(Type type, const QWeakPointer<Resource>& resource, float priority, Work work) {
+    DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
+
+    Lock lock(_mutex);
+    _pendingJobs[(int)type].push_back({ resource, priority, _nextSequence++, work });
+    dispatch(lock);
+}
+
+void ResourceDecodeScheduler::setThreadCount(int threadCount) {
+    threadCount = std::max(threadCount, 1);
+
+    Lock lock(_mutex);
+    _threadPool.setMaxThreadCount(threadCount);
+
+    // each type can use all but one thread, so that there is always room for the other type
+    _concurrencyLimits.fill(std::max(threadCount - 1, 1));
+    dispatch(lock);
+}
+
+void ResourceDecodeScheduler::setConcurrencyLimit(Type type, int limit) {
+    Lock lock(_mutex);
+    _concurrencyLimits[(int)type] = std::max(limit, 1);
+    dispatch(lock);
+}
+
+void ResourceDecodeScheduler::startDomainEntry() {
+    Lock lock(_mutex);
+    _domainEntryStart = usecTimestampNow();
+    _domainEntryFinished = false;
+    _domainEntryDecodeTime = -1;
+}
+
+void ResourceDecodeScheduler::finishDomainEntry() {
+    Lock lock(_mutex);
+    if (_domainEntryStart == 0 || _domainEntryFinished) {
+        return;
+    }
+    _domainEntryFinished = true;
+    checkDomainEntryDone();
+}
+
+void ResourceDecodeScheduler::clear() {
+    int numCancelledJobs = 0;
+    {
+        Lock lock(_mutex);
+        for (auto& jobs : _pendingJobs) {
+            numCancelledJobs += (int)jobs.size();
+            jobs.clear();
+        }
+    }
+    DependencyManager::get<StatTracker>()->updateStat("PendingProcessing", -numCancelledJobs);
+}
+
+void ResourceDecodeScheduler::waitForDone() {
+    _threadPool.waitForDone();
+}
+
+void ResourceDecodeScheduler::dispatch(Lock& lock) {
+    int numCancelledJobs = 0;
+
+    while (true) {
+        int runningJobs = 0;
+        for (auto running : _runningJobs) {
+            runningJobs += running;
+        }
+        if (runningJobs >= _threadPool.maxThreadCount()) {
+            break;
+        }
+
+        // pick the highest priority job among the types that are still under their limit
+        int nextType = -1;
+        int nextIndex = -1;
+        for (int type = 0; type < (int)Type::NUM_TYPES; ++type) {
+            if (_runningJobs[type] >= _concurrencyLimits[type]) {
+                continue;
+            }
+            int index = findNextJob(_pendingJobs[type], numCancelledJobs);
+            if (index == -1) {
+                continue;
+            }
+            if (nextType == -1 || runsBefore(_pendingJobs[type][index], _pendingJobs[nextType][nextIndex])) {
+                nextType = type;
+                nextIndex = index;
+            }
+        }
+        if (nextType == -1) {
+            break;
+        }
+
+        auto& jobs = _pendingJobs[nextType];
+        Job job = std::move(jobs[nextIndex]);
+        if (nextIndex != (int)jobs.size() - 1) {
+            jobs[nextIndex] = std::move(jobs.back());
+        }
+        jobs.pop_back();
+        ++_runningJobs[nextType];
+
+        auto type = (Type)nextType;
+        _threadPool.start(new DecodeRunnable([this, type, job] {
+            run(type, job);
+        }));
+    }
+
+    if (numCancelledJobs > 0) {
+        lock.unlock();
+        DependencyManager::get<StatTracker>()->updateStat("PendingProcessing", -numCancelledJobs);
+        lock.lock();
+    }
+
+    checkDomainEntryDone();
+}
+
+void ResourceDecodeScheduler::run(Type type, Job job) {
+    DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
+
+    // the resource may have been released while the job was waiting for a thread
+    if (!job.resource.isNull()) {
+        CounterStat counter("Processing");
+        job.work();
+    }
+
+    // release what the work captured before picking the next job
+    job.work = Work();
+
+    Lock lock(_mutex);
+    --_runningJobs[(int)type];
+    dispatch(lock);
+}
+
+int ResourceDecodeScheduler::findNextJob(JobQueue& jobs, int& numCancelledJobs) {
+    int nextIndex = -1;
+    for (int i = 0; i < (int)jobs.size();) {
+        // drop the work of resources that don't exist anymore
+        auto resource = jobs[i].resource.lock();
+        if (!resource) {
+            if (i != (int)jobs.size() - 1) {
+                jobs[i] = std::move(jobs.back());
+            }
+            jobs.pop_back();
+            ++numCancelledJobs;
+            continue;
+        }
+
+        // the priority of a resource changes as the camera moves, so read it again rather than using the queued one.
+        // The priorities themselves belong to the resource's thread, so only read the copy it keeps for other threads.
+        jobs[i].priority = resource->getCachedLoadPriority();
+        if (nextIndex == -1 || runsBefore(jobs[i], jobs[nextIndex])) {
+            nextIndex = i;
+        }
+        i++;
+    }
+    return nextIndex;
+}
+
+void ResourceDecodeScheduler::checkDomainEntryDone() {
+    if (_domainEntryStart == 0 || !_domainEntryFinished) {
+        return;
+    }
+
+    for (int type = 0; type < (int)Type::NUM_TYPES; ++type) {
+        if (_runningJobs[type] > 0 || !_pendingJobs[type].empty()) {
+            return;
+        }
+    }
+
+    _domainEntryDecodeTime = (int64_t)((usecTimestampNow() - _domainEntryStart) / USECS_PER_MSEC);
+    _domainEntryStart = 0;
+}
@@ -0,0 +1,99 @@
+//
+//  ResourceDecodeScheduler.h
+//  libraries/networking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ResourceDecodeScheduler_h
+#define hifi_ResourceDecodeScheduler_h
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
+#include <QtCore/QWeakPointer>
+
+class Resource;
+
+// Runs the heavy decoding of downloaded resources (geometry parsing, image conversion, KTX mips) on its own
+// thread pool, instead of the global one where they compete with each other and everything else.
+// Work runs by descending resource load priority, which is read again every time a job is picked, work for resources
+// that were released in the meantime is dropped, and each type of work is limited so that a burst of one type can't
+// starve the other.
+class ResourceDecodeScheduler {
+public:
+    enum class Type {
+        Model = 0,
+        Texture,
+
+        NUM_TYPES
+    };
+    using Work = std::function<void()>;
+
+    ResourceDecodeScheduler();
+    ~ResourceDecodeScheduler();
+
+    void schedule(Type type, const QWeakPointer<Resource>& resource, float priority, Work work);
+
+    // Sizes the pool, and resets the limit of each type to all but one of the threads
+    void setThreadCount(int threadCount);
+    int getThreadCount() const { return _threadPool.maxThreadCount(); }
+
+    void setConcurrencyLimit(Type type, int limit);
+    int getConcurrencyLimit(Type type) const { return _concurrencyLimits[(int)type]; }
+
+    // Restarts the domain entry clock
+    void startDomainEntry();
+    // Marks the domain as loaded, the clock stops once the decode queue has drained after that
+    void finishDomainEntry();
+
+    // Time from the start of the domain entry until the decoding of the loaded domain completed, -1 while still loading
+    int64_t getDomainEntryDecodeTime() const { return _domainEntryDecodeTime; }
+
+    // Drops all the pending work
+    void clear();
+    // Blocks until the running work has completed
+    void waitForDone();
+
+private:
+    struct Job {
+        QWeakPointer<Resource> resource;
+        float priority;
+        uint64_t sequence;
+        Work work;
+    };
+    // highest priority first, then first scheduled first
+    static bool runsBefore(const Job& a, const Job& b) {
+        return a.priority > b.priority || (a.priority == b.priority && a.sequence < b.sequence);
+    }
+    using JobQueue = std::vector<Job>;
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+
+    void dispatch(Lock& lock);
+    void run(Type type, Job job);
+    int findNextJob(JobQueue& jobs, int& numCancelledJobs);
+    void checkDomainEntryDone();
+
+    Mutex _mutex;
+    std::array<JobQueue, (int)Type::NUM_TYPES> _pendingJobs;
+    std::array<int, (int)Type::NUM_TYPES> _runningJobs {{ 0, 0 }};
+    std::array<int, (int)Type::NUM_TYPES> _concurrencyLimits;
+    uint64_t _nextSequence { 0 };
+
+    uint64_t _domainEntryStart { 0 };
+    bool _domainEntryFinished { false };
+    std::atomic<int64_t> _domainEntryDecodeTime { -1 };
+
+    QThreadPool _threadPool;
+};
+
+#endif // hifi_ResourceDecodeScheduler_h
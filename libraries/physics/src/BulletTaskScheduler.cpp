@@ -0,0 +1,57 @@
+//
+//  BulletTaskScheduler.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BulletTaskScheduler.h"
+
+#include <algorithm>
+#include <functional>
+
+#include <QtCore/QThread>
+
+#include <LinearMath/btQuickprof.h>
+#include <TBBHelpers.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_arena.h>
+
+BulletTaskScheduler::BulletTaskScheduler() : btITaskScheduler("TBB") {
+    setNumThreads(getMaxNumThreads());
+}
+
+BulletTaskScheduler::~BulletTaskScheduler() {
+}
+
+int BulletTaskScheduler::getMaxNumThreads() const {
+    // Bullet keeps per thread data for at most BT_MAX_THREAD_COUNT threads
+    return std::min(std::max(1, QThread::idealThreadCount()), (int)BT_MAX_THREAD_COUNT);
+}
+
+void BulletTaskScheduler::setNumThreads(int numThreads) {
+    _numThreads = std::min(std::max(1, numThreads), getMaxNumThreads());
+    _arena.reset(new tbb::task_arena(_numThreads));
+}
+
+void BulletTaskScheduler::parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) {
+    BT_PROFILE("parallelFor");
+    _arena->execute([&] {
+        tbb::parallel_for(tbb::blocked_range<int>(iBegin, iEnd, grainSize), [&](const tbb::blocked_range<int>& range) {
+            body.forLoop(range.begin(), range.end());
+        }, tbb::simple_partitioner());
+    });
+}
+
+btScalar BulletTaskScheduler::parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) {
+    BT_PROFILE("parallelSum");
+    return _arena->execute([&] {
+        return tbb::parallel_reduce(tbb::blocked_range<int>(iBegin, iEnd, grainSize), btScalar(0.0f),
+            [&](const tbb::blocked_range<int>& range, btScalar sum) {
+                return sum + body.sumLoop(range.begin(), range.end());
+            }, std::plus<btScalar>(), tbb::simple_partitioner());
+    });
+}
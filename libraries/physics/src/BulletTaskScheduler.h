@@ -0,0 +1,41 @@
+//
+//  BulletTaskScheduler.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BulletTaskScheduler_h
+#define hifi_BulletTaskScheduler_h
+
+#include <memory>
+
+#include <LinearMath/btThreads.h>
+
+namespace tbb {
+    class task_arena;
+}
+
+// Runs Bullet's parallel loops (island solving, integration) as TBB tasks, so that the physics simulation
+// shares its worker threads with the rest of the application instead of starting a pool of its own.
+class BulletTaskScheduler : public btITaskScheduler {
+public:
+    BulletTaskScheduler();
+    ~BulletTaskScheduler() override;
+
+    int getMaxNumThreads() const override;
+    int getNumThreads() const override { return _numThreads; }
+    void setNumThreads(int numThreads) override;
+
+    void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override;
+    btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override;
+
+private:
+    int _numThreads { 1 };
+    std::unique_ptr<tbb::task_arena> _arena;
+};
+
+#endif // hifi_BulletTaskScheduler_h
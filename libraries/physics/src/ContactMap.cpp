@@ -0,0 +1,255 @@
+//
+//  ContactMap.cpp
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContactMap.h"
+
+#include <assert.h>
+
+#include <algorithm>
+
+const int32_t ContactMap::NONE;
+
+static const size_t MIN_NUM_SLOTS = 16;
+
+// keep at least a quarter of the slots empty so that probe sequences stay short
+static bool needsMoreSlots(size_t numUsed, size_t numSlots) {
+    return (numUsed + 1) * 4 > numSlots * 3;
+}
+
+size_t ContactMap::hashObject(const void* object) {
+    // pointers are aligned and allocated close together, so mix all of their bits into the low ones
+    uint64_t hash = (uint64_t)(uintptr_t)object;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return (size_t)hash;
+}
+
+size_t ContactMap::hashKey(const ContactKey& key) {
+    return hashObject(key._a) ^ (hashObject(key._b) * 0x9e3779b97f4a7c15ULL);
+}
+
+ContactInfo& ContactMap::operator[](const ContactKey& key) {
+    assert(key._a != key._b);
+    if (needsMoreSlots(_entries.size(), _keySlots.size())) {
+        growKeySlots();
+    }
+    int32_t slot = findKeySlot(key);
+    if (_keySlots[slot] != NONE) {
+        return _entries[_keySlots[slot]].contact;
+    }
+
+    int32_t index = (int32_t)_entries.size();
+    _entries.emplace_back(key);
+    _keySlots[slot] = index;
+    link(index, key._a);
+    link(index, key._b);
+    return _entries[index].contact;
+}
+
+bool ContactMap::contains(const ContactKey& key) const {
+    return !_keySlots.empty() && _keySlots[findKeySlot(key)] != NONE;
+}
+
+void ContactMap::removeAt(int index) {
+    assert(index >= 0 && index < size());
+    const ContactKey key = _entries[index].key;
+    unlink(index, key._a);
+    unlink(index, key._b);
+    removeKeySlot(findKeySlot(key));
+
+    // fill the gap with the last entry
+    int32_t last = (int32_t)_entries.size() - 1;
+    if (index != last) {
+        const ContactKey lastKey = _entries[last].key;
+        _keySlots[findKeySlot(lastKey)] = index;
+        _entries[index] = _entries[last];
+        relink(index, lastKey._a);
+        relink(index, lastKey._b);
+    }
+    _entries.pop_back();
+}
+
+void ContactMap::removeObject(const void* object) {
+    if (_objectSlots.empty()) {
+        return;
+    }
+    while (true) {
+        // look the slot up again each time, removing the last contact of an object also removes its slot
+        const ObjectSlot& slot = _objectSlots[findObjectSlot(object)];
+        if (slot.firstEntry == NONE) {
+            break;
+        }
+        removeAt(slot.firstEntry);
+    }
+}
+
+int ContactMap::getNumContacts(const void* object) const {
+    if (_objectSlots.empty()) {
+        return 0;
+    }
+    int numContacts = 0;
+    int32_t index = _objectSlots[findObjectSlot(object)].firstEntry;
+    while (index != NONE) {
+        ++numContacts;
+        const Entry& entry = _entries[index];
+        index = entry.key._a == object ? entry.nextA : entry.nextB;
+    }
+    return numContacts;
+}
+
+void ContactMap::clear() {
+    _entries.clear();
+    std::fill(_keySlots.begin(), _keySlots.end(), NONE);
+    std::fill(_objectSlots.begin(), _objectSlots.end(), ObjectSlot());
+    _numObjects = 0;
+}
+
+int32_t ContactMap::findKeySlot(const ContactKey& key) const {
+    // returns the slot holding key or, if there is none, the empty slot where it belongs
+    size_t mask = _keySlots.size() - 1;
+    size_t slot = hashKey(key) & mask;
+    while (_keySlots[slot] != NONE && !(_entries[_keySlots[slot]].key == key)) {
+        slot = (slot + 1) & mask;
+    }
+    return (int32_t)slot;
+}
+
+int32_t ContactMap::findObjectSlot(const void* object) const {
+    size_t mask = _objectSlots.size() - 1;
+    size_t slot = hashObject(object) & mask;
+    while (_objectSlots[slot].firstEntry != NONE && _objectSlots[slot].object != object) {
+        slot = (slot + 1) & mask;
+    }
+    return (int32_t)slot;
+}
+
+void ContactMap::removeKeySlot(int32_t slot) {
+    // shift back the entries that follow in the probe sequence, so lookups never need tombstones
+    size_t mask = _keySlots.size() - 1;
+    size_t hole = (size_t)slot;
+    size_t next = (hole + 1) & mask;
+    while (_keySlots[next] != NONE) {
+        size_t home = hashKey(_entries[_keySlots[next]].key) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            _keySlots[hole] = _keySlots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    _keySlots[hole] = NONE;
+}
+
+void ContactMap::removeObjectSlot(int32_t slot) {
+    size_t mask = _objectSlots.size() - 1;
+    size_t hole = (size_t)slot;
+    size_t next = (hole + 1) & mask;
+    while (_objectSlots[next].firstEntry != NONE) {
+        size_t home = hashObject(_objectSlots[next].object) & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            _objectSlots[hole] = _objectSlots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    _objectSlots[hole] = ObjectSlot();
+    --_numObjects;
+}
+
+void ContactMap::growKeySlots() {
+    _keySlots.assign(std::max(MIN_NUM_SLOTS, _keySlots.size() * 2), NONE);
+    size_t mask = _keySlots.size() - 1;
+    for (int32_t i = 0; i < (int32_t)_entries.size(); ++i) {
+        size_t slot = hashKey(_entries[i].key) & mask;
+        while (_keySlots[slot] != NONE) {
+            slot = (slot + 1) & mask;
+        }
+        _keySlots[slot] = i;
+    }
+}
+
+void ContactMap::growObjectSlots() {
+    std::vector<ObjectSlot> oldSlots(std::max(MIN_NUM_SLOTS, _objectSlots.size() * 2));
+    oldSlots.swap(_objectSlots);
+    size_t mask = _objectSlots.size() - 1;
+    for (auto& oldSlot : oldSlots) {
+        if (oldSlot.firstEntry != NONE) {
+            size_t slot = hashObject(oldSlot.object) & mask;
+            while (_objectSlots[slot].firstEntry != NONE) {
+                slot = (slot + 1) & mask;
+            }
+            _objectSlots[slot] = oldSlot;
+        }
+    }
+}
+
+int32_t& ContactMap::getPrevious(int32_t index, const void* object) {
+    Entry& entry = _entries[index];
+    return entry.key._a == object ? entry.previousA : entry.previousB;
+}
+
+int32_t& ContactMap::getNext(int32_t index, const void* object) {
+    Entry& entry = _entries[index];
+    return entry.key._a == object ? entry.nextA : entry.nextB;
+}
+
+void ContactMap::setFirstEntry(const void* object, int32_t index) {
+    int32_t slot = findObjectSlot(object);
+    assert(_objectSlots[slot].firstEntry != NONE);
+    if (index == NONE) {
+        removeObjectSlot(slot);
+    } else {
+        _objectSlots[slot].firstEntry = index;
+    }
+}
+
+void ContactMap::link(int32_t index, const void* object) {
+    // push the entry onto the front of the object's list
+    if (needsMoreSlots(_numObjects, _objectSlots.size())) {
+        growObjectSlots();
+    }
+    ObjectSlot& slot = _objectSlots[findObjectSlot(object)];
+    if (slot.firstEntry == NONE) {
+        slot.object = object;
+        ++_numObjects;
+    } else {
+        getPrevious(slot.firstEntry, object) = index;
+    }
+    getPrevious(index, object) = NONE;
+    getNext(index, object) = slot.firstEntry;
+    slot.firstEntry = index;
+}
+
+void ContactMap::unlink(int32_t index, const void* object) {
+    int32_t previous = getPrevious(index, object);
+    int32_t next = getNext(index, object);
+    if (previous != NONE) {
+        getNext(previous, object) = next;
+    } else {
+        setFirstEntry(object, next);
+    }
+    if (next != NONE) {
+        getPrevious(next, object) = previous;
+    }
+}
+
+void ContactMap::relink(int32_t index, const void* object) {
+    // the entry was moved to index, point its neighbors at its new place
+    int32_t previous = getPrevious(index, object);
+    int32_t next = getNext(index, object);
+    if (previous != NONE) {
+        getNext(previous, object) = index;
+    } else {
+        setFirstEntry(object, index);
+    }
+    if (next != NONE) {
+        getPrevious(next, object) = index;
+    }
+}
@@ -0,0 +1,101 @@
+//
+//  ContactMap.h
+//  libraries/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContactMap_h
+#define hifi_ContactMap_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "ContactInfo.h"
+
+// simple class for keeping track of contacts
+class ContactKey {
+public:
+    ContactKey() = delete;
+    ContactKey(void* a, void* b) : _a(a), _b(b) {}
+    bool operator<(const ContactKey& other) const { return _a < other._a || (_a == other._a && _b < other._b); }
+    bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
+    void* _a; // ObjectMotionState pointer
+    void* _b; // ObjectMotionState pointer
+};
+
+// The contacts between pairs of objects, stored contiguously and found through an open addressing hash table.
+// Each contact is also linked into a list per object, so the contacts of one object can be removed without
+// looking at any others.  Once the arrays have grown to fit the usual number of contacts, adding and removing
+// contacts doesn't allocate.
+//
+// Removing a contact moves the last contact into its place, so when removing while iterating by index
+// the same index must be visited again.
+class ContactMap {
+public:
+    int size() const { return (int)_entries.size(); }
+    bool empty() const { return _entries.empty(); }
+
+    const ContactKey& getKey(int index) const { return _entries[index].key; }
+    ContactInfo& getContact(int index) { return _entries[index].contact; }
+
+    // the contact between the pair of objects, added if there wasn't one yet
+    ContactInfo& operator[](const ContactKey& key);
+    bool contains(const ContactKey& key) const;
+
+    void removeAt(int index);
+
+    // remove every contact with object, which can be null for objects without a motion state
+    void removeObject(const void* object);
+
+    int getNumContacts(const void* object) const;
+
+    void clear();
+
+private:
+    static const int32_t NONE = -1;
+
+    struct Entry {
+        Entry(const ContactKey& key) : key(key) {}
+        ContactKey key;
+        ContactInfo contact;
+        // neighbors in the lists of contacts of key._a and key._b
+        int32_t previousA { NONE };
+        int32_t nextA { NONE };
+        int32_t previousB { NONE };
+        int32_t nextB { NONE };
+    };
+
+    struct ObjectSlot {
+        const void* object { nullptr };
+        int32_t firstEntry { NONE }; // NONE for an empty slot
+    };
+
+    static size_t hashKey(const ContactKey& key);
+    static size_t hashObject(const void* object);
+
+    int32_t findKeySlot(const ContactKey& key) const;
+    int32_t findObjectSlot(const void* object) const;
+    void removeKeySlot(int32_t slot);
+    void removeObjectSlot(int32_t slot);
+    void growKeySlots();
+    void growObjectSlots();
+
+    int32_t& getPrevious(int32_t index, const void* object);
+    int32_t& getNext(int32_t index, const void* object);
+    void setFirstEntry(const void* object, int32_t index);
+    void link(int32_t index, const void* object);
+    void unlink(int32_t index, const void* object);
+    void relink(int32_t index, const void* object);
+
+    std::vector<Entry> _entries;
+    std::vector<int32_t> _keySlots; // index into _entries or NONE, the size is a power of two
+    std::vector<ObjectSlot> _objectSlots; // the size is a power of two
+    int32_t _numObjects { 0 };
+};
+
+#endif // hifi_ContactMap_h
@@ -460,7 +460,8 @@ void EntityMotionState::updateSendVelocities() {
     }
 }
 
-void EntityMotionState::sendBid(OctreeEditPacketSender* packetSender, uint32_t step) {
+void EntityMotionState::sendBid(OctreeEditPacketSender* packetSender, uint32_t step,
+        EntityEditPacketSender::EditMessageBatch* batch) {
     DETAILED_PROFILE_RANGE(simulation_physics, "Bid");
 
     updateSendVelocities();
@@ -486,7 +487,7 @@ void EntityMotionState::sendBid(OctreeEditPacketSender* packetSender, uint32_t s
 
     EntityItemID id(_entity->getID());
     EntityEditPacketSender* entityPacketSender = static_cast<EntityEditPacketSender*>(packetSender);
-    entityPacketSender->queueEditEntityMessage(PacketType::EntityPhysics, tree, id, properties);
+    entityPacketSender->queueEditEntityMessage(PacketType::EntityPhysics, tree, id, properties, batch);
 
     // NOTE: we don't descend to children for ownership bid.  Instead, if we win ownership of the parent
     // then in sendUpdate() we'll walk descendents and send updates for their QueryAACubes if necessary.
@@ -500,7 +501,8 @@ void EntityMotionState::sendBid(OctreeEditPacketSender* packetSender, uint32_t s
     _bumpedPriority = 0;
 }
 
-void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_t step) {
+void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_t step,
+        EntityEditPacketSender::EditMessageBatch* batch) {
     DETAILED_PROFILE_RANGE(simulation_physics, "Send");
     assert(isLocallyOwned());
 
@@ -570,7 +572,7 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
     properties.setEntityHostType(_entity->getEntityHostType());
     properties.setOwningAvatarID(_entity->getOwningAvatarID());
 
-    entityPacketSender->queueEditEntityMessage(PacketType::EntityPhysics, tree, id, properties);
+    entityPacketSender->queueEditEntityMessage(PacketType::EntityPhysics, tree, id, properties, batch);
     _entity->setLastBroadcast(now); // for debug/physics status icons
 
     // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
@@ -586,7 +588,7 @@ void EntityMotionState::sendUpdate(OctreeEditPacketSender* packetSender, uint32_
                 newQueryCubeProperties.setOwningAvatarID(entityDescendant->getOwningAvatarID());
 
                 entityPacketSender->queueEditEntityMessage(PacketType::EntityPhysics, tree,
-                                                           descendant->getID(), newQueryCubeProperties);
+                                                           descendant->getID(), newQueryCubeProperties, batch);
                 entityDescendant->setLastBroadcast(now); // for debug/physics status icons
             }
         }
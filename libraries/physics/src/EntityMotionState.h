@@ -12,6 +12,7 @@
 #ifndef hifi_EntityMotionState_h
 #define hifi_EntityMotionState_h
 
+#include <EntityEditPacketSender.h>
 #include <EntityItem.h>
 #include <EntityTypes.h>
 #include <AACube.h>
@@ -52,8 +53,9 @@ public:
     virtual void setWorldTransform(const btTransform& worldTrans) override;
 
     bool shouldSendUpdate(uint32_t simulationStep);
-    void sendBid(OctreeEditPacketSender* packetSender, uint32_t step);
-    void sendUpdate(OctreeEditPacketSender* packetSender, uint32_t step);
+    // when batch is given the edits are appended to it rather than queued on packetSender
+    void sendBid(OctreeEditPacketSender* packetSender, uint32_t step, EntityEditPacketSender::EditMessageBatch* batch = nullptr);
+    void sendUpdate(OctreeEditPacketSender* packetSender, uint32_t step, EntityEditPacketSender::EditMessageBatch* batch = nullptr);
 
     virtual uint32_t getIncomingDirtyFlags() const override;
     virtual void clearIncomingDirtyFlags(uint32_t mask = DIRTY_PHYSICS_FLAGS) override;
@@ -156,6 +158,7 @@ protected:
     uint8_t _numInactiveUpdates { 1 };
     uint8_t _bumpedPriority { 0 }; // the target simulation priority according to collision history
     uint8_t _region { workload::Region::INVALID };
+    bool _isDirtyOwned { false }; // is on PhysicalEntitySimulation's list of owned objects to check this step
 
     bool isServerlessMode();
 };
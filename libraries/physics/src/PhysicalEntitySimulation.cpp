@@ -86,6 +86,10 @@ void PhysicalEntitySimulation::removeEntityInternal(EntityItemPointer entity) {
 
 void PhysicalEntitySimulation::removeOwnershipData(EntityMotionState* motionState) {
     assert(motionState);
+    if (motionState->_isDirtyOwned) {
+        _dirtyOwned.removeFirst(motionState);
+        motionState->_isDirtyOwned = false;
+    }
     if (motionState->getOwnershipState() == EntityMotionState::OwnershipState::LocallyOwned) {
         for (uint32_t i = 0; i < _owned.size(); ++i) {
             if (_owned[i] == motionState) {
@@ -104,6 +108,10 @@ void PhysicalEntitySimulation::removeOwnershipData(EntityMotionState* motionStat
 }
 
 void PhysicalEntitySimulation::clearOwnershipData() {
+    for (uint32_t i = 0; i < _dirtyOwned.size(); ++i) {
+        _dirtyOwned[i]->_isDirtyOwned = false;
+    }
+    _dirtyOwned.clear();
     for (uint32_t i = 0; i < _owned.size(); ++i) {
         _owned[i]->clearOwnershipState();
     }
@@ -258,7 +266,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                         // bummer, the hashes are different and we no longer want the shape we've received
                         ObjectMotionState::getShapeManager()->releaseShape(shape);
                         // try again
-                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                        shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo, true));
                         if (shape) {
                             buildMotionState(shape, entity);
                             requestItr = _shapeRequests.erase(requestItr);
@@ -312,7 +320,7 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
                 ShapeInfo shapeInfo;
                 entity->computeShapeInfo(shapeInfo);
                 uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo, true));
                 if (shape) {
                     EntityMotionState* motionState = static_cast<EntityMotionState*>(entity->getPhysicsInfo());
                     if (!motionState) {
@@ -366,6 +374,10 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
     // motionStates with changed entities: delete, add, or change
     for (auto& object : _incomingChanges) {
         uint32_t unhandledFlags = object->getIncomingDirtyFlags();
+        if (object->getOwnershipState() == EntityMotionState::OwnershipState::LocallyOwned) {
+            // something other than the simulation changed this object so it may need an update, or we may have lost it
+            addDirtyOwned(object);
+        }
 
         uint32_t handledFlags = EASY_DIRTY_PHYSICS_FLAGS;
         bool isInPhysicsSimulation = object->isInPhysicsSimulation();
@@ -377,41 +389,27 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
 
         bool needsNewShape = object->needsNewShape();
         if (needsNewShape) {
-            ShapeType shapeType = object->getShapeType();
-            if (shapeType == SHAPE_TYPE_STATIC_MESH) {
-                ShapeRequest shapeRequest(object->_entity);
-                ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
-                if (requestItr == _shapeRequests.end()) {
-                    ShapeInfo shapeInfo;
-                    object->_entity->computeShapeInfo(shapeInfo);
-                    uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
-                    btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
-                    if (shape) {
-                        object->setShape(shape);
-                        handledFlags |= Simulation::DIRTY_SHAPE;
-                        needsNewShape = false;
-                    } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
-                        // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
-                        shapeRequest.shapeHash = shapeInfo.getHash();
-                        _shapeRequests.insert(shapeRequest);
-                    } else {
-                        // failed to build shape --> will not be added/updated
-                        handledFlags |= Simulation::DIRTY_SHAPE;
-                    }
-                } else {
-                    // continue waiting for shape request
-                }
-            } else {
+            ShapeRequest shapeRequest(object->_entity);
+            ShapeRequests::iterator  requestItr = _shapeRequests.find(shapeRequest);
+            if (requestItr == _shapeRequests.end()) {
                 ShapeInfo shapeInfo;
                 object->_entity->computeShapeInfo(shapeInfo);
-                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo));
+                uint32_t requestCount = ObjectMotionState::getShapeManager()->getWorkRequestCount();
+                btCollisionShape* shape = const_cast<btCollisionShape*>(ObjectMotionState::getShapeManager()->getShape(shapeInfo, true));
                 if (shape) {
                     object->setShape(shape);
                     handledFlags |= Simulation::DIRTY_SHAPE;
                     needsNewShape = false;
+                } else if (requestCount != ObjectMotionState::getShapeManager()->getWorkRequestCount()) {
+                    // shape doesn't exist but a new worker has been spawned to build it --> add to shapeRequests and wait
+                    shapeRequest.shapeHash = shapeInfo.getHash();
+                    _shapeRequests.insert(shapeRequest);
                 } else {
-                    // failed to build shape --> will not be added
+                    // failed to build shape --> will not be added/updated
+                    handledFlags |= Simulation::DIRTY_SHAPE;
                 }
+            } else {
+                // continue waiting for shape request
             }
         }
         if (!isInPhysicsSimulation) {
@@ -443,6 +441,8 @@ void PhysicalEntitySimulation::handleProcessedPhysicsTransaction(PhysicsEngine::
     // things on objectsToRemove are ready for delete
     for (auto object : transaction.objectsToRemove) {
         _physicalObjects.remove(object);
+        // make sure no ownership list is left pointing at it
+        removeOwnershipData(static_cast<EntityMotionState*>(object));
         delete object;
     }
     transaction.clear();
@@ -473,6 +473,10 @@ void PhysicalEntitySimulation::handleDeactivatedMotionStates(const VectorOfMotio
                     }
                 } else {
                     entityState->handleDeactivation();
+                    if (entityState->getOwnershipState() == EntityMotionState::OwnershipState::LocallyOwned) {
+                        // the server should hear that it has stopped
+                        addDirtyOwned(entityState);
+                    }
                 }
             }
         }
@@ -499,6 +503,8 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
                 } else if (entityState->shouldSendBid()) {
                     addOwnershipBid(entityState);
                 }
+            } else if (entityState->getOwnershipState() == EntityMotionState::OwnershipState::LocallyOwned) {
+                addDirtyOwned(entityState);
             }
         }
     }
@@ -515,6 +521,8 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
         sendOwnedUpdates(numSubsteps);
         sendOwnershipBids(numSubsteps);
     }
+    // bids made above that weren't flushed by the senders
+    _entityPacketSender->queueEditMessageBatch(_outgoingEdits);
 }
 
 void PhysicalEntitySimulation::addOwnershipBid(EntityMotionState* motionState) {
@@ -522,7 +530,7 @@ void PhysicalEntitySimulation::addOwnershipBid(EntityMotionState* motionState) {
         return;
     }
     motionState->initForBid();
-    motionState->sendBid(_entityPacketSender, _physicsEngine->getNumSubsteps());
+    motionState->sendBid(_entityPacketSender, _physicsEngine->getNumSubsteps(), &_outgoingEdits);
     _bids.push_back(motionState);
     _nextBidExpiry = glm::min(_nextBidExpiry, motionState->getNextBidExpiry());
 }
@@ -533,6 +541,15 @@ void PhysicalEntitySimulation::addOwnership(EntityMotionState* motionState) {
     }
     motionState->initForOwned();
     _owned.push_back(motionState);
+    addDirtyOwned(motionState);
+}
+
+// private helper method
+void PhysicalEntitySimulation::addDirtyOwned(EntityMotionState* motionState) {
+    if (!motionState->_isDirtyOwned) {
+        motionState->_isDirtyOwned = true;
+        _dirtyOwned.push_back(motionState);
+    }
 }
 
 void PhysicalEntitySimulation::sendOwnershipBids(uint32_t numSubsteps) {
@@ -549,7 +566,7 @@ void PhysicalEntitySimulation::sendOwnershipBids(uint32_t numSubsteps) {
                 // therefore we need to immediately send an update so that the values stored are what we're
                 // "telling" the server rather than what we've been "hearing" from the server.
                 _bids[i]->slaveBidPriority();
-                _bids[i]->sendUpdate(_entityPacketSender, numSubsteps);
+                _bids[i]->sendUpdate(_entityPacketSender, numSubsteps, &_outgoingEdits);
 
                 addOwnership(_bids[i]);
                 removeBid = true;
@@ -561,36 +578,54 @@ void PhysicalEntitySimulation::sendOwnershipBids(uint32_t numSubsteps) {
                 _bids.remove(i);
             } else {
                 if (now > _bids[i]->getNextBidExpiry()) {
-                    _bids[i]->sendBid(_entityPacketSender, numSubsteps);
+                    _bids[i]->sendBid(_entityPacketSender, numSubsteps, &_outgoingEdits);
                     _nextBidExpiry = glm::min(_nextBidExpiry, _bids[i]->getNextBidExpiry());
                 }
                 ++i;
             }
         }
     }
+    _entityPacketSender->queueEditMessageBatch(_outgoingEdits);
 }
 
+// how often sendOwnedUpdates() checks owned objects that haven't moved
+const uint64_t USECS_BETWEEN_OWNED_SWEEPS = USECS_PER_SECOND / 10;
+
 void PhysicalEntitySimulation::sendOwnedUpdates(uint32_t numSubsteps) {
     if (getEntityTree()->isServerlessMode()) {
         return;
     }
-    PROFILE_RANGE_EX(simulation_physics, "Update", 0x00000000, (uint64_t)_owned.size());
-    uint32_t i = 0;
-    while (i < _owned.size()) {
-        if (!_owned[i]->isLocallyOwned()) {
-            if (_owned[i]->shouldSendBid()) {
-                addOwnershipBid(_owned[i]);
+    // Only owned objects that moved, changed, or stopped since the last step are on _dirtyOwned, but sleeping objects
+    // still need the occasional update (inactive resends, ownership refresh) so every so often we check them all.
+    uint64_t now = usecTimestampNow();
+    if (now > _nextOwnedSweep) {
+        _nextOwnedSweep = now + USECS_BETWEEN_OWNED_SWEEPS;
+        for (uint32_t i = 0; i < _owned.size(); ++i) {
+            addDirtyOwned(_owned[i]);
+        }
+    }
+
+    PROFILE_RANGE_EX(simulation_physics, "Update", 0x00000000, (uint64_t)_dirtyOwned.size());
+    for (uint32_t i = 0; i < _dirtyOwned.size(); ++i) {
+        EntityMotionState* motionState = _dirtyOwned[i];
+        motionState->_isDirtyOwned = false;
+        if (motionState->getOwnershipState() != EntityMotionState::OwnershipState::LocallyOwned) {
+            // already taken off _owned since it was marked
+            continue;
+        }
+        if (!motionState->isLocallyOwned()) {
+            _owned.removeFirst(motionState);
+            if (motionState->shouldSendBid()) {
+                addOwnershipBid(motionState);
             } else {
-                _owned[i]->clearOwnershipState();
-            }
-            _owned.remove(i);
-        } else {
-            if (_owned[i]->shouldSendUpdate(numSubsteps)) {
-                _owned[i]->sendUpdate(_entityPacketSender, numSubsteps);
+                motionState->clearOwnershipState();
             }
-            ++i;
+        } else if (motionState->shouldSendUpdate(numSubsteps)) {
+            motionState->sendUpdate(_entityPacketSender, numSubsteps, &_outgoingEdits);
         }
     }
+    _dirtyOwned.clear();
+    _entityPacketSender->queueEditMessageBatch(_outgoingEdits);
 }
 
 void PhysicalEntitySimulation::handleCollisionEvents(const CollisionEvents& collisionEvents) {
@@ -97,6 +97,7 @@ public:
 
 private:
     void buildMotionStatesForEntitiesThatNeedThem();
+    void addDirtyOwned(EntityMotionState* motionState);
 
     class ShapeRequest {
     public:
@@ -119,10 +120,13 @@ private:
     EntityEditPacketSender* _entityPacketSender = nullptr;
 
     VectorOfEntityMotionStates _owned;
+    VectorOfEntityMotionStates _dirtyOwned; // subset of _owned that may need an update sent this step
     VectorOfEntityMotionStates _bids;
+    EntityEditPacketSender::EditMessageBatch _outgoingEdits;
     SetOfEntities _deadAvatarEntities;
     workload::SpacePointer _space;
     uint64_t _nextBidExpiry;
+    uint64_t _nextOwnedSweep { 0 };
     uint32_t _lastStepSendPackets { 0 };
     uint32_t _lastWorkDeliveryCount { 0 };
 };
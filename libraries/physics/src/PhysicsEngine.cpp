@@ -20,6 +20,7 @@
 #include <Profile.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
 
+#include "BulletTaskScheduler.h"
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
 #include "PhysicsHelpers.h"
@@ -64,10 +65,16 @@ PhysicsEngine::~PhysicsEngine() {
 
 void PhysicsEngine::init() {
     if (!_dynamicsWorld) {
+        // the world needs a task scheduler, even when it only runs sequentially
+        setMultithreaded(_isMultithreaded);
+
         _collisionConfig = new btDefaultCollisionConfiguration();
+        // NOTE: we keep the single threaded dispatcher: btCollisionDispatcherMt adds new manifolds in whatever
+        // order the worker threads finish, and updateContactMap() relies on that order being stable.
         _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
+        // one solver per thread which may be solving an island at the same time
+        _constraintSolver = new btConstraintSolverPoolMt(BT_MAX_THREAD_COUNT);
         _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
@@ -310,15 +317,7 @@ void PhysicsEngine::processTransaction(PhysicsEngine::Transaction& transaction)
 }
 
 void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
-    // trigger events for new/existing/old contacts
-    ContactMap::iterator contactItr = _contactMap.begin();
-    while (contactItr != _contactMap.end()) {
-        if (contactItr->first._a == motionState || contactItr->first._b == motionState) {
-            contactItr = _contactMap.erase(contactItr);
-        } else {
-            ++contactItr;
-        }
-    }
+    _contactMap.removeObject(motionState);
 }
 
 void PhysicsEngine::stepSimulation() {
@@ -595,17 +594,17 @@ const CollisionEvents& PhysicsEngine::getCollisionEvents() {
     _collisionEvents.clear();
 
     // scan known contacts and trigger events
-    ContactMap::iterator contactItr = _contactMap.begin();
-
-    while (contactItr != _contactMap.end()) {
-        ContactInfo& contact = contactItr->second;
+    int contactIndex = 0;
+    while (contactIndex < _contactMap.size()) {
+        const ContactKey& key = _contactMap.getKey(contactIndex);
+        ContactInfo& contact = _contactMap.getContact(contactIndex);
         ContactEventType type = contact.computeType(_numContactFrames);
         const btScalar SIGNIFICANT_DEPTH = -0.002f; // penetrations have negative distance
         if (type != CONTACT_EVENT_TYPE_CONTINUE ||
                 (contact.distance < SIGNIFICANT_DEPTH &&
                  contact.readyForContinue(_numContactFrames))) {
-            ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(contactItr->first._a);
-            ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(contactItr->first._b);
+            ObjectMotionState* motionStateA = static_cast<ObjectMotionState*>(key._a);
+            ObjectMotionState* motionStateB = static_cast<ObjectMotionState*>(key._b);
 
             // NOTE: the MyAvatar RigidBody is the only object in the simulation that does NOT have a MotionState
             // which means should we ever want to report ALL collision events against the avatar we can
@@ -640,9 +639,10 @@ const CollisionEvents& PhysicsEngine::getCollisionEvents() {
         }
 
         if (type == CONTACT_EVENT_TYPE_END) {
-            contactItr = _contactMap.erase(contactItr);
+            // the last contact takes the place of this one, so look at the same index again
+            _contactMap.removeAt(contactIndex);
         } else {
-            ++contactItr;
+            ++contactIndex;
         }
     }
     return _collisionEvents;
@@ -872,6 +872,21 @@ void PhysicsEngine::setShowBulletConstraintLimits(bool value) {
     }
 }
 
+void PhysicsEngine::setMultithreaded(bool multithreaded) {
+#ifdef BT_THREADSAFE
+    // the scheduler is global to Bullet, so it is shared by every PhysicsEngine
+    static BulletTaskScheduler taskScheduler;
+    _isMultithreaded = multithreaded;
+    btSetTaskScheduler(_isMultithreaded ? static_cast<btITaskScheduler*>(&taskScheduler) : btGetSequentialTaskScheduler());
+#else
+    if (multithreaded) {
+        qCDebug(physics) << "Bullet was built without BT_THREADSAFE, physics will run on one thread";
+    }
+    _isMultithreaded = false;
+    btSetTaskScheduler(btGetSequentialTaskScheduler());
+#endif
+}
+
 void PhysicsEngine::enableGlobalContactAddedCallback(bool enabled) {
 	if (enabled) {
         // register contact filter to help MyAvatar pass through backfacing triangles
@@ -904,7 +919,9 @@ struct AllContactsCallback : public btCollisionWorld::ContactResultCallback {
     }
 
     ~AllContactsCallback() {
-        ObjectMotionState::getShapeManager()->releaseShape(collisionObject.getCollisionShape());
+        if (collisionObject.getCollisionShape()) {
+            ObjectMotionState::getShapeManager()->releaseShape(collisionObject.getCollisionShape());
+        }
     }
 
     btCollisionObject collisionObject;
@@ -970,6 +987,10 @@ std::vector<ContactTestResult> PhysicsEngine::contactTest(uint16_t mask, const S
     }
 
     auto contactCallback = AllContactsCallback((int32_t)mask, (int32_t)group, regionShapeInfo, regionTransform, myAvatarCollisionObject, threshold);
+    if (!contactCallback.collisionObject.getCollisionShape()) {
+        // the region's shape failed to build
+        return std::vector<ContactTestResult>();
+    }
     _dynamicsWorld->contactTest(&contactCallback.collisionObject, contactCallback);
 
     return contactCallback.contacts;
@@ -21,7 +21,7 @@
 #include <BulletCollision/CollisionDispatch/btGhostObject.h>
 
 #include "BulletUtil.h"
-#include "ContactInfo.h"
+#include "ContactMap.h"
 #include "ObjectMotionState.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "ObjectAction.h"
@@ -32,17 +32,6 @@ const float HALF_SIMULATION_EXTENT = 512.0f; // meters
 class CharacterController;
 class PhysicsDebugDraw;
 
-// simple class for keeping track of contacts
-class ContactKey {
-public:
-    ContactKey() = delete;
-    ContactKey(void* a, void* b) : _a(a), _b(b) {}
-    bool operator<(const ContactKey& other) const { return _a < other._a || (_a == other._a && _b < other._b); }
-    bool operator==(const ContactKey& other) const { return _a == other._a && _b == other._b; }
-    void* _a; // ObjectMotionState pointer
-    void* _b; // ObjectMotionState pointer
-};
-
 struct ContactTestResult {
     ContactTestResult() = delete;
 
@@ -69,7 +58,6 @@ struct ContactTestResult {
     glm::vec3 collisionNormal;
 };
 
-using ContactMap = std::map<ContactKey, ContactInfo>;
 using CollisionEvents = std::vector<Collision>;
 
 class PhysicsEngine {
@@ -152,6 +140,12 @@ public:
 
     void enableGlobalContactAddedCallback(bool enabled);
 
+    // Solve independent simulation islands in parallel on the TBB worker threads.  Only has an effect when Bullet
+    // was built with BT_THREADSAFE.  Contacts are still found on the calling thread, in the same order as before,
+    // so collision events and ownership bids don't depend on how the solving was split up.
+    void setMultithreaded(bool multithreaded);
+    bool isMultithreaded() const { return _isMultithreaded; }
+
 private:
     QList<EntityDynamicPointer> removeDynamicsForBody(btRigidBody* body);
     void addObjectToDynamicsWorld(ObjectMotionState* motionState);
@@ -167,7 +161,7 @@ private:
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolverPoolMt* _constraintSolver = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
@@ -188,6 +182,7 @@ private:
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
     bool _hasOutgoingChanges { false };
+    bool _isMultithreaded { false };
 
 };
 
@@ -11,23 +11,41 @@
 
 #include "ShapeFactory.h"
 
+#include <atomic>
+
 #include <glm/gtx/norm.hpp>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
 
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
+#include "PhysicsLogging.h"
+
+// hull sets with fewer points than this are quick enough to build where they are asked for
+const int32_t MAX_SYNCHRONOUS_HULL_POINTS = 1024;
 
 
 class StaticMeshShape : public btBvhTriangleMeshShape {
 public:
     StaticMeshShape() = delete;
 
-    StaticMeshShape(btTriangleIndexVertexArray* dataArray)
-    :   btBvhTriangleMeshShape(dataArray, true), _dataArray(dataArray) {
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, bool buildBvh = true)
+    :   btBvhTriangleMeshShape(dataArray, true, buildBvh), _dataArray(dataArray) {
         assert(_dataArray);
     }
 
     ~StaticMeshShape() {
+        if (_bvhBuffer) {
+            // the BVH was deserialized in place so it lives inside _bvhBuffer
+            getOptimizedBvh()->~btOptimizedBvh();
+            btAlignedFree(_bvhBuffer);
+            _bvhBuffer = nullptr;
+        }
         assert(_dataArray);
         IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
         for (int32_t i = 0; i < meshes.size(); ++i) {
@@ -44,9 +62,23 @@ public:
         _dataArray = nullptr;
     }
 
+    // takes ownership of buffer, which must hold a BVH serialized in place for this mesh
+    bool setSerializedBvh(void* buffer, uint32_t bufferSize) {
+        assert(!getOptimizedBvh());
+        btOptimizedBvh* bvh = btOptimizedBvh::deSerializeInPlace(buffer, bufferSize, false);
+        if (!bvh) {
+            btAlignedFree(buffer);
+            return false;
+        }
+        setOptimizedBvh(bvh);
+        _bvhBuffer = buffer;
+        return true;
+    }
+
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    void* _bvhBuffer { nullptr };
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -270,7 +302,100 @@ btTriangleIndexVertexArray* createStaticMeshArray(const ShapeInfo& info) {
     return dataArray;
 }
 
-const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info) {
+// A cached BVH file is this header followed by the BVH serialized in place.  The digest of the mesh data guards
+// against a model that has changed since the file was written, because a static mesh's ShapeInfo hash only covers
+// its url and extents.
+const uint32_t BVH_CACHE_MAGIC = 0x48564248; // "HBVH" in little-endian order
+const uint32_t BVH_CACHE_VERSION = 1;
+const int BVH_ALIGNMENT = 16; // btOptimizedBvh::deSerializeInPlace() needs an aligned buffer
+const int MESH_DIGEST_SIZE = 16;
+
+static std::atomic<uint32_t> bvhCacheHitCount { 0 };
+
+struct BvhCacheHeader {
+    uint32_t magic { BVH_CACHE_MAGIC };
+    uint32_t version { BVH_CACHE_VERSION };
+    uint32_t bulletVersion { BT_BULLET_VERSION };
+    uint32_t bvhSize { 0 };
+    char meshDigest[MESH_DIGEST_SIZE];
+};
+
+QByteArray computeMeshDigest(btTriangleIndexVertexArray* dataArray) {
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    const IndexedMeshArray& meshes = dataArray->getIndexedMeshArray();
+    for (int32_t i = 0; i < meshes.size(); ++i) {
+        const btIndexedMesh& mesh = meshes[i];
+        hash.addData((const char*)mesh.m_vertexBase, mesh.m_numVertices * mesh.m_vertexStride);
+        hash.addData((const char*)mesh.m_triangleIndexBase, mesh.m_numTriangles * mesh.m_triangleIndexStride);
+    }
+    QByteArray digest = hash.result();
+    assert(digest.size() == MESH_DIGEST_SIZE);
+    return digest;
+}
+
+bool loadCachedBvh(StaticMeshShape* shape, const QString& path, const QByteArray& meshDigest) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    BvhCacheHeader header;
+    if (file.read((char*)&header, sizeof(header)) != (qint64)sizeof(header)
+            || header.magic != BVH_CACHE_MAGIC
+            || header.version != BVH_CACHE_VERSION
+            || header.bulletVersion != BT_BULLET_VERSION
+            || QByteArray(header.meshDigest, MESH_DIGEST_SIZE) != meshDigest
+            || file.size() != (qint64)(sizeof(header) + header.bvhSize)) {
+        return false;
+    }
+    void* buffer = btAlignedAlloc(header.bvhSize, BVH_ALIGNMENT);
+    if (file.read((char*)buffer, header.bvhSize) != (qint64)header.bvhSize) {
+        btAlignedFree(buffer);
+        return false;
+    }
+    if (!shape->setSerializedBvh(buffer, header.bvhSize)) {
+        return false;
+    }
+    // ShapeManager prunes the least recently written files, so count this use as a write
+    file.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+    ++bvhCacheHitCount;
+    return true;
+}
+
+void saveCachedBvh(const btOptimizedBvh* bvh, const QString& path, const QByteArray& meshDigest) {
+    BvhCacheHeader header;
+    header.bvhSize = bvh->calculateSerializeBufferSize();
+    memcpy(header.meshDigest, meshDigest.constData(), MESH_DIGEST_SIZE);
+
+    void* buffer = btAlignedAlloc(header.bvhSize, BVH_ALIGNMENT);
+    if (bvh->serializeInPlace(buffer, header.bvhSize, false)) {
+        // QSaveFile only replaces the old file once the new one is complete
+        QDir().mkpath(QFileInfo(path).absolutePath());
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly)
+                || file.write((const char*)&header, sizeof(header)) != (qint64)sizeof(header)
+                || file.write((const char*)buffer, header.bvhSize) != (qint64)header.bvhSize
+                || !file.commit()) {
+            qCWarning(physics) << "failed to write collision mesh BVH cache file" << path;
+        }
+    }
+    btAlignedFree(buffer);
+}
+
+// util method
+btCollisionShape* createCachedStaticMeshShape(const ShapeInfo& info, btTriangleIndexVertexArray* dataArray,
+        const QString& bvhCacheDirectory) {
+    QString path = QDir(bvhCacheDirectory).filePath(QString("%1.bvh").arg((qulonglong)info.getHash(), 16, 16, QChar('0')));
+    QByteArray meshDigest = computeMeshDigest(dataArray);
+
+    StaticMeshShape* shape = new StaticMeshShape(dataArray, false);
+    if (!loadCachedBvh(shape, path, meshDigest)) {
+        shape->buildOptimizedBvh();
+        saveCachedBvh(shape->getOptimizedBvh(), path, meshDigest);
+    }
+    return shape;
+}
+
+const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info, const QString& bvhCacheDirectory) {
     btCollisionShape* shape = nullptr;
     int type = info.getType();
     switch(type) {
@@ -431,7 +556,11 @@ const btCollisionShape* ShapeFactory::createShapeFromInfo(const ShapeInfo& info)
         case SHAPE_TYPE_STATIC_MESH: {
             btTriangleIndexVertexArray* dataArray = createStaticMeshArray(info);
             if (dataArray) {
-                shape = new StaticMeshShape(dataArray);
+                if (bvhCacheDirectory.isEmpty()) {
+                    shape = new StaticMeshShape(dataArray);
+                } else {
+                    shape = createCachedStaticMeshShape(info, dataArray, bvhCacheDirectory);
+                }
             }
         }
         break;
@@ -488,7 +617,31 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     delete nonConstShape;
 }
 
+uint32_t ShapeFactory::getBvhCacheHitCount() {
+    return bvhCacheHitCount;
+}
+
+bool ShapeFactory::isSlowToBuild(const ShapeInfo& info) {
+    switch (info.getType()) {
+        case SHAPE_TYPE_STATIC_MESH:
+            // builds a BVH over every triangle
+            return true;
+        case SHAPE_TYPE_COMPOUND:
+        case SHAPE_TYPE_SIMPLE_HULL:
+        case SHAPE_TYPE_SIMPLE_COMPOUND: {
+            // hull building and reduction is linear in the number of points
+            int32_t numPoints = info.getTriangleIndices().size();
+            for (const auto& points : info.getPointCollection()) {
+                numPoints += points.size();
+            }
+            return numPoints > MAX_SYNCHRONOUS_HULL_POINTS;
+        }
+        default:
+            return false;
+    }
+}
+
 void ShapeFactory::Worker::run() {
-    shape = ShapeFactory::createShapeFromInfo(shapeInfo);
+    shape = ShapeFactory::createShapeFromInfo(shapeInfo, bvhCacheDirectory);
     emit submitWork(this);
 }
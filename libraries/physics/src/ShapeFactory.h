@@ -16,21 +16,30 @@
 #include <glm/glm.hpp>
 #include <QObject>
 #include <QtCore/QRunnable>
+#include <QtCore/QString>
 
 #include <ShapeInfo.h>
 
 // The ShapeFactory assembles and correctly disassembles btCollisionShapes.
 
 namespace ShapeFactory {
-    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
+    // when bvhCacheDirectory is not empty the BVHs of static meshes are read from and written to files there
+    const btCollisionShape* createShapeFromInfo(const ShapeInfo& info, const QString& bvhCacheDirectory = QString());
     void deleteShape(const btCollisionShape* shape);
 
+    // true for shapes that take too long to build on the simulation thread (static meshes and big sets of hulls)
+    bool isSlowToBuild(const ShapeInfo& info);
+
+    // number of static mesh BVHs read from the cache rather than built, since startup
+    uint32_t getBvhCacheHitCount();
+
     class Worker : public QObject, public QRunnable {
         Q_OBJECT
     public:
         Worker(const ShapeInfo& info) : shapeInfo(info), shape(nullptr) {}
         void run() override;
         ShapeInfo shapeInfo;
+        QString bvhCacheDirectory;
         const btCollisionShape* shape;
     signals:
         void submitWork(Worker*);
@@ -12,11 +12,13 @@
 #include "ShapeManager.h"
 
 #include <glm/gtx/norm.hpp>
+#include <QDir>
 #include <QThreadPool>
 
 #include <NumericalConstants.h>
 
 const int MAX_RING_SIZE = 256;
+const qint64 MAX_BVH_CACHE_SIZE = 512 * 1024 * 1024;
 
 ShapeManager::ShapeManager() {
     _garbageRing.reserve(MAX_RING_SIZE);
@@ -36,7 +38,7 @@ ShapeManager::~ShapeManager() {
     }
 }
 
-const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
+const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info, bool allowAsync) {
     if (info.getType() == SHAPE_TYPE_NONE) {
         return nullptr;
     }
@@ -47,12 +49,12 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         return shapeRef->shape;
     }
     const btCollisionShape* shape = nullptr;
-    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+    if (allowAsync && ShapeFactory::isSlowToBuild(info)) {
         uint64_t hash = info.getHash();
-        const auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), hash);
-        if (itr == _pendingMeshShapes.end()) {
+        const auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), hash);
+        if (itr == _pendingShapes.end()) {
             // start a worker
-            _pendingMeshShapes.push_back(hash);
+            _pendingShapes.push_back(hash);
             ++_workRequestCount;
             // try to recycle old deadWorker
             ShapeFactory::Worker* worker = _deadWorker;
@@ -62,6 +64,7 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
                 worker->shapeInfo = info;
                 _deadWorker = nullptr;
             }
+            worker->bvhCacheDirectory = _bvhCacheDirectory;
             // we will delete worker manually later
             worker->setAutoDelete(false);
             QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
@@ -69,7 +72,7 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         }
         // else we're still waiting for the shape to be created on another thread
     } else {
-        shape = ShapeFactory::createShapeFromInfo(info);
+        shape = ShapeFactory::createShapeFromInfo(info, _bvhCacheDirectory);
         if (shape) {
             ShapeReference newRef;
             newRef.refCount = 1;
@@ -202,10 +205,30 @@ bool ShapeManager::hasShape(const btCollisionShape* shape) const {
     return false;
 }
 
+void ShapeManager::setBvhCacheDirectory(const QString& directory) {
+    _bvhCacheDirectory = directory;
+    if (!_bvhCacheDirectory.isEmpty()) {
+        pruneBvhCache();
+    }
+}
+
+// private helper method
+void ShapeManager::pruneBvhCache() {
+    // keep the most recently used files and delete the rest once they add up to MAX_BVH_CACHE_SIZE
+    QFileInfoList files = QDir(_bvhCacheDirectory).entryInfoList({ "*.bvh" }, QDir::Files, QDir::Time);
+    qint64 cacheSize = 0;
+    for (const auto& file : files) {
+        cacheSize += file.size();
+        if (cacheSize > MAX_BVH_CACHE_SIZE) {
+            QFile::remove(file.absoluteFilePath());
+        }
+    }
+}
+
 // slot: called when ShapeFactory::Worker is done building shape
 void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
-    auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), worker->shapeInfo.getHash());
-    if (itr == _pendingMeshShapes.end()) {
+    auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), worker->shapeInfo.getHash());
+    if (itr == _pendingShapes.end()) {
         // we've received a shape but don't remember asking for it
         // (should not fall in here, but if we do: delete the unwanted shape)
         if (worker->shape) {
@@ -213,17 +236,19 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
         }
     } else {
         // clear pending status
-        *itr = _pendingMeshShapes.back();
-        _pendingMeshShapes.pop_back();
+        *itr = _pendingShapes.back();
+        _pendingShapes.pop_back();
 
-        // cache the new shape
-        if (worker->shape) {
+        // cache the new shape, unless a caller that couldn't wait has built it in the meantime
+        HashKey hashKey(worker->shapeInfo.getHash());
+        if (worker->shape && _shapeMap.find(hashKey)) {
+            ShapeFactory::deleteShape(worker->shape);
+        } else if (worker->shape) {
             ShapeReference newRef;
             // refCount is zero because nothing is using the shape yet
             newRef.refCount = 0;
             newRef.shape = worker->shape;
             newRef.key = worker->shapeInfo.getHash();
-            HashKey hashKey(newRef.key);
             _shapeMap.insert(hashKey, newRef);
 
             // This shape's refCount is zero because an object requested it but is not yet using it.  We expect it to be
@@ -272,6 +297,7 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
     }
     // save this dead worker for later
     worker->shapeInfo.clear();
+    worker->bvhCacheDirectory.clear();
     worker->shape = nullptr;
     _deadWorker = worker;
     ++_workDeliveryCount;
@@ -41,6 +41,13 @@
 // and returns the pointer.  If not it asks the ShapeFactory to create it, adds an
 // entry in the map with a ref-count of 1, and returns the pointer.
 //
+// Callers that can wait for a shape (the entity simulation) may ask for shapes
+// that are slow to build (static meshes and big sets of convex hulls) to be built
+// on a worker thread instead: getShape() returns nullptr and bumps the work
+// request count, and the shape shows up with a ref-count of 0 once the work is
+// delivered.  Asking again for a shape that is still being built does not start
+// another worker.  Everyone else gets the shape built on the spot.
+//
 // When a body stops using a shape the ShapeManager must be informed so it can
 // decrement its ref-count.  When a ref-count drops to zero the ShapeManager
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
@@ -55,8 +62,9 @@ public:
     ShapeManager();
     ~ShapeManager();
 
-    /// \return pointer to shape
-    const btCollisionShape* getShape(const ShapeInfo& info);
+    /// \param allowAsync true if a shape that is slow to build may be built off-thread
+    /// \return pointer to shape, or nullptr if it failed to build or is being built off-thread
+    const btCollisionShape* getShape(const ShapeInfo& info, bool allowAsync = false);
     const btCollisionShape* getShapeByKey(uint64_t key);
     bool hasShapeWithKey(uint64_t key) const;
 
@@ -74,12 +82,17 @@ public:
     uint32_t getWorkRequestCount() const { return _workRequestCount; }
     uint32_t getWorkDeliveryCount() const { return _workDeliveryCount; }
 
+    // BVHs of static meshes are cached in this directory so they needn't be rebuilt, disabled when empty
+    void setBvhCacheDirectory(const QString& directory);
+    const QString& getBvhCacheDirectory() const { return _bvhCacheDirectory; }
+
 protected slots:
     void acceptWork(ShapeFactory::Worker* worker);
 
 private:
     void addToGarbage(uint64_t key);
     bool releaseShapeByKey(uint64_t key);
+    void pruneBvhCache();
 
     class ShapeReference {
     public:
@@ -100,8 +113,9 @@ private:
     // btHashMap is required because it supports memory alignment of the btCollisionShapes
     btHashMap<HashKey, ShapeReference> _shapeMap;
     std::vector<uint64_t> _garbageRing;
-    std::vector<uint64_t> _pendingMeshShapes;
+    std::vector<uint64_t> _pendingShapes;
     std::vector<KeyExpiry> _orphans;
+    QString _bvhCacheDirectory;
     ShapeFactory::Worker* _deadWorker { nullptr };
     TimePoint _nextOrphanExpiry;
     uint32_t _ringIndex { 0 };
@@ -24,9 +24,11 @@
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
-        btConstraintSolver* constraintSolver,
+        btConstraintSolverPoolMt* solverPool,
         btCollisionConfiguration* collisionConfiguration)
-    :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
+    :   btDiscreteDynamicsWorldMt(dispatcher, pairCache, solverPool, nullptr, collisionConfiguration) {
+    // NOTE: no multithreaded solver is given for large islands, each island is solved by one thread with a
+    // btSequentialImpulseConstraintSolver from the pool so its result doesn't depend on how the work was split.
 }
 
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
@@ -89,6 +91,11 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
 
     clearForces();
 
+    if (btITaskScheduler* scheduler = btGetTaskScheduler()) {
+        // as in btDiscreteDynamicsWorldMt::stepSimulation(), let the workers sleep until the next step
+        scheduler->sleepWorkerThreadsHint();
+    }
+
     return subSteps;
 }
 
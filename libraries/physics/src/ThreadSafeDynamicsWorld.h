@@ -19,7 +19,7 @@
 #define hifi_ThreadSafeDynamicsWorld_h
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
-#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
 
 #include "ObjectMotionState.h"
 
@@ -27,14 +27,16 @@
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+// Simulation islands are solved, and bodies integrated, through btParallelFor() so they run on the worker threads
+// of whichever btITaskScheduler is installed.  With the sequential scheduler this steps like btDiscreteDynamicsWorld.
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorldMt {
 public:
     BT_DECLARE_ALIGNED_ALLOCATOR();
 
     ThreadSafeDynamicsWorld(
             btDispatcher* dispatcher,
             btBroadphaseInterface* pairCache,
-            btConstraintSolver* constraintSolver,
+            btConstraintSolverPoolMt* solverPool,
             btCollisionConfiguration* collisionConfiguration);
 
     int getNumSubsteps() const { return _numSubsteps; }
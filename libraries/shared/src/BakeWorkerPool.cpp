@@ -0,0 +1,303 @@
+//
+//  BakeWorkerPool.cpp
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeWorkerPool.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtGui/QImageReader>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "SharedLogging.h"
+#include "SharedUtil.h"
+
+static const uint64_t BYTES_PER_MEGABYTE = 1024 * 1024;
+static const uint64_t BYTES_PER_GIGABYTE = 1024 * BYTES_PER_MEGABYTE;
+
+// fallback when the amount of physical memory can't be determined
+static const uint64_t DEFAULT_MEMORY_BUDGET_BYTES = 8 * BYTES_PER_GIGABYTE;
+
+// what a worker costs before it has loaded anything
+static const uint64_t WORKER_BASE_MEMORY_BYTES = 256 * BYTES_PER_MEGABYTE;
+
+// a texture is held as floats while it is processed, plus its mips and one compressed copy per backend target
+static const uint64_t BYTES_PER_TEXTURE_PIXEL = 64;
+static const uint64_t MODEL_EXPANSION_FACTOR = 32;
+static const uint64_t OTHER_EXPANSION_FACTOR = 4;
+
+// workers reserve far more address space than they touch (thread stacks, allocator arenas),
+// so the cap is generous - it is there to stop runaway bakes, not to enforce the estimate
+static const uint64_t ADDRESS_SPACE_LIMIT_FACTOR = 4;
+static const uint64_t MIN_ADDRESS_SPACE_LIMIT_BYTES = 8 * BYTES_PER_GIGABYTE;
+
+// an oven bakes textures and meshes on several threads, so a worker keeps more than one core busy
+static const int CORES_PER_WORKER = 4;
+
+// how many scheduling passes smaller jobs may overtake a job that doesn't fit in the memory left
+static const int MAX_TIMES_PASSED_OVER = 16;
+
+namespace {
+
+class WorkerProcess : public QProcess {
+public:
+    WorkerProcess(uint64_t addressSpaceLimitBytes) : _addressSpaceLimitBytes(addressSpaceLimitBytes) {}
+
+protected:
+    void setupChildProcess() override {
+#ifdef Q_OS_UNIX
+        // runs in the forked child before exec, so only async-signal-safe calls belong here
+        if (_addressSpaceLimitBytes > 0) {
+            struct rlimit limit;
+            limit.rlim_cur = (rlim_t)_addressSpaceLimitBytes;
+            limit.rlim_max = (rlim_t)_addressSpaceLimitBytes;
+            setrlimit(RLIMIT_AS, &limit);
+        }
+#endif
+    }
+
+private:
+    uint64_t _addressSpaceLimitBytes;
+};
+
+uint64_t getPhysicalMemoryBytes() {
+    MemoryInfo info;
+    if (getMemoryInfo(info)) {
+        return info.totalMemoryBytes;
+    }
+#ifdef Q_OS_UNIX
+    auto pages = sysconf(_SC_PHYS_PAGES);
+    auto pageSize = sysconf(_SC_PAGE_SIZE);
+    if (pages > 0 && pageSize > 0) {
+        return (uint64_t)pages * (uint64_t)pageSize;
+    }
+#endif
+    return 0;
+}
+
+}
+
+BakeWorkerPool::BakeWorkerPool(QObject* parent) :
+    QObject(parent),
+    _maxWorkers(maxWorkersForCores(QThread::idealThreadCount()))
+{
+    // worker process signals are delivered through queued connections
+    static std::once_flag registerMetaTypesFlag;
+    std::call_once(registerMetaTypesFlag, [] {
+        qRegisterMetaType<QProcess::ProcessError>("QProcess::ProcessError");
+        qRegisterMetaType<QProcess::ExitStatus>("QProcess::ExitStatus");
+    });
+
+    // leave a quarter of the host for the parent process and everything else running on it
+    auto physicalMemoryBytes = getPhysicalMemoryBytes();
+    _memoryBudgetBytes = physicalMemoryBytes > 0 ? (physicalMemoryBytes / 4) * 3 : DEFAULT_MEMORY_BUDGET_BYTES;
+}
+
+BakeWorkerPool::~BakeWorkerPool() {
+    for (auto& pair : _runningJobs) {
+        auto& process = pair.second->process;
+        process->disconnect(this);
+        process->kill();
+        process->waitForFinished();
+    }
+}
+
+void BakeWorkerPool::setMaxWorkers(int maxWorkers) {
+    _maxWorkers = std::max(1, maxWorkers);
+    schedule();
+}
+
+int BakeWorkerPool::maxWorkersForCores(int coreCount) {
+    return std::max(1, coreCount / CORES_PER_WORKER);
+}
+
+void BakeWorkerPool::setMemoryBudget(uint64_t memoryBudgetBytes) {
+    _memoryBudgetBytes = memoryBudgetBytes;
+    schedule();
+}
+
+quint32 BakeWorkerPool::submit(const QString& program, const QStringList& arguments, uint64_t estimatedMemoryBytes) {
+    JobPointer job { new Job() };
+    job->id = _nextJobID++;
+    job->program = program;
+    job->arguments = arguments;
+    job->estimatedMemoryBytes = estimatedMemoryBytes;
+
+    auto jobID = job->id;
+
+    // keep the queue sorted largest first, FIFO among equal estimates
+    auto it = std::upper_bound(_queuedJobs.begin(), _queuedJobs.end(), estimatedMemoryBytes,
+                               [](uint64_t estimate, const JobPointer& queued) {
+        return estimate > queued->estimatedMemoryBytes;
+    });
+    _queuedJobs.insert(it, std::move(job));
+
+    // defer so the caller can hold on to the job ID before any of its signals fire
+    QTimer::singleShot(0, this, [this] { schedule(); });
+
+    return jobID;
+}
+
+void BakeWorkerPool::abort(quint32 jobID) {
+    auto queuedIt = std::find_if(_queuedJobs.begin(), _queuedJobs.end(), [jobID](const JobPointer& job) {
+        return job->id == jobID;
+    });
+    if (queuedIt != _queuedJobs.end()) {
+        _queuedJobs.erase(queuedIt);
+        emit jobAborted(jobID);
+        return;
+    }
+
+    auto runningIt = _runningJobs.find(jobID);
+    if (runningIt != _runningJobs.end() && !runningIt->second->wasAborted) {
+        qCDebug(shared) << "Terminating bake worker for job" << jobID;
+        runningIt->second->wasAborted = true;
+        runningIt->second->process->terminate();
+    }
+}
+
+void BakeWorkerPool::abortAll() {
+    std::vector<quint32> jobIDs;
+    for (auto& job : _queuedJobs) {
+        jobIDs.push_back(job->id);
+    }
+    for (auto& pair : _runningJobs) {
+        jobIDs.push_back(pair.first);
+    }
+
+    for (auto jobID : jobIDs) {
+        abort(jobID);
+    }
+}
+
+bool BakeWorkerPool::isRunning(quint32 jobID) const {
+    return _runningJobs.find(jobID) != _runningJobs.end();
+}
+
+void BakeWorkerPool::schedule() {
+    auto it = _queuedJobs.begin();
+    while (it != _queuedJobs.end() && (int)_runningJobs.size() < _maxWorkers) {
+        auto& job = *it;
+
+        // a job estimated to need more than the whole budget still gets to run, on its own
+        bool fits = _runningMemoryBytes + job->estimatedMemoryBytes <= _memoryBudgetBytes;
+        if (fits || _runningJobs.empty()) {
+            auto jobToStart = std::move(job);
+            it = _queuedJobs.erase(it);
+            startJob(std::move(jobToStart));
+        } else if (++job->timesPassedOver > MAX_TIMES_PASSED_OVER) {
+            // this job has waited long enough, hold the remaining jobs back until it fits
+            break;
+        } else {
+            ++it;
+        }
+    }
+}
+
+void BakeWorkerPool::startJob(JobPointer job) {
+    ++job->attempts;
+
+    // the final attempt runs without a cap, in case the estimate was simply too low
+    uint64_t addressSpaceLimitBytes = 0;
+#ifdef Q_OS_UNIX
+    if (job->attempts < _maxAttempts) {
+        addressSpaceLimitBytes = std::max(job->estimatedMemoryBytes * ADDRESS_SPACE_LIMIT_FACTOR,
+                                          MIN_ADDRESS_SPACE_LIMIT_BYTES);
+    }
+#endif
+
+    auto jobID = job->id;
+    job->process.reset(new WorkerProcess(addressSpaceLimitBytes));
+
+    // queued so the job is never torn down from inside one of its own process' signals
+    connect(job->process.get(), static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, [this, jobID](int exitCode, QProcess::ExitStatus exitStatus) {
+        handleJobFinished(jobID, exitCode, exitStatus);
+    }, Qt::QueuedConnection);
+    connect(job->process.get(), &QProcess::errorOccurred, this, [this, jobID](QProcess::ProcessError error) {
+        // a worker that failed to start never emits finished
+        if (error == QProcess::FailedToStart) {
+            auto it = _runningJobs.find(jobID);
+            if (it != _runningJobs.end()) {
+                it->second->attempts = _maxAttempts;
+            }
+            handleJobFinished(jobID, -1, QProcess::CrashExit);
+        }
+    }, Qt::QueuedConnection);
+
+    _runningMemoryBytes += job->estimatedMemoryBytes;
+
+    auto process = job->process.get();
+    auto program = job->program;
+    auto arguments = job->arguments;
+    _runningJobs[jobID] = std::move(job);
+
+    qCDebug(shared) << "Starting bake worker for job" << jobID << ":" << program << arguments;
+    process->start(program, arguments, QIODevice::ReadOnly);
+
+    emit jobStarted(jobID);
+}
+
+void BakeWorkerPool::handleJobFinished(quint32 jobID, int exitCode, QProcess::ExitStatus exitStatus) {
+    auto it = _runningJobs.find(jobID);
+    if (it == _runningJobs.end()) {
+        return;
+    }
+
+    auto job = std::move(it->second);
+    _runningJobs.erase(it);
+    _runningMemoryBytes -= job->estimatedMemoryBytes;
+    job->process.release()->deleteLater();
+
+    if (job->wasAborted) {
+        emit jobAborted(jobID);
+    } else if (exitStatus == QProcess::CrashExit && job->attempts < _maxAttempts) {
+        // most worker crashes are running out of memory, so ask for more headroom on the next attempt
+        qCDebug(shared) << "Bake worker for job" << jobID << "crashed, retrying";
+        job->estimatedMemoryBytes *= 2;
+        job->timesPassedOver = 0;
+
+        auto estimatedMemoryBytes = job->estimatedMemoryBytes;
+        auto queuedIt = std::upper_bound(_queuedJobs.begin(), _queuedJobs.end(), estimatedMemoryBytes,
+                                         [](uint64_t estimate, const JobPointer& queued) {
+            return estimate > queued->estimatedMemoryBytes;
+        });
+        _queuedJobs.insert(queuedIt, std::move(job));
+    } else {
+        emit jobFinished(jobID, exitCode, exitStatus);
+    }
+
+    schedule();
+}
+
+uint64_t BakeWorkerPool::estimateMemoryCost(const QString& filePath) {
+    QFileInfo fileInfo { filePath };
+    auto fileSize = (uint64_t)std::max<qint64>(0, fileInfo.size());
+
+    // only the image header is read here
+    QImageReader imageReader { filePath };
+    if (imageReader.canRead()) {
+        auto imageSize = imageReader.size();
+        if (imageSize.isValid()) {
+            return WORKER_BASE_MEMORY_BYTES + (uint64_t)imageSize.width() * (uint64_t)imageSize.height() * BYTES_PER_TEXTURE_PIXEL;
+        }
+    }
+
+    static const QStringList MODEL_SUFFIXES { "fbx", "obj", "gltf", "glb", "fst" };
+    auto expansionFactor = MODEL_SUFFIXES.contains(fileInfo.suffix().toLower()) ? MODEL_EXPANSION_FACTOR : OTHER_EXPANSION_FACTOR;
+    return WORKER_BASE_MEMORY_BYTES + fileSize * expansionFactor;
+}
@@ -0,0 +1,93 @@
+//
+//  BakeWorkerPool.h
+//  libraries/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakeWorkerPool_h
+#define hifi_BakeWorkerPool_h
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QProcess>
+#include <QtCore/QStringList>
+
+// Runs bakes in child processes (usually the oven CLI) so that a bake which runs out of memory or crashes only takes
+// down its own worker.
+//
+// Jobs are started largest estimated memory cost first, as long as the running jobs stay within the memory budget
+// and the worker count. A job that crashes is retried with twice its estimate, which makes it wait for more headroom.
+// On Unix each worker's address space is capped relative to its estimate so that one runaway bake cannot starve
+// the rest of the host.
+class BakeWorkerPool : public QObject {
+    Q_OBJECT
+public:
+    BakeWorkerPool(QObject* parent = nullptr);
+    ~BakeWorkerPool();
+
+    void setMaxWorkers(int maxWorkers);
+    int getMaxWorkers() const { return _maxWorkers; }
+
+    // how many workers fit on coreCount cores, given that each worker bakes on several threads of its own
+    static int maxWorkersForCores(int coreCount);
+
+    void setMemoryBudget(uint64_t memoryBudgetBytes);
+    uint64_t getMemoryBudget() const { return _memoryBudgetBytes; }
+
+    void setMaxAttempts(int maxAttempts) { _maxAttempts = std::max(1, maxAttempts); }
+    int getMaxAttempts() const { return _maxAttempts; }
+
+    quint32 submit(const QString& program, const QStringList& arguments, uint64_t estimatedMemoryBytes);
+
+    // a queued job is dropped, a running job has its worker terminated - either way jobAborted is emitted
+    void abort(quint32 jobID);
+    void abortAll();
+
+    bool isRunning(quint32 jobID) const;
+    int getNumQueuedJobs() const { return (int)_queuedJobs.size(); }
+    int getNumRunningJobs() const { return (int)_runningJobs.size(); }
+
+    // rough peak memory use of an oven baking the file at filePath
+    static uint64_t estimateMemoryCost(const QString& filePath);
+
+signals:
+    void jobStarted(quint32 jobID);
+    void jobFinished(quint32 jobID, int exitCode, QProcess::ExitStatus exitStatus);
+    void jobAborted(quint32 jobID);
+
+private:
+    struct Job {
+        quint32 id;
+        QString program;
+        QStringList arguments;
+        uint64_t estimatedMemoryBytes;
+        int attempts { 0 };
+        int timesPassedOver { 0 };
+        bool wasAborted { false };
+        std::unique_ptr<QProcess> process;
+    };
+    using JobPointer = std::unique_ptr<Job>;
+
+    void schedule();
+    void startJob(JobPointer job);
+    void handleJobFinished(quint32 jobID, int exitCode, QProcess::ExitStatus exitStatus);
+
+    std::vector<JobPointer> _queuedJobs;
+    std::unordered_map<quint32, JobPointer> _runningJobs;
+
+    quint32 _nextJobID { 1 };
+    int _maxWorkers;
+    int _maxAttempts { 2 };
+    uint64_t _memoryBudgetBytes;
+    uint64_t _runningMemoryBytes { 0 };
+};
+
+#endif // hifi_BakeWorkerPool_h
@@ -10,6 +10,12 @@
 //
 #include "Task.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include <TBBHelpers.h>
+
 using namespace task;
 
 JobContext::JobContext() {
@@ -29,3 +35,81 @@ void TaskFlow::abortTask() {
 bool TaskFlow::doAbortTask() const {
     return _doAbortTask;
 }
+
+void JobGraph::build(const std::vector<Varying>& inputs, const std::vector<Varying>& outputs) {
+    size_t numJobs = inputs.size();
+
+    std::vector<std::vector<const void*>> outputIDs(numJobs);
+    for (size_t i = 0; i < numJobs; i++) {
+        outputs[i].getDataIDs(outputIDs[i]);
+        std::sort(outputIDs[i].begin(), outputIDs[i].end());
+    }
+
+    _successors.assign(numJobs, std::vector<size_t>());
+    _dependencyCounts.assign(numJobs, 0);
+
+    std::vector<const void*> inputIDs;
+    for (size_t j = 0; j < numJobs; j++) {
+        inputIDs.clear();
+        inputs[j].getDataIDs(inputIDs);
+        std::sort(inputIDs.begin(), inputIDs.end());
+
+        // a job can only take the outputs of the jobs added before it
+        for (size_t i = 0; i < j; i++) {
+            auto output = outputIDs[i].begin();
+            auto input = inputIDs.begin();
+            while (output != outputIDs[i].end() && input != inputIDs.end()) {
+                if (*output < *input) {
+                    ++output;
+                } else if (*input < *output) {
+                    ++input;
+                } else {
+                    _successors[i].push_back(j);
+                    _dependencyCounts[j]++;
+                    break;
+                }
+            }
+        }
+    }
+
+    _isBuilt = true;
+}
+
+void JobGraph::clear() {
+    _successors.clear();
+    _dependencyCounts.clear();
+    _isBuilt = false;
+}
+
+bool JobGraph::run(const std::function<bool(size_t)>& runJob) const {
+    size_t numJobs = _successors.size();
+    std::unique_ptr<std::atomic<int>[]> pendingCounts(new std::atomic<int>[numJobs]);
+    for (size_t i = 0; i < numJobs; i++) {
+        pendingCounts[i] = _dependencyCounts[i];
+    }
+
+    std::atomic<bool> aborted { false };
+    tbb::task_group group;
+
+    std::function<void(size_t)> runNode = [&](size_t index) {
+        if (!aborted && !runJob(index)) {
+            aborted = true;
+        }
+
+        // even once aborted, walk the rest of the graph so that the group drains
+        for (size_t successor : _successors[index]) {
+            if (--pendingCounts[successor] == 0) {
+                group.run([&runNode, successor] { runNode(successor); });
+            }
+        }
+    };
+
+    for (size_t i = 0; i < numJobs; i++) {
+        if (_dependencyCounts[i] == 0) {
+            group.run([&runNode, i] { runNode(i); });
+        }
+    }
+    group.wait();
+
+    return !aborted;
+}
@@ -12,6 +12,9 @@
 #ifndef hifi_task_Task_h
 #define hifi_task_Task_h
 
+#include <functional>
+#include <vector>
+
 #include "Config.h"
 #include "Varying.h"
 
@@ -42,6 +45,25 @@ protected:
     bool _doAbortTask{ false };
 };
 
+// JobGraph holds the dependencies between the jobs of a task, found by matching each job's input varyings
+// against the output varyings of the jobs added before it.
+// A task running its jobs in parallel uses it to start each job as soon as the jobs it depends on are done.
+class JobGraph {
+public:
+    void build(const std::vector<Varying>& inputs, const std::vector<Varying>& outputs);
+    void clear();
+    bool isBuilt() const { return _isBuilt; }
+
+    // Calls runJob for every job from the thread pool, once all of the jobs it depends on have run.
+    // Once a call to runJob returns false no further jobs are started, and run returns false.
+    bool run(const std::function<bool(size_t)>& runJob) const;
+
+protected:
+    std::vector<std::vector<size_t>> _successors;
+    std::vector<int> _dependencyCounts;
+    bool _isBuilt { false };
+};
+
 // JobContext class is the base class for the context object which is passed through all the Job::run calls thoughout the graph of jobs
 // It is used to communicate to the job::run its context and various state information the job relies on.
 // It specifically provide access to:
@@ -239,6 +261,13 @@ public:
         Varying _input;
         Varying _output;
         Jobs _jobs;
+        JobGraph _jobGraph;
+        bool _isParallel { false };
+
+        // Let the jobs of this task that don't depend on each other's outputs run concurrently on the thread pool.
+        // Off by default: only turn it on for tasks whose jobs don't share any state outside of their varyings.
+        void setParallel(bool parallel) { _isParallel = parallel; }
+        bool isParallel() const { return _isParallel; }
 
         const Varying getInput() const override { return _input; }
         const Varying getOutput() const override { return _output; }
@@ -268,6 +297,7 @@ public:
         // Create a new job in the container's queue; returns the job's output
         template <class NT, class... NA> const Varying addJob(std::string name, const Varying& input, NA&&... args) {
             _jobs.emplace_back((NT::JobModel::create(name, input, std::forward<NA>(args)...)));
+            _jobGraph.clear();
 
             // Conect the child config to this task's config
             std::static_pointer_cast<TaskConfig>(Concept::getConfiguration())->connectChildConfig(_jobs.back().getConfiguration(), name);
@@ -278,6 +308,30 @@ public:
             const auto input = Varying(typename NT::JobModel::Input());
             return addJob<NT>(name, input, std::forward<NA>(args)...);
         }
+
+        void runParallel(const ContextPointer& jobContext) {
+            if (!_jobGraph.isBuilt()) {
+                std::vector<Varying> inputs;
+                std::vector<Varying> outputs;
+                for (const auto& job : _jobs) {
+                    inputs.push_back(job.getInput());
+                    outputs.push_back(job.getOutput());
+                }
+                _jobGraph.build(inputs, outputs);
+            }
+
+            bool finished = _jobGraph.run([&](size_t index) {
+                // running a job sets the context's jobConfig, so each job gets its own copy of the context
+                auto context = std::make_shared<Context>(*jobContext);
+                _jobs[index].run(context);
+                return !context->taskFlow.doAbortTask();
+            });
+
+            // hand an abort issued on a job's copy of the context back to the task, as a serial run would see it
+            if (!finished) {
+                jobContext->taskFlow.abortTask();
+            }
+        }
     };
 
     template <class T, class C = Config, class I = None, class O = None> class TaskModel : public TaskConcept {
@@ -342,6 +396,13 @@ public:
         void run(const ContextPointer& jobContext) override {
             auto config = std::static_pointer_cast<C>(Concept::_config);
             if (config->isEnabled()) {
+                if (TaskConcept::_isParallel && TaskConcept::_jobs.size() > 1) {
+                    TaskConcept::runParallel(jobContext);
+                    if (jobContext->taskFlow.doAbortTask()) {
+                        jobContext->taskFlow.reset();
+                    }
+                    return;
+                }
                 for (auto job : TaskConcept::_jobs) {
                     job.run(jobContext);
                     if (jobContext->taskFlow.doAbortTask()) {
@@ -14,11 +14,16 @@
 
 #include <type_traits>
 #include <tuple>
+#include <utility>
 #include <array>
+#include <memory>
+#include <vector>
 
 namespace task {
 class Varying;
 
+template <class T, class Enable = void> struct VaryingContents;
+
 
 // A varying piece of data, to be used as Job/Task I/O
 class Varying {
@@ -46,6 +51,15 @@ public:
 
     bool isNull() const { return _concept == nullptr; }
 
+    // Appends an id for the data held by this varying, and for the data of the varyings it is a set of, to ids.
+    // Varyings sharing their data share the id, which is how a task tells which of its jobs consume another's output.
+    void getDataIDs(std::vector<const void*>& ids) const {
+        if (_concept) {
+            ids.push_back(_concept.get());
+            _concept->getContentDataIDs(ids);
+        }
+    }
+
 protected:
     class Concept {
     public:
@@ -55,6 +69,7 @@ protected:
 
         virtual Varying operator[] (uint8_t index) const = 0;
         virtual uint8_t length() const = 0;
+        virtual void getContentDataIDs(std::vector<const void*>& ids) const = 0;
 
         const std::string name() { return _name; }
 
@@ -73,6 +88,9 @@ protected:
         virtual uint8_t length() const override {
             return 0;
         }
+        virtual void getContentDataIDs(std::vector<const void*>& ids) const override {
+            VaryingContents<T>::getDataIDs(_data, ids);
+        }
 
         Data _data;
     };
@@ -80,6 +98,34 @@ protected:
     std::shared_ptr<Concept> _concept;
 };
 
+template <class... Ts> struct VaryingMakeVoid { using type = void; };
+
+// Plain data doesn't contain other varyings
+template <class T, class Enable>
+struct VaryingContents {
+    static void getDataIDs(const T& data, std::vector<const void*>& ids) {}
+};
+
+// The VaryingSetN types
+template <class T>
+struct VaryingContents<T, typename VaryingMakeVoid<decltype(std::declval<const T&>().asVarying())>::type> {
+    static void getDataIDs(const T& set, std::vector<const void*>& ids) {
+        for (uint8_t i = 0; i < set.length(); i++) {
+            set[i].getDataIDs(ids);
+        }
+    }
+};
+
+// VaryingArray and other containers of varyings
+template <class T>
+struct VaryingContents<T, typename std::enable_if<std::is_same<typename T::value_type, Varying>::value>::type> {
+    static void getDataIDs(const T& varyings, std::vector<const void*>& ids) {
+        for (const auto& varying : varyings) {
+            varying.getDataIDs(ids);
+        }
+    }
+};
+
 template < typename T0, typename T1 >
 class VaryingSet2 : public std::pair<Varying, Varying> {
 public:
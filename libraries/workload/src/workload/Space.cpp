@@ -20,7 +20,28 @@
 
 using namespace workload;
 
+const float CELL_SIZE = 32.0f; // meters, a fraction of the region radii we expect
+const float INV_CELL_SIZE = 1.0f / CELL_SIZE;
+const float MAX_CELL_COORD = (float)((1 << 20) - 1); // 21 bits per axis in the cell key
+const float MAX_GRID_PROXY_RADIUS = CELL_SIZE; // bigger proxies are always tested on their own
+
+// cell verdicts keep this much (relative to the coordinates involved) clear of a region boundary
+// so float rounding can never make one disagree with the per-proxy test
+const float RELATIVE_BOUNDARY_MARGIN = 1.0e-5f;
+
+// when more than one proxy in this many moved, testing every proxy in order beats hopping around the grid
+const uint32_t FULL_PASS_MOVED_PROXY_RATIO = 16;
+
+const Index OVERFLOW_CELL_INDEX = 0;
+
+static uint64_t computeCellKey(const glm::ivec3& coord) {
+    const uint64_t KEY_MASK = (1 << 21) - 1;
+    return ((uint64_t)coord.x & KEY_MASK) | (((uint64_t)coord.y & KEY_MASK) << 21) | (((uint64_t)coord.z & KEY_MASK) << 42);
+}
+
 Space::Space() : Collection() {
+    _cells.emplace_back();
+    _cells[OVERFLOW_CELL_INDEX].isBounded = false;
 }
 
 void Space::processTransactionFrame(const Transaction& transaction) {
@@ -31,6 +52,7 @@ void Space::processTransactionFrame(const Transaction& transaction) {
     if (maxID > (Index) _proxies.size()) {
         _proxies.resize(maxID + 100); // allocate the maxId and more
         _owners.resize(maxID + 100);
+        _proxyCells.resize(maxID + 100);
     }
     // Now we know for sure that we have enough items in the array to
     // capture anything coming from the transaction
@@ -54,6 +76,8 @@ void Space::processResets(const Transaction::Resets& transactions) {
         // Reset the item with a new payload
         item.sphere = (std::get<1>(reset));
         item.prevRegion = item.region = Region::UNKNOWN;
+        removeProxyFromCell(proxyID);
+        insertProxyInCell(proxyID);
 
         _owners[proxyID] = (std::get<2>(reset));
     }
@@ -71,6 +95,7 @@ void Space::processRemoves(const Transaction::Removes& transactions) {
 
         // Kill it
         item.prevRegion = item.region = Region::INVALID;
+        removeProxyFromCell(removedID);
         _owners[removedID] = Owner();
     }
 }
@@ -87,37 +112,291 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
 
         // Update the item
         item.sphere = (std::get<1>(update));
+
+        // proxies that were never reset aren't in the grid, and aren't categorized
+        if (_proxyCells[updateID].cellIndex != indexed_container::INVALID_INDEX) {
+            removeProxyFromCell(updateID);
+            insertProxyInCell(updateID);
+        }
+    }
+}
+
+void Space::insertProxyInCell(ProxyID proxyID) {
+    const Sphere& sphere = _proxies[proxyID].sphere;
+    Index cellIndex = OVERFLOW_CELL_INDEX;
+
+    // NaN fails every comparison, so broken spheres land in the overflow cell too
+    glm::vec3 cellCoord = glm::floor(glm::vec3(sphere) * INV_CELL_SIZE);
+    if (glm::all(glm::lessThanEqual(glm::abs(cellCoord), glm::vec3(MAX_CELL_COORD))) &&
+            sphere.w >= 0.0f && sphere.w <= MAX_GRID_PROXY_RADIUS) {
+        glm::ivec3 coord(cellCoord);
+        uint64_t key = computeCellKey(coord);
+        auto itr = _cellIndices.find(key);
+        if (itr != _cellIndices.end()) {
+            cellIndex = itr->second;
+        } else {
+            cellIndex = (Index)_cells.size();
+            _cells.emplace_back();
+            _cells.back().coord = coord;
+            _cellIndices[key] = cellIndex;
+        }
+    }
+
+    Cell& cell = _cells[cellIndex];
+    if (cell.proxies.empty()) {
+        cell.minRadius = sphere.w;
+        cell.maxRadius = sphere.w;
+        cell.isDirty = true;
+    } else {
+        // the bounds only grow while the cell is occupied, which keeps them conservative
+        cell.minRadius = std::min(cell.minRadius, sphere.w);
+        cell.maxRadius = std::max(cell.maxRadius, sphere.w);
+    }
+    auto& proxyCell = _proxyCells[proxyID];
+    proxyCell.cellIndex = cellIndex;
+    proxyCell.slot = (Index)cell.proxies.size();
+    cell.proxies.push_back(proxyID);
+    if (!proxyCell.isMoved) {
+        proxyCell.isMoved = true;
+        _movedProxies.push_back(proxyID);
+    }
+    // the cell's verdict is needed for the moved proxy even when nothing else in it changes
+    activateCell(cellIndex);
+}
+
+void Space::removeProxyFromCell(ProxyID proxyID) {
+    auto& proxyCell = _proxyCells[proxyID];
+    if (proxyCell.cellIndex == indexed_container::INVALID_INDEX) {
+        return;
+    }
+    Cell& cell = _cells[proxyCell.cellIndex];
+    ProxyID lastProxyID = cell.proxies.back();
+    cell.proxies[proxyCell.slot] = lastProxyID;
+    _proxyCells[lastProxyID].slot = proxyCell.slot;
+    cell.proxies.pop_back();
+    proxyCell.cellIndex = indexed_container::INVALID_INDEX;
+    proxyCell.slot = indexed_container::INVALID_INDEX;
+}
+
+void Space::activateCell(Index cellIndex) {
+    Cell& cell = _cells[cellIndex];
+    if (!cell.isActive) {
+        cell.isActive = true;
+        _activeCells.push_back(cellIndex);
+    }
+}
+
+void Space::gatherCellsInReachOfViews() {
+    for (const auto& view : _views) {
+        // grid proxies are no bigger than MAX_GRID_PROXY_RADIUS, so none centered outside this box touches a region
+        glm::vec3 reachMin(FLT_MAX);
+        glm::vec3 reachMax(-FLT_MAX);
+        for (uint8_t k = 0; k < Region::NUM_VIEW_REGIONS; ++k) {
+            glm::vec3 regionCenter = glm::vec3(view.regions[k]);
+            float reach = view.regions[k].w + MAX_GRID_PROXY_RADIUS;
+            reachMin = glm::min(reachMin, regionCenter - glm::vec3(reach));
+            reachMax = glm::max(reachMax, regionCenter + glm::vec3(reach));
+        }
+        glm::vec3 minCoord = glm::max(glm::floor(reachMin * INV_CELL_SIZE), glm::vec3(-MAX_CELL_COORD));
+        glm::vec3 maxCoord = glm::min(glm::floor(reachMax * INV_CELL_SIZE), glm::vec3(MAX_CELL_COORD));
+        if (!glm::all(glm::lessThanEqual(minCoord, maxCoord))) {
+            continue;
+        }
+
+        // when the box spans more cells than exist it's cheaper to look at all of them
+        glm::vec3 span = maxCoord - minCoord + glm::vec3(1.0f);
+        if ((double)span.x * (double)span.y * (double)span.z > (double)_cells.size()) {
+            for (Index i = 0; i < (Index)_cells.size(); ++i) {
+                if (_cells[i].visitedPass != _numCategorizePasses) {
+                    _cells[i].visitedPass = _numCategorizePasses;
+                    _visitedCells.push_back(i);
+                }
+            }
+            return;
+        }
+
+        glm::ivec3 coord;
+        for (coord.x = (int)minCoord.x; coord.x <= (int)maxCoord.x; ++coord.x) {
+            for (coord.y = (int)minCoord.y; coord.y <= (int)maxCoord.y; ++coord.y) {
+                for (coord.z = (int)minCoord.z; coord.z <= (int)maxCoord.z; ++coord.z) {
+                    auto itr = _cellIndices.find(computeCellKey(coord));
+                    if (itr != _cellIndices.end() && _cells[itr->second].visitedPass != _numCategorizePasses) {
+                        _cells[itr->second].visitedPass = _numCategorizePasses;
+                        _visitedCells.push_back(itr->second);
+                    }
+                }
+            }
+        }
+    }
+}
+
+uint8_t Space::evalCellRegion(const Cell& cell) const {
+    if (!cell.isBounded) {
+        return Region::INVALID;
+    }
+    // the cell's bounding sphere is a little loose, but costs one sqrt per region
+    const float CELL_HALF_DIAGONAL = 0.5f * sqrtf(3.0f) * CELL_SIZE;
+    glm::vec3 cellCenter = (glm::vec3(cell.coord) + glm::vec3(0.5f)) * CELL_SIZE;
+    float cellCenterMagnitude = glm::length(cellCenter);
+
+    // same walk as evalProxyRegion(), except that a region sphere which touches only some of the cell's
+    // possible proxies leaves the answer to the individual proxies
+    uint8_t region = Region::UNKNOWN;
+    for (const auto& view : _views) {
+        for (uint8_t k = 0; k < region; ++k) {
+            glm::vec3 regionCenter = glm::vec3(view.regions[k]);
+            float minTouchDistance = cell.minRadius + view.regions[k].w;
+            if (minTouchDistance < 0.0f) {
+                return Region::INVALID;
+            }
+            float distance = glm::distance(regionCenter, cellCenter);
+            float margin = RELATIVE_BOUNDARY_MARGIN * (cellCenterMagnitude + distance + CELL_HALF_DIAGONAL) + CELL_HALF_DIAGONAL;
+            if (distance + margin < minTouchDistance) {
+                region = k;
+                break;
+            }
+            if (distance - margin < cell.maxRadius + view.regions[k].w) {
+                return Region::INVALID;
+            }
+        }
     }
+    return region;
+}
+
+uint8_t Space::evalProxyRegion(const Proxy& proxy) const {
+    glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
+    float proxyRadius = proxy.sphere.w;
+    uint8_t region = Region::UNKNOWN;
+    for (const auto& view : _views) {
+        // for each 'view' we need only increment 'k' below the current value of 'region'
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = proxyRadius + view.regions[k].w;
+            if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
+        }
+    }
+    return region;
 }
 
 void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
+    if ((uint32_t)_movedProxies.size() * FULL_PASS_MOVED_PROXY_RATIO > getNumObjects()) {
+        categorizeAllProxies(changes);
+        return;
+    }
+    size_t firstChange = changes.size();
+
+    // visit the cells that were active after the last pass, plus any the views can reach now:
+    // all others are out of reach and already outside every region, so nothing in them can change
+    ++_numCategorizePasses;
+    _visitedCells.clear();
+    for (auto cellIndex : _activeCells) {
+        _cells[cellIndex].isActive = false;
+        _cells[cellIndex].visitedPass = _numCategorizePasses;
+        _visitedCells.push_back(cellIndex);
+    }
+    _activeCells.clear();
+    gatherCellsInReachOfViews();
+
+    for (auto cellIndex : _visitedCells) {
+        Cell& cell = _cells[cellIndex];
+        if (cell.proxies.empty()) {
+            continue;
+        }
+        uint8_t cellRegion = evalCellRegion(cell);
+        if (cellRegion != cell.region || cellRegion == Region::INVALID || cell.isDirty) {
+            bool hasChanges = false;
+            for (auto proxyID : cell.proxies) {
+                Proxy& proxy = _proxies[proxyID];
+                proxy.prevRegion = proxy.region;
+                proxy.region = (cellRegion != Region::INVALID) ? cellRegion : evalProxyRegion(proxy);
+                if (proxy.region != proxy.prevRegion) {
+                    changes.emplace_back(Space::Change((int32_t)proxyID, proxy.region, proxy.prevRegion));
+                    hasChanges = true;
+                }
+                _proxyCells[proxyID].isMoved = false;
+            }
+            cell.region = cellRegion;
+            // revisit the cell next time so its prevRegions catch up, just as a full pass would do
+            cell.isDirty = hasChanges;
+        }
+        // otherwise every proxy in here is already in cellRegion with prevRegion == region, except those that moved
+    }
+
+    for (auto proxyID : _movedProxies) {
+        auto& proxyCell = _proxyCells[proxyID];
+        if (!proxyCell.isMoved) {
+            continue;
+        }
+        proxyCell.isMoved = false;
+        if (proxyCell.cellIndex == indexed_container::INVALID_INDEX) {
+            continue;
+        }
+        // the cell was visited above, and its verdict is uniform or its proxies would all have been handled there
+        Cell& cell = _cells[proxyCell.cellIndex];
+        Proxy& proxy = _proxies[proxyID];
+        proxy.prevRegion = proxy.region;
+        proxy.region = cell.region;
+        if (proxy.region != proxy.prevRegion) {
+            changes.emplace_back(Space::Change((int32_t)proxyID, proxy.region, proxy.prevRegion));
+            cell.isDirty = true;
+        }
+    }
+    _movedProxies.clear();
+
+    for (auto cellIndex : _visitedCells) {
+        const Cell& cell = _cells[cellIndex];
+        if (!cell.proxies.empty() && (cell.region != Region::UNKNOWN || cell.isDirty)) {
+            activateCell(cellIndex);
+        }
+    }
+
+    // report changes in proxy order, as a linear scan over the proxies would
+    std::sort(changes.begin() + firstChange, changes.end(), [](const Space::Change& a, const Space::Change& b) {
+        return a.proxyId < b.proxyId;
+    });
+}
+
+void Space::categorizeAllProxies(std::vector<Space::Change>& changes) {
+    size_t firstChange = changes.size();
     uint32_t numProxies = (uint32_t)_proxies.size();
-    uint32_t numViews = (uint32_t)_views.size();
     for (uint32_t i = 0; i < numProxies; ++i) {
         Proxy& proxy = _proxies[i];
         if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::UNKNOWN;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
-                }
-            }
             proxy.prevRegion = proxy.region;
-            proxy.region = region;
+            proxy.region = evalProxyRegion(proxy);
             if (proxy.region != proxy.prevRegion) {
                 changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
             }
         }
     }
+    for (auto proxyID : _movedProxies) {
+        _proxyCells[proxyID].isMoved = false;
+    }
+    _movedProxies.clear();
+
+    // a uniform cell verdict agrees with every proxy just tested, so the cells can pick up from here
+    for (auto cellIndex : _activeCells) {
+        _cells[cellIndex].isActive = false;
+    }
+    _activeCells.clear();
+    for (Index i = 0; i < (Index)_cells.size(); ++i) {
+        Cell& cell = _cells[i];
+        cell.isDirty = false;
+        if (!cell.proxies.empty()) {
+            cell.region = evalCellRegion(cell);
+            if (cell.region != Region::UNKNOWN) {
+                activateCell(i);
+            }
+        }
+    }
+    for (size_t i = firstChange; i < changes.size(); ++i) {
+        Index cellIndex = _proxyCells[changes[i].proxyId].cellIndex;
+        _cells[cellIndex].isDirty = true;
+        activateCell(cellIndex);
+    }
 }
 
 uint32_t Space::copyProxyValues(Proxy* proxies, uint32_t numDestProxies) const {
@@ -149,6 +428,14 @@ void Space::clear() {
     _IDAllocator.clear();
     _proxies.clear();
     _owners.clear();
+    _proxyCells.clear();
+    _cells.resize(OVERFLOW_CELL_INDEX + 1);
+    _cells[OVERFLOW_CELL_INDEX].proxies.clear();
+    _cells[OVERFLOW_CELL_INDEX].isActive = false;
+    _cellIndices.clear();
+    _activeCells.clear();
+    _visitedCells.clear();
+    _movedProxies.clear();
     _views.clear();
 }
 
@@ -16,6 +16,7 @@
 #define hifi_workload_Space_h
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -53,17 +54,57 @@ public:
 
     void clear() override;
 private:
+    // Proxies are bucketed by center into a loose grid of cells, each of which knows the range of its proxies' radii.
+    // A cell that lies wholly inside or outside every region sphere holds proxies that all share one region, so
+    // categorizeAndGetChanges() only tests individual proxies in cells that straddle a region boundary, plus the
+    // proxies that moved.  Cells out of reach of every view that were already outside all regions aren't visited.
+    class Cell {
+    public:
+        glm::ivec3 coord;
+        IndexVector proxies;
+        float minRadius { 0.0f };
+        float maxRadius { 0.0f };
+        uint32_t visitedPass { 0 };
+        uint8_t region { Region::INVALID }; // region shared by every proxy in the cell, INVALID when they differ
+        bool isDirty { true };
+        bool isActive { false }; // in _activeCells
+        bool isBounded { true }; // false for the catch-all cell of proxies too big, too far out or too broken to bucket
+    };
+
+    class ProxyCell {
+    public:
+        Index cellIndex { indexed_container::INVALID_INDEX };
+        Index slot { indexed_container::INVALID_INDEX }; // in the cell's proxy list
+        bool isMoved { false }; // in _movedProxies
+    };
 
     void processTransactionFrame(const Transaction& transaction) override;
     void processResets(const Transaction::Resets& transactions);
     void processRemoves(const Transaction::Removes& transactions);
     void processUpdates(const Transaction::Updates& transactions);
 
+    // private helper methods
+    void insertProxyInCell(ProxyID proxyID);
+    void removeProxyFromCell(ProxyID proxyID);
+    void activateCell(Index cellIndex);
+    void gatherCellsInReachOfViews();
+    void categorizeAllProxies(std::vector<Change>& changes);
+    uint8_t evalCellRegion(const Cell& cell) const;
+    uint8_t evalProxyRegion(const Proxy& proxy) const;
+
     // The database of proxies is protected for editing by a mutex
     mutable std::mutex _proxiesMutex;
     Proxy::Vector _proxies;
     std::vector<Owner> _owners;
 
+    std::vector<ProxyCell> _proxyCells;
+    IndexVector _movedProxies;
+    std::vector<Cell> _cells;
+    std::unordered_map<uint64_t, Index> _cellIndices;
+    IndexVector _activeCells; // dirty, or holding proxies in some region: these get visited on the next pass
+    IndexVector _visitedCells;
+    uint32_t _numCategorizePasses { 0 };
+
     Views _views;
 };
 
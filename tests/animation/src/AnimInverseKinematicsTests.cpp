@@ -194,6 +194,9 @@ void AnimInverseKinematicsTests::testSingleChain() {
         QCOMPARE_WITH_ABS_ERROR(relativePoses[2].trans(), xAxis, acceptableTranslationError);
         QCOMPARE_WITH_ABS_ERROR(relativePoses[3].trans(), xAxis, acceptableTranslationError);
 
+        // the chain was already solved by the earlier frames, so the solver should stop well short of its loop limit
+        const int MAX_IK_LOOPS = 16;
+        QVERIFY(ikDoll.getNumIterationsOnLastSolve() < MAX_IK_LOOPS);
     }
     { // hard test IK of joint C
         // load intial poses that look like this:
@@ -305,3 +308,88 @@ void AnimInverseKinematicsTests::testBar() {
     QCOMPARE_WITH_ABS_ERROR(expectedTransC, poseC.trans(), EPSILON);
 }
 
+#ifdef MANUAL_TEST
+
+void AnimInverseKinematicsTests::benchmarkSolve() {
+    AnimContext context(false, false, false, glm::mat4(), glm::mat4(), 0);
+
+    // an arm of NUM_CHAIN_JOINTS joints hanging off a root that also carries NUM_OTHER_JOINTS joints untouched by IK,
+    // which is about the proportion of a full avatar skeleton an arm target solves for
+    const int NUM_CHAIN_JOINTS = 8;
+    const int NUM_OTHER_JOINTS = 92;
+
+    HFMModel hfmModel;
+    HFMJoint joint;
+    joint.isFree = false;
+    joint.distanceToParent = 1.0f;
+    joint.preTransform = glm::mat4();
+    joint.preRotation = identity;
+    joint.rotation = identity;
+    joint.postRotation = identity;
+    joint.postTransform = glm::mat4();
+    joint.rotationMin = glm::vec3(-PI);
+    joint.rotationMax = glm::vec3(PI);
+    joint.inverseDefaultRotation = identity;
+    joint.inverseBindRotation = identity;
+    joint.isSkeletonJoint = false;
+
+    joint.name = "Root";
+    joint.parentIndex = -1;
+    joint.translation = origin;
+    joint.transform = glm::mat4();
+    joint.bindTransform = joint.transform;
+    hfmModel.joints.push_back(joint);
+    for (int i = 0; i < NUM_CHAIN_JOINTS; ++i) {
+        joint.name = QString("Arm%1").arg(i);
+        joint.parentIndex = i;
+        joint.translation = xAxis;
+        joint.transform = hfmModel.joints[joint.parentIndex].transform * glm::translate(joint.translation);
+        joint.bindTransform = joint.transform;
+        hfmModel.joints.push_back(joint);
+    }
+    for (int i = 0; i < NUM_OTHER_JOINTS; ++i) {
+        joint.name = QString("Other%1").arg(i);
+        joint.parentIndex = 0;
+        joint.translation = yAxis;
+        joint.transform = glm::translate(joint.translation);
+        joint.bindTransform = joint.transform;
+        hfmModel.joints.push_back(joint);
+    }
+
+    AnimSkeleton::Pointer skeletonPtr = std::make_shared<AnimSkeleton>(hfmModel);
+    AnimInverseKinematics ikDoll("doll");
+    ikDoll.setSkeleton(skeletonPtr);
+
+    AnimPoseVec poses;
+    for (auto& hfmJoint : hfmModel.joints) {
+        poses.push_back(AnimPose(glm::vec3(1.0f), identity, hfmJoint.translation));
+    }
+    ikDoll.loadPoses(poses);
+
+    QString tipName = QString("Arm%1").arg(NUM_CHAIN_JOINTS - 1);
+    AnimVariantMap varMap;
+    varMap.set("rotationTip", identity);
+    varMap.set("targetTypeTip", (int)IKTarget::Type::RotationAndPosition);
+    varMap.set("poleVectorEnabledTip", false);
+
+    std::vector<float> flexCoefficients(NUM_CHAIN_JOINTS, 1.0f);
+    ikDoll.setTargetVars(tipName, QString("positionTip"), QString("rotationTip"), QString("targetTypeTip"),
+                         QString("weightTip"), 1.0f, flexCoefficients, QString("poleVectorEnabledTip"),
+                         QString("poleReferenceVectorTip"), QString("poleVectorTip"));
+    AnimVariantMap triggers;
+
+    // move the target in a circle so every solve has something to do
+    const float dt = 1.0f / 60.0f;
+    const float TARGET_RADIUS = 2.0f;
+    glm::vec3 center((float)NUM_CHAIN_JOINTS - 3.0f, 0.0f, 0.0f);
+    const float ANGLE_STEP = TWO_PI / 60.0f;
+    float angle = 0.0f;
+
+    QBENCHMARK {
+        varMap.set("positionTip", center + TARGET_RADIUS * glm::vec3(0.0f, cosf(angle), sinf(angle)));
+        poses = ikDoll.overlay(varMap, context, dt, triggers, poses);
+        angle = fmodf(angle + ANGLE_STEP, TWO_PI);
+    }
+}
+
+#endif // MANUAL_TEST
@@ -13,6 +13,8 @@
 #include <QtTest/QtTest>
 #include <glm/glm.hpp>
 
+//#define MANUAL_TEST
+
 inline float getErrorDifference(float a, float b) {
     return fabs(a - b);
 }
@@ -22,6 +24,9 @@ class AnimInverseKinematicsTests : public QObject {
 private slots:
     void testSingleChain();
     void testBar();
+#ifdef MANUAL_TEST
+    void benchmarkSolve();
+#endif // MANUAL_TEST
 };
 
 #endif // hifi_AnimInverseKinematicsTests_h
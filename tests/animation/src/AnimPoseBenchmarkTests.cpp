@@ -0,0 +1,150 @@
+//
+//  AnimPoseBenchmarkTests.cpp
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBenchmarkTests.h"
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include <AnimUtil.h>
+
+#include <test-utils/QTestExtensions.h>
+
+QTEST_GUILESS_MAIN(AnimPoseBenchmarkTests)
+
+// about the size of a full avatar skeleton, with fingers
+static const int NUM_JOINTS = 100;
+static const int NUM_BRANCHES = 5;
+
+static const float TEST_EPSILON = 0.0001f;
+
+static glm::quat randomRotation() {
+    glm::vec3 axis(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f));
+    if (glm::length(axis) < 0.01f) {
+        axis = glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+    return glm::angleAxis(randFloatInRange(-PI, PI), glm::normalize(axis));
+}
+
+static glm::vec3 randomTranslation() {
+    return glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f));
+}
+
+static AnimPose randomPose() {
+    return AnimPose(glm::vec3(randFloatInRange(0.5f, 2.0f)), randomRotation(), randomTranslation());
+}
+
+void AnimPoseBenchmarkTests::initTestCase() {
+    // a root with a few long chains hanging off it, like a spine, arms and legs
+    std::vector<HFMJoint> joints;
+    joints.reserve(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        HFMJoint joint;
+        joint.parentIndex = i == 0 ? -1 : (i <= NUM_BRANCHES ? 0 : i - NUM_BRANCHES);
+        joint.translation = randomTranslation();
+        joint.rotation = randomRotation();
+        joint.name = QString("joint%1").arg(i);
+        joint.isSkeletonJoint = true;
+        joints.push_back(joint);
+    }
+    _skeleton = std::make_shared<AnimSkeleton>(joints, QMap<int, glm::quat>());
+
+    _posesA.reserve(NUM_JOINTS);
+    _posesB.reserve(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        _posesA.push_back(randomPose());
+        _posesB.push_back(randomPose());
+    }
+}
+
+void AnimPoseBenchmarkTests::testMultiplyMatchesMatrices() {
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        // a uniformly scaled parent is composed directly from its parts
+        AnimPose result = _posesA[i] * _posesB[i];
+        glm::mat4 expected = (glm::mat4)_posesA[i] * (glm::mat4)_posesB[i];
+        QCOMPARE_WITH_ABS_ERROR((glm::mat4)result, expected, TEST_EPSILON);
+
+        // with the same sign as a rotation decomposed from the matrix
+        AnimPose decomposed(expected);
+        QVERIFY(glm::dot(result.rot(), decomposed.rot()) > 1.0f - TEST_EPSILON);
+
+        // a non-uniformly scaled parent still goes through the matrix
+        AnimPose skewedParent = _posesA[i];
+        skewedParent.scale() = glm::vec3(1.0f, 2.0f, 0.5f);
+        AnimPose skewedResult = skewedParent * _posesB[i];
+        AnimPose skewedDecomposed((glm::mat4)skewedParent * (glm::mat4)_posesB[i]);
+        QCOMPARE_WITH_ABS_ERROR(skewedResult.scale(), skewedDecomposed.scale(), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(skewedResult.trans(), skewedDecomposed.trans(), TEST_EPSILON);
+        QVERIFY(glm::dot(skewedResult.rot(), skewedDecomposed.rot()) > 1.0f - TEST_EPSILON);
+    }
+}
+
+void AnimPoseBenchmarkTests::testInverseMatchesMatrices() {
+    for (const auto& pose : _posesA) {
+        AnimPose inverse = pose.inverse();
+        glm::mat4 expected = glm::inverse((glm::mat4)pose);
+        QCOMPARE_WITH_ABS_ERROR((glm::mat4)inverse, expected, TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR((glm::mat4)(pose * inverse), glm::mat4(), TEST_EPSILON);
+    }
+}
+
+void AnimPoseBenchmarkTests::testBlendMatchesSafeLerp() {
+    const float alphas[] = { 0.0f, 0.25f, 0.5f, 0.9f, 1.0f };
+    AnimPoseVec result(NUM_JOINTS);
+    for (float alpha : alphas) {
+        ::blend(NUM_JOINTS, &_posesA[0], &_posesB[0], alpha, &result[0]);
+        for (int i = 0; i < NUM_JOINTS; i++) {
+            QCOMPARE_WITH_ABS_ERROR(result[i].scale(), lerp(_posesA[i].scale(), _posesB[i].scale(), alpha), TEST_EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].trans(), lerp(_posesA[i].trans(), _posesB[i].trans(), alpha), TEST_EPSILON);
+            glm::quat expectedRot = safeLerp(_posesA[i].rot(), _posesB[i].rot(), alpha);
+            QVERIFY(glm::dot(result[i].rot(), expectedRot) > 1.0f - TEST_EPSILON);
+        }
+    }
+
+    // blending in place, as the anim nodes sometimes do
+    AnimPoseVec inPlace = _posesB;
+    ::blend(NUM_JOINTS, &_posesA[0], &inPlace[0], 0.5f, &inPlace[0]);
+    ::blend(NUM_JOINTS, &_posesA[0], &_posesB[0], 0.5f, &result[0]);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        QCOMPARE(inPlace[i].trans(), result[i].trans());
+        QCOMPARE(inPlace[i].rot(), result[i].rot());
+    }
+}
+
+void AnimPoseBenchmarkTests::testRelativeToAbsoluteMatchesDefaults() {
+    AnimPoseVec poses = _skeleton->getRelativeDefaultPoses();
+    _skeleton->convertRelativePosesToAbsolute(poses);
+
+    const AnimPoseVec& absoluteDefaultPoses = _skeleton->getAbsoluteDefaultPoses();
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        QCOMPARE_WITH_ABS_ERROR((glm::mat4)poses[i], (glm::mat4)absoluteDefaultPoses[i], TEST_EPSILON);
+    }
+}
+
+#ifdef MANUAL_TEST
+
+void AnimPoseBenchmarkTests::benchmarkBlend() {
+    AnimPoseVec result(NUM_JOINTS);
+    QBENCHMARK {
+        ::blend(NUM_JOINTS, &_posesA[0], &_posesB[0], 0.3f, &result[0]);
+    }
+}
+
+void AnimPoseBenchmarkTests::benchmarkRelativeToAbsolute() {
+    const AnimPoseVec& relativePoses = _skeleton->getRelativeDefaultPoses();
+    AnimPoseVec poses;
+    QBENCHMARK {
+        poses = relativePoses;
+        _skeleton->convertRelativePosesToAbsolute(poses);
+    }
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,42 @@
+//
+//  AnimPoseBenchmarkTests.h
+//  tests/animation/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBenchmarkTests_h
+#define hifi_AnimPoseBenchmarkTests_h
+
+#include <memory>
+
+#include <QtTest/QtTest>
+
+#include <AnimSkeleton.h>
+
+//#define MANUAL_TEST
+
+class AnimPoseBenchmarkTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testMultiplyMatchesMatrices();
+    void testInverseMatchesMatrices();
+    void testBlendMatchesSafeLerp();
+    void testRelativeToAbsoluteMatchesDefaults();
+#ifdef MANUAL_TEST
+    void benchmarkBlend();
+    void benchmarkRelativeToAbsolute();
+#endif // MANUAL_TEST
+
+private:
+    AnimSkeleton::Pointer _skeleton;
+    AnimPoseVec _posesA;
+    AnimPoseVec _posesB;
+};
+
+#endif // hifi_AnimPoseBenchmarkTests_h
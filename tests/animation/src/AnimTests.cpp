@@ -10,11 +10,16 @@
 #include "AnimTests.h"
 #include <AnimNodeLoader.h>
 #include <AnimClip.h>
+#include <AnimClipData.h>
 #include <AnimBlendLinear.h>
+#include <AnimDefaultPose.h>
+#include <AnimManipulator.h>
 #include <AnimationLogging.h>
 #include <AnimVariant.h>
 #include <AnimExpression.h>
 #include <AnimUtil.h>
+#include <AnimationCache.h>
+#include <GLMHelpers.h>
 #include <NodeList.h>
 #include <AddressManager.h>
 #include <AccountManager.h>
@@ -146,6 +151,47 @@ void AnimTests::testClipEvaulateWithVars() {
     QVERIFY(clip._loopFlag == loopFlag2);
 }
 
+void AnimTests::testEvaluationCounts() {
+    AnimContext context(false, false, false, glm::mat4(), glm::mat4(), 0);
+
+    std::vector<HFMJoint> joints;
+    for (int i = 0; i < 3; i++) {
+        HFMJoint joint;
+        joint.parentIndex = i - 1;
+        joint.translation = glm::vec3(0.0f, 1.0f, 0.0f);
+        joint.name = QString("joint%1").arg(i);
+        joint.isSkeletonJoint = true;
+        joints.push_back(joint);
+    }
+    auto skeleton = std::make_shared<AnimSkeleton>(joints, QMap<int, glm::quat>());
+
+    auto blend = std::make_shared<AnimBlendLinear>("blend", 0.5f);
+    auto pose0 = std::make_shared<AnimDefaultPose>("pose0");
+    auto pose1 = std::make_shared<AnimDefaultPose>("pose1");
+    blend->addChild(pose0);
+    blend->addChild(pose1);
+    blend->setSkeleton(skeleton);
+
+    AnimVariantMap vars;
+    AnimVariantMap triggers;
+    QCOMPARE(blend->getEvaluationCount(), (uint64_t)0);
+
+    blend->evaluate(vars, context, 0.1f, triggers);
+    auto& poses = blend->evaluate(vars, context, 0.1f, triggers);
+    QCOMPARE((int)poses.size(), skeleton->getNumJoints());
+
+    // both children are blended, so every node is evaluated once per frame
+    QCOMPARE(blend->getEvaluationCount(), (uint64_t)2);
+    QCOMPARE(pose0->getEvaluationCount(), (uint64_t)2);
+    QCOMPARE(pose1->getEvaluationCount(), (uint64_t)2);
+
+    // overlaying counts as an evaluation too
+    auto manipulator = std::make_shared<AnimManipulator>("manipulator", 1.0f);
+    manipulator->setSkeleton(skeleton);
+    manipulator->overlay(vars, context, 0.1f, triggers, poses);
+    QCOMPARE(manipulator->getEvaluationCount(), (uint64_t)1);
+}
+
 void AnimTests::testLoader() {
     auto url = QUrl("https://gist.githubusercontent.com/hyperlogic/756e6b7018c96c9778dba4ffb959c3c7/raw/4b37f10c9d2636608916208ba7b415c1a3f842ff/test.json");
     // NOTE: This will warn about missing "test01.fbx", "test02.fbx", etc. if the resource loading code doesn't handle relative pathnames!
@@ -467,6 +513,303 @@ void AnimTests::testAnimPose() {
     QCOMPARE_WITH_ABS_ERROR(p.scale(), resultScale, TEST_EPSILON2);
 }
 
+void AnimTests::testBlendMatchesScalar() {
+    // blend() reads and writes each pose as ten floats, so it relies on this layout
+    AnimPose layoutPose;
+    QCOMPARE((const float*)&layoutPose.scale(), (const float*)&layoutPose);
+    QCOMPARE((const float*)&layoutPose.rot(), (const float*)&layoutPose + 3);
+    QCOMPARE((const float*)&layoutPose.trans(), (const float*)&layoutPose + 7);
+
+    const int NUM_POSES = 32;
+    AnimPoseVec posesA, posesB;
+    for (int i = 0; i < NUM_POSES; i++) {
+        float angle = (float)i * 0.37f;
+        glm::vec3 axis = glm::normalize(glm::vec3(1.0f, (float)(i % 3), (float)(i % 5) - 2.0f));
+        posesA.push_back(AnimPose(glm::vec3(1.0f + 0.1f * i), glm::angleAxis(angle, axis),
+                                  glm::vec3((float)i, -0.5f * i, 2.0f)));
+        // every other pose is in the opposite hemisphere, so both signs of the dot product are blended
+        glm::quat rotB = glm::angleAxis(-1.7f * angle, glm::vec3(axis.z, axis.x, axis.y));
+        posesB.push_back(AnimPose(glm::vec3(2.0f - 0.05f * i), (i % 2) ? -rotB : rotB,
+                                  glm::vec3(-1.0f, (float)i, 0.25f * i)));
+    }
+
+    const float alphas[] = { 0.0f, 0.3f, 0.5f, 1.0f };
+    for (float alpha : alphas) {
+        AnimPoseVec result(NUM_POSES), expected(NUM_POSES);
+        blend(NUM_POSES, &posesA[0], &posesB[0], alpha, &result[0]);
+        blendScalar(NUM_POSES, &posesA[0], &posesB[0], alpha, &expected[0]);
+        for (int i = 0; i < NUM_POSES; i++) {
+            QCOMPARE_WITH_ABS_ERROR(result[i].scale(), expected[i].scale(), TEST_EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].rot(), expected[i].rot(), TEST_EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].trans(), expected[i].trans(), TEST_EPSILON);
+        }
+    }
+}
+
+void AnimTests::testClipDataRotationPacking() {
+    const float PI = (float)M_PI;
+    const glm::quat ROT_X_90 = glm::angleAxis(PI / 2.0f, glm::vec3(1.0f, 0.0f, 0.0f));
+    const glm::quat ROT_Y_180 = glm::angleAxis(PI, glm::vec3(0.0f, 1.0, 0.0f));
+    const glm::quat ROT_Z_30 = glm::angleAxis(PI / 6.0f, glm::vec3(0.0f, 0.0f, 1.0f));
+
+    std::vector<glm::quat> rotVec = {
+        glm::quat(),
+        ROT_X_90,
+        ROT_Y_180,
+        ROT_Z_30,
+        ROT_X_90 * ROT_Y_180 * ROT_Z_30,
+        -ROT_Y_180,
+        -ROT_X_90 * ROT_Z_30,
+        glm::normalize(glm::quat(0.1f, -0.7f, 0.2f, 0.68f))
+    };
+
+    const float TEST_EPSILON2 = 0.00001f;
+    for (auto& rot : rotVec) {
+        glm::quat result = AnimClipData::unpackRotation(AnimClipData::packRotation(rot));
+
+        // q and -q are the same rotation
+        glm::quat expected = glm::dot(result, rot) < 0.0f ? -rot : rot;
+        QCOMPARE_WITH_ABS_ERROR(result, expected, TEST_EPSILON2);
+
+        // packing is stable, so tracks which don't change compare equal
+        QCOMPARE(AnimClipData::packRotation(result), AnimClipData::packRotation(rot));
+        QCOMPARE(AnimClipData::packRotation(-rot), AnimClipData::packRotation(rot));
+    }
+}
+
+static void addTestJoint(HFMModel& hfmModel, const QString& name, int parentIndex, const glm::vec3& translation) {
+    HFMJoint joint;
+    joint.name = name;
+    joint.parentIndex = parentIndex;
+    joint.translation = translation;
+    joint.preTransform = glm::mat4();
+    joint.preRotation = glm::quat();
+    joint.rotation = glm::quat();
+    joint.postRotation = glm::quat();
+    joint.postTransform = glm::mat4();
+    joint.isSkeletonJoint = true;
+    hfmModel.joints.push_back(joint);
+}
+
+// an avatar with a Head the animation below doesn't move, and hips a little higher than the animation's
+static void makeTestAvatarModel(HFMModel& hfmModel) {
+    addTestJoint(hfmModel, "Hips", -1, glm::vec3(0.0f, 1.0f, 0.0f));
+    addTestJoint(hfmModel, "Spine", 0, glm::vec3(0.0f, 0.3f, 0.0f));
+    addTestJoint(hfmModel, "Head", 1, glm::vec3(0.0f, 0.4f, 0.0f));
+    addTestJoint(hfmModel, "LeftUpLeg", 0, glm::vec3(0.1f, -0.1f, 0.0f));
+    addTestJoint(hfmModel, "RightUpLeg", 0, glm::vec3(-0.1f, -0.1f, 0.0f));
+}
+
+static void makeTestAnimationModel(HFMModel& hfmModel) {
+    addTestJoint(hfmModel, "Hips", -1, glm::vec3(0.0f, 0.9f, 0.0f));
+    addTestJoint(hfmModel, "Spine", 0, glm::vec3(0.0f, 0.25f, 0.0f));
+    addTestJoint(hfmModel, "LeftUpLeg", 0, glm::vec3(0.1f, -0.1f, 0.0f));
+    addTestJoint(hfmModel, "RightUpLeg", 0, glm::vec3(-0.1f, -0.1f, 0.0f));
+    hfmModel.joints[1].preRotation = glm::angleAxis(0.2f, glm::vec3(1.0f, 0.0f, 0.0f));
+
+    const int NUM_FRAMES = 8;
+    const int numJoints = (int)hfmModel.joints.size();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        const float t = (float)frame / (float)(NUM_FRAMES - 1);
+        HFMAnimationFrame animFrame;
+        for (int joint = 0; joint < numJoints; joint++) {
+            glm::vec3 axis = glm::normalize(glm::vec3(1.0f, (float)joint, 0.5f));
+            animFrame.rotations.push_back(glm::angleAxis(t * (0.3f + 0.2f * (float)joint), axis));
+            glm::vec3 translation = hfmModel.joints[joint].translation;
+            if (joint == 0) {
+                // the hips bob and sway
+                translation += glm::vec3(0.05f * sinf(6.0f * t), 0.02f * t, 0.0f);
+            }
+            animFrame.translations.push_back(translation);
+        }
+        hfmModel.animationFrames.push_back(animFrame);
+    }
+}
+
+// the per-clip retarget AnimClip::copyFromNetworkAnim used to do, kept as is to check AnimClipData against
+static std::vector<AnimPoseVec> retargetUnshared(const HFMModel& animModel, const AnimSkeleton& avatarSkeleton) {
+    std::vector<AnimPoseVec> anim;
+
+    AnimSkeleton animSkeleton(animModel);
+    const int animJointCount = animSkeleton.getNumJoints();
+    const int avatarJointCount = avatarSkeleton.getNumJoints();
+
+    std::vector<int> avatarToAnimJointIndexMap;
+    for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
+        avatarToAnimJointIndexMap.push_back(animSkeleton.nameToJointIndex(avatarSkeleton.getJointName(avatarJointIndex)));
+    }
+
+    const int animFrameCount = animModel.animationFrames.size();
+    anim.resize(animFrameCount);
+
+    float boneLengthScale = 1.0f;
+    const int avatarHipsIndex = avatarSkeleton.nameToJointIndex("Hips");
+    const int animHipsIndex = animSkeleton.nameToJointIndex("Hips");
+    if (avatarHipsIndex != -1 && animHipsIndex != -1) {
+        const int avatarHipsParentIndex = avatarSkeleton.getParentIndex(avatarHipsIndex);
+        const int animHipsParentIndex = animSkeleton.getParentIndex(animHipsIndex);
+
+        const AnimPose& avatarHipsAbsoluteDefaultPose = avatarSkeleton.getAbsoluteDefaultPose(avatarHipsIndex);
+        const AnimPose& animHipsAbsoluteDefaultPose = animSkeleton.getAbsoluteDefaultPose(animHipsIndex);
+
+        const float avatarUnitScale = extractScale(avatarSkeleton.getGeometryOffset()).y;
+        const float animationUnitScale = extractScale(animModel.offset).y;
+        const float avatarHeightInMeters = avatarUnitScale * avatarHipsAbsoluteDefaultPose.trans().y;
+        const float animHeightInMeters = animationUnitScale * animHipsAbsoluteDefaultPose.trans().y;
+
+        float avatarHipsParentScale = 1.0f;
+        if (avatarHipsParentIndex != -1) {
+            avatarHipsParentScale = avatarSkeleton.getAbsoluteDefaultPose(avatarHipsParentIndex).scale().y;
+        }
+        float animHipsParentScale = 1.0f;
+        if (animHipsParentIndex != -1) {
+            animHipsParentScale = animSkeleton.getAbsoluteDefaultPose(animHipsParentIndex).scale().y;
+        }
+
+        const float EPSILON = 0.0001f;
+        if ((fabsf(animHeightInMeters) > EPSILON) && (animationUnitScale > EPSILON) && (animHipsParentScale > EPSILON)) {
+            const float avatarToAnimationHeightRatio = avatarHeightInMeters / animHeightInMeters;
+            const float unitsRatio = 1.0f / (avatarUnitScale / animationUnitScale);
+            const float parentScaleRatio = 1.0f / (avatarHipsParentScale / animHipsParentScale);
+
+            boneLengthScale = avatarToAnimationHeightRatio * unitsRatio * parentScaleRatio;
+        }
+    }
+
+    for (int frame = 0; frame < animFrameCount; frame++) {
+        const HFMAnimationFrame& animFrame = animModel.animationFrames[frame];
+
+        std::vector<glm::quat> animRotations;
+        animRotations.reserve(animJointCount);
+        for (int i = 0; i < animJointCount; i++) {
+            animRotations.push_back(animModel.joints[i].preRotation * animFrame.rotations[i] * animModel.joints[i].postRotation);
+        }
+        animSkeleton.convertRelativeRotationsToAbsolute(animRotations);
+
+        std::vector<glm::quat> avatarRotations;
+        avatarRotations.reserve(avatarJointCount);
+        for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
+            int animJointIndex = avatarToAnimJointIndexMap[avatarJointIndex];
+            if (animJointIndex >= 0) {
+                avatarRotations.push_back(animRotations[animJointIndex]);
+            } else {
+                glm::quat avatarRelativeDefaultRot = avatarSkeleton.getRelativeDefaultPose(avatarJointIndex).rot();
+                glm::quat avatarParentAbsoluteRot;
+                int avatarParentJointIndex = avatarSkeleton.getParentIndex(avatarJointIndex);
+                if (avatarParentJointIndex >= 0) {
+                    avatarParentAbsoluteRot = avatarRotations[avatarParentJointIndex];
+                }
+                avatarRotations.push_back(avatarParentAbsoluteRot * avatarRelativeDefaultRot);
+            }
+        }
+        avatarSkeleton.convertAbsoluteRotationsToRelative(avatarRotations);
+
+        anim[frame].reserve(avatarJointCount);
+        for (int avatarJointIndex = 0; avatarJointIndex < avatarJointCount; avatarJointIndex++) {
+            const AnimPose& avatarDefaultPose = avatarSkeleton.getRelativeDefaultPose(avatarJointIndex);
+            glm::vec3 relativeScale = avatarDefaultPose.scale();
+
+            glm::vec3 relativeTranslation;
+            int animJointIndex = avatarToAnimJointIndexMap[avatarJointIndex];
+            if (animJointIndex >= 0) {
+                const glm::vec3& animTrans = animFrame.translations[animJointIndex];
+                const glm::vec3& animZeroTrans = animModel.animationFrames[0].translations[animJointIndex];
+                relativeTranslation = avatarDefaultPose.trans() + boneLengthScale * (animTrans - animZeroTrans);
+            } else {
+                relativeTranslation = avatarDefaultPose.trans();
+            }
+            anim[frame].push_back(AnimPose(relativeScale, avatarRotations[avatarJointIndex], relativeTranslation));
+        }
+    }
+    return anim;
+}
+
+void AnimTests::testClipDataMatchesUnsharedRetarget() {
+    HFMModel avatarModel;
+    makeTestAvatarModel(avatarModel);
+    AnimSkeleton avatarSkeleton(avatarModel);
+
+    HFMModel animModel;
+    makeTestAnimationModel(animModel);
+
+    std::vector<AnimPoseVec> expectedFrames = retargetUnshared(animModel, avatarSkeleton);
+
+    // the mirrored frames used to be mirrored from the plain ones as AnimClip played them
+    std::vector<AnimPoseVec> expectedMirroredFrames = expectedFrames;
+    for (auto& frame : expectedMirroredFrames) {
+        avatarSkeleton.mirrorRelativePoses(frame);
+    }
+
+    const float TEST_EPSILON2 = 0.0001f;
+    for (bool mirrored : { false, true }) {
+        AnimClipData clipData(animModel, avatarSkeleton, mirrored);
+        const std::vector<AnimPoseVec>& expected = mirrored ? expectedMirroredFrames : expectedFrames;
+
+        QCOMPARE(clipData.getNumFrames(), (int)expected.size());
+        QCOMPARE(clipData.getNumJoints(), avatarSkeleton.getNumJoints());
+
+        AnimPoseVec poses(clipData.getNumJoints());
+        for (int frame = 0; frame < clipData.getNumFrames(); frame++) {
+            clipData.getFrame(frame, poses);
+            for (int joint = 0; joint < clipData.getNumJoints(); joint++) {
+                const AnimPose& expectedPose = expected[frame][joint];
+                glm::quat expectedRot = glm::dot(poses[joint].rot(), expectedPose.rot()) < 0.0f ? -expectedPose.rot() : expectedPose.rot();
+                QCOMPARE_WITH_ABS_ERROR(poses[joint].scale(), expectedPose.scale(), TEST_EPSILON2);
+                QCOMPARE_WITH_ABS_ERROR(poses[joint].rot(), expectedRot, TEST_EPSILON2);
+                QCOMPARE_WITH_ABS_ERROR(poses[joint].trans(), expectedPose.trans(), TEST_EPSILON2);
+            }
+        }
+    }
+}
+
+// an animation which has finished loading, without going to the network for it
+class TestAnimation : public Animation {
+public:
+    TestAnimation(const QUrl& url, HFMModel::Pointer hfmModel) : Animation(url) { animationParseSuccess(hfmModel); }
+};
+
+void AnimTests::testClipDataSharing() {
+    auto animationCache = DependencyManager::get<AnimationCache>();
+    const QUrl url("https://example.com/walk.fbx");
+
+    auto animModel = std::make_shared<HFMModel>();
+    makeTestAnimationModel(*animModel);
+    AnimationPointer animation(new TestAnimation(url, animModel));
+    QVERIFY(animation->isLoaded());
+
+    // two avatars with skeletons built separately from the same model
+    HFMModel avatarModel;
+    makeTestAvatarModel(avatarModel);
+    AnimSkeleton firstSkeleton(avatarModel);
+    AnimSkeleton secondSkeleton(avatarModel);
+    QCOMPARE(AnimClipData::computeSkeletonSignature(firstSkeleton), AnimClipData::computeSkeletonSignature(secondSkeleton));
+
+    auto firstClipData = animationCache->getRetargetedAnimation(animation, firstSkeleton);
+    auto secondClipData = animationCache->getRetargetedAnimation(animation, secondSkeleton);
+    QVERIFY(firstClipData);
+    QVERIFY(firstClipData == secondClipData);
+
+    auto mirroredClipData = animationCache->getRetargetedAnimation(animation, secondSkeleton, true);
+    QVERIFY(mirroredClipData);
+    QVERIFY(mirroredClipData != firstClipData);
+    QVERIFY(mirroredClipData == animationCache->getRetargetedAnimation(animation, firstSkeleton, true));
+
+    // a skeleton with different bones gets its own frames
+    HFMModel otherAvatarModel;
+    makeTestAvatarModel(otherAvatarModel);
+    otherAvatarModel.joints[1].translation = glm::vec3(0.0f, 0.5f, 0.0f);
+    AnimSkeleton otherSkeleton(otherAvatarModel);
+    QVERIFY(animationCache->getRetargetedAnimation(animation, otherSkeleton) != firstClipData);
+
+    // a refreshed animation has the same URL but new frames, which must not be served from the old entry
+    auto refreshedModel = std::make_shared<HFMModel>();
+    makeTestAnimationModel(*refreshedModel);
+    AnimationPointer refreshedAnimation(new TestAnimation(url, refreshedModel));
+    auto refreshedClipData = animationCache->getRetargetedAnimation(refreshedAnimation, firstSkeleton);
+    QVERIFY(refreshedClipData);
+    QVERIFY(refreshedClipData != firstClipData);
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
@@ -23,10 +23,15 @@ private slots:
     void testClipInternalState();
     void testClipEvaulate();
     void testClipEvaulateWithVars();
+    void testEvaluationCounts();
     void testLoader();
     void testVariant();
     void testAccumulateTime();
     void testAnimPose();
+    void testBlendMatchesScalar();
+    void testClipDataRotationPacking();
+    void testClipDataMatchesUnsharedRetarget();
+    void testClipDataSharing();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
@@ -0,0 +1,82 @@
+//
+//  JSBakerBenchmarkTest.cpp
+//  tests/baking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JSBakerBenchmarkTest.h"
+
+QTEST_GUILESS_MAIN(JSBakerBenchmarkTest)
+
+// roughly the size of the bundled libraries domains load
+static const int SCRIPT_SIZE_BYTES = 4 * 1024 * 1024;
+
+// a mix of the constructs the minifier has to handle: comments, quoted strings, indentation,
+// CRLF line endings and non-ASCII text
+static const char* SCRIPT_CHUNK =
+    "/*\n"
+    " * Utility functions\n"
+    " */\n"
+    "(function () {\r\n"
+    "    \"use strict\";\n"
+    "\n"
+    "    var DEFAULT_NAME = 'Caf\xC3\xA9 \xE2\x98\x95';   // a name with non-ASCII characters\n"
+    "    var template = `value: ${value}`;\n"
+    "\n"
+    "    function clamp(value, min, max) {\n"
+    "        if (value < min) {\n"
+    "            return min;\n"
+    "        }\n"
+    "        return value > max ? max : value;\n"
+    "    }\n"
+    "\n"
+    "    // keep a + ++b and a - --b apart\n"
+    "    var total = a + ++b - --c / 2;\n"
+    "\t\tmodule.exports = { clamp: clamp, name: DEFAULT_NAME };\n"
+    "}());\n";
+
+void JSBakerBenchmarkTest::initTestCase() {
+    QByteArray chunk { SCRIPT_CHUNK };
+    _script.reserve(SCRIPT_SIZE_BYTES + chunk.size());
+    while (_script.size() < SCRIPT_SIZE_BYTES) {
+        _script.append(chunk);
+    }
+}
+
+void JSBakerBenchmarkTest::testBakedScriptContents() {
+    QByteArray output;
+    QVERIFY(JSBaker::bakeJS(SCRIPT_CHUNK, output));
+
+    // comments, indentation and carriage returns are gone
+    QVERIFY(!output.contains("Utility functions"));
+    QVERIFY(!output.contains("keep a +"));
+    QVERIFY(!output.contains("    "));
+    QVERIFY(!output.contains('\r'));
+    QVERIFY(!output.contains('\t'));
+
+    // strings and non-ASCII text are untouched, and so are the spaces that keep operators apart
+    QVERIFY(output.contains("var DEFAULT_NAME='Caf\xC3\xA9 \xE2\x98\x95';"));
+    QVERIFY(output.contains("`value: ${value}`"));
+    QVERIFY(output.contains("function clamp(value,min,max){if(value<min){return min;}"));
+    QVERIFY(output.contains("var total=a + ++b - --c / 2;"));
+
+    // a large script bakes to the same output for its first chunk
+    QByteArray scriptOutput;
+    QVERIFY(JSBaker::bakeJS(_script, scriptOutput));
+    QVERIFY(scriptOutput.startsWith(output));
+}
+
+#ifdef MANUAL_TEST
+
+void JSBakerBenchmarkTest::benchmarkBakeJS() {
+    QBENCHMARK {
+        QByteArray output;
+        JSBaker::bakeJS(_script, output);
+    }
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,33 @@
+//
+//  JSBakerBenchmarkTest.h
+//  tests/baking/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JSBakerBenchmarkTest_h
+#define hifi_JSBakerBenchmarkTest_h
+
+#include <QtTest/QtTest>
+#include <JSBaker.h>
+
+//#define MANUAL_TEST
+
+class JSBakerBenchmarkTest : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testBakedScriptContents();
+#ifdef MANUAL_TEST
+    void benchmarkBakeJS();
+#endif // MANUAL_TEST
+
+private:
+    QByteArray _script;
+};
+
+#endif // hifi_JSBakerBenchmarkTest_h
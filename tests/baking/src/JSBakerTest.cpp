@@ -79,6 +79,13 @@ void JSBakerTest::setTestCases() {
 
     //a - --b is minified as a- --b.
     _testCases.emplace_back("a - --b", "a - --b");
+
+    // UTF-8 text is treated like letters and copied as is
+    _testCases.emplace_back("var \xC3\xA9 = '\xE2\x98\x95';", "var \xC3\xA9='\xE2\x98\x95';");
+    _testCases.emplace_back("\xC3\xA9\n\xC3\xA9", "\xC3\xA9\n\xC3\xA9");
+
+    // A leading byte order mark is dropped
+    _testCases.emplace_back("\xEF\xBB\xBFvar a=1;", "var a=1;");
 }
 
 void JSBakerTest::testJSBaking() {
@@ -0,0 +1,442 @@
+//
+//  FBXTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FBXTests.h"
+
+#include <algorithm>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QDataStream>
+#include <QtCore/QDirIterator>
+#include <QtCore/QtEndian>
+
+#include <FBX.h>
+#include <FBXSerializer.h>
+
+QTEST_GUILESS_MAIN(FBXTests)
+
+static QString getRootPath() {
+    return QDir::cleanPath(QFileInfo(__FILE__).absolutePath() + "/../../..");
+}
+
+static FBXNode parseFBXData(QByteArray& data) {
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    return FBXSerializer::parseFBX(&buffer);
+}
+
+// The serial QDataStream parser FBXSerializer::parseFBX used before it decoded arrays in place, which the
+// current parser must agree with.
+namespace serial {
+
+template<class T>
+int streamSize() {
+    return sizeof(T);
+}
+
+template<bool>
+int streamSize() {
+    return 1;
+}
+
+template<class T>
+QVariant readBinaryArray(QDataStream& in, int& position) {
+    quint32 arrayLength;
+    quint32 encoding;
+    quint32 compressedLength;
+
+    in >> arrayLength;
+    in >> encoding;
+    in >> compressedLength;
+    position += sizeof(quint32) * 3;
+
+    QVector<T> values;
+    if ((int)QSysInfo::ByteOrder == (int)in.byteOrder()) {
+        values.resize(arrayLength);
+        hifi::ByteArray arrayData;
+        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+            // preface encoded data with uncompressed length
+            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
+            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
+            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
+            position += compressedLength;
+            arrayData = qUncompress(compressed);
+            if (arrayData.isEmpty() ||
+                (unsigned int)arrayData.size() != (sizeof(T) * arrayLength)) { // answers empty byte array if corrupt
+                throw QString("corrupt fbx file");
+            }
+        } else {
+            arrayData.resize(sizeof(T) * arrayLength);
+            position += sizeof(T) * arrayLength;
+            in.readRawData(arrayData.data(), arrayData.size());
+        }
+
+        if (arrayData.size() > 0) {
+            memcpy(&values[0], arrayData.constData(), arrayData.size());
+        }
+    } else {
+        values.reserve(arrayLength);
+        if (encoding == FBX_PROPERTY_COMPRESSED_FLAG) {
+            // preface encoded data with uncompressed length
+            hifi::ByteArray compressed(sizeof(quint32) + compressedLength, 0);
+            *((quint32*)compressed.data()) = qToBigEndian<quint32>(arrayLength * sizeof(T));
+            in.readRawData(compressed.data() + sizeof(quint32), compressedLength);
+            position += compressedLength;
+            hifi::ByteArray uncompressed = qUncompress(compressed);
+            if (uncompressed.isEmpty()) { // answers empty byte array if corrupt
+                throw QString("corrupt fbx file");
+            }
+            QDataStream uncompressedIn(uncompressed);
+            uncompressedIn.setByteOrder(QDataStream::LittleEndian);
+            uncompressedIn.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
+            for (quint32 i = 0; i < arrayLength; i++) {
+                T value;
+                uncompressedIn >> value;
+                values.append(value);
+            }
+        } else {
+            for (quint32 i = 0; i < arrayLength; i++) {
+                T value;
+                in >> value;
+                position += streamSize<T>();
+                values.append(value);
+            }
+        }
+    }
+    return QVariant::fromValue(values);
+}
+
+QVariant parseBinaryFBXProperty(QDataStream& in, int& position) {
+    char ch;
+    in.device()->getChar(&ch);
+    position++;
+    switch (ch) {
+        case 'Y': {
+            qint16 value;
+            in >> value;
+            position += sizeof(qint16);
+            return QVariant::fromValue(value);
+        }
+        case 'C': {
+            bool value;
+            in >> value;
+            position++;
+            return QVariant::fromValue(value);
+        }
+        case 'I': {
+            qint32 value;
+            in >> value;
+            position += sizeof(qint32);
+            return QVariant::fromValue(value);
+        }
+        case 'F': {
+            float value;
+            in >> value;
+            position += sizeof(float);
+            return QVariant::fromValue(value);
+        }
+        case 'D': {
+            double value;
+            in >> value;
+            position += sizeof(double);
+            return QVariant::fromValue(value);
+        }
+        case 'L': {
+            qint64 value;
+            in >> value;
+            position += sizeof(qint64);
+            return QVariant::fromValue(value);
+        }
+        case 'f': {
+            return readBinaryArray<float>(in, position);
+        }
+        case 'd': {
+            return readBinaryArray<double>(in, position);
+        }
+        case 'l': {
+            return readBinaryArray<qint64>(in, position);
+        }
+        case 'i': {
+            return readBinaryArray<qint32>(in, position);
+        }
+        case 'b': {
+            return readBinaryArray<bool>(in, position);
+        }
+        case 'S':
+        case 'R': {
+            quint32 length;
+            in >> length;
+            position += sizeof(quint32) + length;
+            return QVariant::fromValue(in.device()->read(length));
+        }
+        default:
+            throw QString("Unknown property type: ") + ch;
+    }
+}
+
+FBXNode parseBinaryFBXNode(QDataStream& in, int& position, bool has64BitPositions) {
+    qint64 endOffset;
+    quint64 propertyCount;
+    quint64 propertyListLength;
+    quint8 nameLength;
+
+    if (has64BitPositions) {
+        in >> endOffset;
+        in >> propertyCount;
+        in >> propertyListLength;
+        position += sizeof(quint64) * 3;
+    } else {
+        qint32 tempEndOffset;
+        quint32 tempPropertyCount;
+        quint32 tempPropertyListLength;
+        in >> tempEndOffset;
+        in >> tempPropertyCount;
+        in >> tempPropertyListLength;
+        position += sizeof(quint32) * 3;
+        endOffset = tempEndOffset;
+        propertyCount = tempPropertyCount;
+        propertyListLength = tempPropertyListLength;
+    }
+    in >> nameLength;
+    position += sizeof(quint8);
+
+    FBXNode node;
+    const int MIN_VALID_OFFSET = 40;
+    if (endOffset < MIN_VALID_OFFSET || nameLength == 0) {
+        // use a null name to indicate a null node
+        return node;
+    }
+    node.name = in.device()->read(nameLength);
+    position += nameLength;
+
+    for (quint32 i = 0; i < propertyCount; i++) {
+        node.properties.append(parseBinaryFBXProperty(in, position));
+    }
+
+    while (endOffset > position) {
+        FBXNode child = parseBinaryFBXNode(in, position, has64BitPositions);
+        if (!child.name.isNull()) {
+            node.children.append(child);
+        }
+    }
+
+    return node;
+}
+
+FBXNode parseFBX(QIODevice* device) {
+    QDataStream in(device);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setVersion(QDataStream::Qt_4_5); // for single/double precision switch
+
+    in.skipRawData(FBX_HEADER_BYTES_BEFORE_VERSION);
+    int position = FBX_HEADER_BYTES_BEFORE_VERSION;
+    quint32 fileVersion;
+    in >> fileVersion;
+    position += sizeof(fileVersion);
+    bool has64BitPositions = (fileVersion >= FBX_VERSION_2016);
+
+    FBXNode top;
+    while (device->bytesAvailable()) {
+        FBXNode next = parseBinaryFBXNode(in, position, has64BitPositions);
+        if (next.name.isNull()) {
+            return top;
+
+        } else {
+            top.children.append(next);
+        }
+    }
+
+    return top;
+}
+
+}
+
+static FBXNode parseSerialFBXData(QByteArray& data) {
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    return serial::parseFBX(&buffer);
+}
+
+template<class T>
+static void appendLittleEndian(QByteArray& data, T value) {
+    char bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    std::reverse(bytes, bytes + sizeof(T));
+#endif
+    data.append(bytes, sizeof(T));
+}
+
+template<class T>
+static void appendArrayProperty(QByteArray& properties, char type, const QVector<T>& values, bool compressed) {
+    QByteArray data;
+    for (const T& value : values) {
+        appendLittleEndian(data, value);
+    }
+    if (compressed) {
+        // qCompress prefixes the zlib stream with the uncompressed length, which FBX keeps in the array header
+        data = qCompress(data).mid(sizeof(quint32));
+    }
+    properties.append(type);
+    appendLittleEndian<quint32>(properties, values.size());
+    appendLittleEndian<quint32>(properties, compressed ? FBX_PROPERTY_COMPRESSED_FLAG : 0);
+    appendLittleEndian<quint32>(properties, data.size());
+    properties.append(data);
+}
+
+// appends a childless node, with the 32 bit offsets of files older than FBX 2016
+static void appendNode(QByteArray& document, const QByteArray& name, int propertyCount, const QByteArray& properties) {
+    const int NODE_HEADER_SIZE = 3 * sizeof(quint32) + sizeof(quint8);
+    appendLittleEndian<quint32>(document, document.size() + NODE_HEADER_SIZE + name.size() + properties.size());
+    appendLittleEndian<quint32>(document, propertyCount);
+    appendLittleEndian<quint32>(document, properties.size());
+    appendLittleEndian<quint8>(document, name.size());
+    document.append(name);
+    document.append(properties);
+}
+
+static void compareProperties(const QVariant& actual, const QVariant& expected) {
+    QCOMPARE(actual.userType(), expected.userType());
+    const int type = actual.userType();
+    if (type == qMetaTypeId<QVector<double>>()) {
+        QCOMPARE(actual.value<QVector<double>>(), expected.value<QVector<double>>());
+    } else if (type == qMetaTypeId<QVector<float>>()) {
+        QCOMPARE(actual.value<QVector<float>>(), expected.value<QVector<float>>());
+    } else if (type == qMetaTypeId<QVector<qint64>>()) {
+        QCOMPARE(actual.value<QVector<qint64>>(), expected.value<QVector<qint64>>());
+    } else if (type == qMetaTypeId<QVector<qint32>>()) {
+        QCOMPARE(actual.value<QVector<qint32>>(), expected.value<QVector<qint32>>());
+    } else if (type == qMetaTypeId<QVector<bool>>()) {
+        QCOMPARE(actual.value<QVector<bool>>(), expected.value<QVector<bool>>());
+    } else {
+        QCOMPARE(actual, expected);
+    }
+}
+
+static void compareNodes(const FBXNode& actual, const FBXNode& expected) {
+    QCOMPARE(actual.name, expected.name);
+    QCOMPARE(actual.properties.size(), expected.properties.size());
+    for (int i = 0; i < actual.properties.size(); i++) {
+        compareProperties(actual.properties.at(i), expected.properties.at(i));
+        if (QTest::currentTestFailed()) {
+            qDebug() << "in property" << i << "of" << actual.name;
+            return;
+        }
+    }
+    QCOMPARE(actual.children.size(), expected.children.size());
+    for (int i = 0; i < actual.children.size(); i++) {
+        compareNodes(actual.children.at(i), expected.children.at(i));
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+}
+
+void FBXTests::initTestCase() {
+    // the binary FBX models and animations that ship with interface make up the test set
+    static const QStringList FBX_DIRECTORIES {
+        "/interface/resources/meshes",
+        "/interface/resources/avatar/animations"
+    };
+
+    for (const auto& directory : FBX_DIRECTORIES) {
+        QDirIterator it(getRootPath() + directory, { "*.fbx" }, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            QFile file(it.next());
+            if (file.open(QIODevice::ReadOnly)) {
+                QByteArray data = file.readAll();
+                if (data.startsWith(FBX_BINARY_PROLOG)) {
+                    _binaryFiles.push_back(data);
+                }
+            }
+        }
+    }
+}
+
+void FBXTests::testParseBinaryFBX() {
+    if (_binaryFiles.isEmpty()) {
+        QSKIP("No binary FBX files found");
+    }
+
+    for (auto& data : _binaryFiles) {
+        FBXNode root = parseFBXData(data);
+        QVERIFY(!root.children.isEmpty());
+
+        compareNodes(root, parseSerialFBXData(data));
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+}
+
+void FBXTests::testParseCompressedArrays() {
+    QVector<double> doubles;
+    QVector<float> floats;
+    QVector<qint32> ints;
+    QVector<qint64> longs;
+    const int NUM_VALUES = 1000;
+    for (int i = 0; i < NUM_VALUES; i++) {
+        doubles.push_back(sin(0.01 * i));
+        floats.push_back((float)i * 0.5f);
+        ints.push_back(i % 7 - 3);
+        longs.push_back((qint64)i << 33);
+    }
+
+    QByteArray document = FBX_BINARY_PROLOG + FBX_BINARY_PROLOG2;
+    const quint32 FBX_VERSION_2014 = 7400;
+    appendLittleEndian<quint32>(document, FBX_VERSION_2014);
+
+    QByteArray properties;
+    appendArrayProperty(properties, 'd', doubles, true);
+    appendArrayProperty(properties, 'f', floats, true);
+    appendArrayProperty(properties, 'i', ints, false);
+    appendArrayProperty(properties, 'l', longs, true);
+    appendNode(document, "Arrays", 4, properties);
+
+    properties.clear();
+    properties.append('S');
+    appendLittleEndian<quint32>(properties, 4);
+    properties.append("Mesh");
+    properties.append('D');
+    appendLittleEndian<double>(properties, 2.5);
+    appendNode(document, "Scalars", 2, properties);
+
+    // the null node that ends the document
+    document.append(QByteArray(3 * sizeof(quint32) + sizeof(quint8), '\0'));
+
+    FBXNode root = parseFBXData(document);
+    QCOMPARE(root.children.size(), 2);
+
+    const FBXNode& arrays = root.children.at(0);
+    QCOMPARE(arrays.name, QByteArray("Arrays"));
+    QCOMPARE(arrays.properties.size(), 4);
+    QCOMPARE(arrays.properties.at(0).value<QVector<double>>(), doubles);
+    QCOMPARE(arrays.properties.at(1).value<QVector<float>>(), floats);
+    QCOMPARE(arrays.properties.at(2).value<QVector<qint32>>(), ints);
+    QCOMPARE(arrays.properties.at(3).value<QVector<qint64>>(), longs);
+
+    const FBXNode& scalars = root.children.at(1);
+    QCOMPARE(scalars.properties.at(0).value<hifi::ByteArray>(), QByteArray("Mesh"));
+    QCOMPARE(scalars.properties.at(1).value<double>(), 2.5);
+
+    compareNodes(root, parseSerialFBXData(document));
+}
+
+#ifdef MANUAL_TEST
+
+void FBXTests::benchmarkParseBinaryFBX() {
+    QBENCHMARK {
+        for (auto& data : _binaryFiles) {
+            parseFBXData(data);
+        }
+    }
+}
+
+#endif // MANUAL_TEST
@@ -0,0 +1,33 @@
+//
+//  FBXTests.h
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FBXTests_h
+#define hifi_FBXTests_h
+
+#include <QtTest/QtTest>
+
+//#define MANUAL_TEST
+
+class FBXTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testParseBinaryFBX();
+    void testParseCompressedArrays();
+#ifdef MANUAL_TEST
+    void benchmarkParseBinaryFBX();
+#endif // MANUAL_TEST
+
+private:
+    QList<QByteArray> _binaryFiles;
+};
+
+#endif // hifi_FBXTests_h
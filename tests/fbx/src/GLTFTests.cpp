@@ -0,0 +1,425 @@
+//
+//  GLTFTests.cpp
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "GLTFTests.h"
+
+#include <climits>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <DependencyManager.h>
+#include <GLTFSerializer.h>
+#include <ResourceManager.h>
+
+QTEST_GUILESS_MAIN(GLTFTests)
+
+static const int TRIANGLES_MODE = 4;
+
+static int getComponentCount(const QString& type) {
+    if (type == "VEC2") {
+        return 2;
+    } else if (type == "VEC3") {
+        return 3;
+    } else if (type == "VEC4") {
+        return 4;
+    }
+    return 1;
+}
+
+static int getComponentSize(int componentType) {
+    switch (componentType) {
+    case GLTFAccessorComponentType::BYTE:
+    case GLTFAccessorComponentType::UNSIGNED_BYTE:
+        return 1;
+    case GLTFAccessorComponentType::SHORT:
+    case GLTFAccessorComponentType::UNSIGNED_SHORT:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+// The serial QDataStream reader GLTFSerializer::readArray used before it copied accessor views in bulk, which the
+// current reader must agree with.  That reader ignored bufferView.byteStride, so this one seeks to each element.
+namespace serial {
+
+template<class T>
+QVector<double> readArray(QDataStream& blobstream, qint64 start, int count, int byteStride, int bufferCount) {
+    QVector<double> values;
+    for (int i = 0; i < count; i++) {
+        blobstream.device()->seek(start + (qint64)i * byteStride);
+        for (int j = 0; j < bufferCount; j++) {
+            T value;
+            blobstream >> value;
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+QVector<double> readAccessor(const QJsonObject& document, const QByteArray& bin, int accessorIndex) {
+    QJsonObject accessor = document["accessors"].toArray()[accessorIndex].toObject();
+    QJsonObject bufferView = document["bufferViews"].toArray()[accessor["bufferView"].toInt()].toObject();
+
+    int componentType = accessor["componentType"].toInt();
+    int count = accessor["count"].toInt();
+    int bufferCount = getComponentCount(accessor["type"].toString());
+    int byteStride = bufferView["byteStride"].toInt(getComponentSize(componentType) * bufferCount);
+    qint64 start = bufferView["byteOffset"].toInt() + accessor["byteOffset"].toInt();
+
+    QBuffer device;
+    device.setData(bin);
+    device.open(QIODevice::ReadOnly);
+    QDataStream blobstream(&device);
+    blobstream.setByteOrder(QDataStream::LittleEndian);
+    blobstream.setVersion(QDataStream::Qt_5_9);
+    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
+
+    switch (componentType) {
+    case GLTFAccessorComponentType::BYTE:
+        return readArray<qint8>(blobstream, start, count, byteStride, bufferCount);
+    case GLTFAccessorComponentType::UNSIGNED_BYTE:
+        return readArray<quint8>(blobstream, start, count, byteStride, bufferCount);
+    case GLTFAccessorComponentType::SHORT:
+        return readArray<qint16>(blobstream, start, count, byteStride, bufferCount);
+    case GLTFAccessorComponentType::UNSIGNED_SHORT:
+        return readArray<quint16>(blobstream, start, count, byteStride, bufferCount);
+    case GLTFAccessorComponentType::UNSIGNED_INT:
+        return readArray<quint32>(blobstream, start, count, byteStride, bufferCount);
+    default:
+        return readArray<float>(blobstream, start, count, byteStride, bufferCount);
+    }
+}
+
+}
+
+template<class T>
+static void appendLittleEndian(QByteArray& data, T value) {
+    T littleEndian = qToLittleEndian(value);
+    data.append(reinterpret_cast<const char*>(&littleEndian), sizeof(T));
+}
+
+template<>
+void appendLittleEndian(QByteArray& data, float value) {
+    quint32 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    appendLittleEndian(data, bits);
+}
+
+static QByteArray encodeComponents(const QVector<double>& values, int componentType) {
+    QByteArray data;
+    for (double value : values) {
+        switch (componentType) {
+        case GLTFAccessorComponentType::BYTE:
+            appendLittleEndian(data, (qint8)value);
+            break;
+        case GLTFAccessorComponentType::UNSIGNED_BYTE:
+            appendLittleEndian(data, (quint8)value);
+            break;
+        case GLTFAccessorComponentType::SHORT:
+            appendLittleEndian(data, (qint16)value);
+            break;
+        case GLTFAccessorComponentType::UNSIGNED_SHORT:
+            appendLittleEndian(data, (quint16)value);
+            break;
+        case GLTFAccessorComponentType::UNSIGNED_INT:
+            appendLittleEndian(data, (quint32)value);
+            break;
+        default:
+            appendLittleEndian(data, (float)value);
+            break;
+        }
+    }
+    return data;
+}
+
+// a single triangle mesh in a single buffer, put together one buffer view and accessor at a time
+struct TestDocument {
+    QByteArray bin;
+    QJsonArray bufferViews;
+    QJsonArray accessors;
+    QJsonObject attributes;
+    int indices { -1 };
+
+    int addBufferView(const QByteArray& data, int byteStride = 0) {
+        // buffer views start on 4 byte boundaries
+        while (bin.size() % 4 != 0) {
+            bin.append('\0');
+        }
+        QJsonObject bufferView { { "buffer", 0 }, { "byteOffset", bin.size() }, { "byteLength", data.size() } };
+        if (byteStride > 0) {
+            bufferView["byteStride"] = byteStride;
+        }
+        bin.append(data);
+        bufferViews.append(bufferView);
+        return bufferViews.size() - 1;
+    }
+
+    int addAccessor(int bufferView, int byteOffset, int componentType, int count, const QString& type) {
+        accessors.append(QJsonObject {
+            { "bufferView", bufferView },
+            { "byteOffset", byteOffset },
+            { "componentType", componentType },
+            { "count", count },
+            { "type", type }
+        });
+        return accessors.size() - 1;
+    }
+
+    QJsonObject toJson() const {
+        QJsonObject primitive { { "attributes", attributes }, { "indices", indices }, { "mode", TRIANGLES_MODE } };
+        return QJsonObject {
+            { "asset", QJsonObject { { "version", "2.0" } } },
+            { "buffers", QJsonArray { QJsonObject { { "byteLength", bin.size() } } } },
+            { "bufferViews", bufferViews },
+            { "accessors", accessors },
+            { "meshes", QJsonArray { QJsonObject { { "primitives", QJsonArray { primitive } } } } },
+            { "nodes", QJsonArray { QJsonObject { { "mesh", 0 } } } },
+            { "scenes", QJsonArray { QJsonObject { { "nodes", QJsonArray { 0 } } } } },
+            { "scene", 0 }
+        };
+    }
+};
+
+static const QVector<double> POSITIONS { 0.0, 0.0, 0.0, 2.0, 0.0, 0.0, 2.0, 2.0, 0.0, 0.0, 2.0, 1.0 };
+static const QVector<double> NORMALS { 0.0, 0.0, 1.0, 0.0, 1.0, 0.0, 1.0, 0.0, 0.0, 0.5, 0.5, 0.5 };
+static const QVector<double> TEX_COORDS { 0.0, 0.0, 1.0, 0.0, 1.0, 1.0, 0.0, 1.0 };
+static const QVector<double> INDICES { 0, 1, 2, 0, 2, 3 };
+static const int NUM_VERTICES = 4;
+
+// positions, normals and texture coordinates interleaved in one buffer view, followed by the indices
+static TestDocument makeInterleavedDocument() {
+    TestDocument document;
+
+    QByteArray vertices;
+    for (int i = 0; i < NUM_VERTICES; i++) {
+        vertices.append(encodeComponents(POSITIONS.mid(3 * i, 3), GLTFAccessorComponentType::FLOAT));
+        vertices.append(encodeComponents(NORMALS.mid(3 * i, 3), GLTFAccessorComponentType::FLOAT));
+        vertices.append(encodeComponents(TEX_COORDS.mid(2 * i, 2), GLTFAccessorComponentType::FLOAT));
+    }
+    const int VERTEX_STRIDE = 8 * (int)sizeof(float);
+    int vertexView = document.addBufferView(vertices, VERTEX_STRIDE);
+    document.attributes["POSITION"] =
+        document.addAccessor(vertexView, 0, GLTFAccessorComponentType::FLOAT, NUM_VERTICES, "VEC3");
+    document.attributes["NORMAL"] =
+        document.addAccessor(vertexView, 3 * (int)sizeof(float), GLTFAccessorComponentType::FLOAT, NUM_VERTICES, "VEC3");
+    document.attributes["TEXCOORD_0"] =
+        document.addAccessor(vertexView, 6 * (int)sizeof(float), GLTFAccessorComponentType::FLOAT, NUM_VERTICES, "VEC2");
+
+    int indexView = document.addBufferView(encodeComponents(INDICES, GLTFAccessorComponentType::UNSIGNED_SHORT));
+    document.indices =
+        document.addAccessor(indexView, 0, GLTFAccessorComponentType::UNSIGNED_SHORT, INDICES.size(), "SCALAR");
+
+    return document;
+}
+
+// each attribute in a tightly packed buffer view of its own, the positions first
+static TestDocument makeSeparateDocument(int indexType, int positionType, int texCoordType) {
+    TestDocument document;
+
+    int positionView = document.addBufferView(encodeComponents(POSITIONS, positionType));
+    document.attributes["POSITION"] = document.addAccessor(positionView, 0, positionType, NUM_VERTICES, "VEC3");
+
+    int indexView = document.addBufferView(encodeComponents(INDICES, indexType));
+    document.indices = document.addAccessor(indexView, 0, indexType, INDICES.size(), "SCALAR");
+
+    int texCoordView = document.addBufferView(encodeComponents(TEX_COORDS, texCoordType));
+    document.attributes["TEXCOORD_0"] = document.addAccessor(texCoordView, 0, texCoordType, NUM_VERTICES, "VEC2");
+
+    return document;
+}
+
+static QByteArray toGLTF(QJsonObject json, const QByteArray& bin) {
+    QJsonArray buffers = json["buffers"].toArray();
+    QJsonObject buffer = buffers[0].toObject();
+    buffer["uri"] = "data:application/octet-stream;base64," + QString::fromLatin1(bin.toBase64());
+    buffers[0] = buffer;
+    json["buffers"] = buffers;
+    return QJsonDocument(json).toJson(QJsonDocument::Compact);
+}
+
+static void appendGLBChunk(QByteArray& glb, quint32 chunkType, QByteArray chunkData, char padding, int lengthError = 0) {
+    while (chunkData.size() % 4 != 0) {
+        chunkData.append(padding);
+    }
+    appendLittleEndian(glb, (quint32)(chunkData.size() + lengthError));
+    appendLittleEndian(glb, chunkType);
+    glb.append(chunkData);
+}
+
+// a GLB with the usual JSON and BIN chunks followed by a chunk of an unknown type, which readers skip.
+// binLengthError is added to the length recorded for the BIN chunk
+static QByteArray toGLB(const QJsonObject& json, const QByteArray& bin, int binLengthError = 0) {
+    static const quint32 GLB_MAGIC = 0x46546C67;
+    static const quint32 GLB_VERSION = 2;
+    static const quint32 GLB_CHUNK_TYPE_JSON = 0x4E4F534A;
+    static const quint32 GLB_CHUNK_TYPE_BIN = 0x004E4942;
+    static const quint32 UNKNOWN_CHUNK_TYPE = 0x54534554;
+
+    QByteArray chunks;
+    appendGLBChunk(chunks, GLB_CHUNK_TYPE_JSON, QJsonDocument(json).toJson(QJsonDocument::Compact), ' ');
+    appendGLBChunk(chunks, GLB_CHUNK_TYPE_BIN, bin, '\0', binLengthError);
+    appendGLBChunk(chunks, UNKNOWN_CHUNK_TYPE, QByteArray("JSON BIN"), '\0');
+
+    const int GLB_HEADER_LENGTH = 12;
+    QByteArray glb;
+    appendLittleEndian(glb, GLB_MAGIC);
+    appendLittleEndian(glb, GLB_VERSION);
+    appendLittleEndian(glb, (quint32)(GLB_HEADER_LENGTH + chunks.size()));
+    glb.append(chunks);
+    return glb;
+}
+
+static HFMModel::Pointer readModel(const QByteArray& data, const QString& url) {
+    GLTFSerializer serializer;
+    return serializer.read(data, hifi::VariantHash(), hifi::URL(url));
+}
+
+template<class V>
+static void compareVectors(const QVector<V>& actual, const QVector<double>& expected) {
+    const int componentCount = (int)(sizeof(V) / sizeof(float));
+    QCOMPARE(actual.size() * componentCount, expected.size());
+    for (int i = 0; i < actual.size(); i++) {
+        for (int c = 0; c < componentCount; c++) {
+            QCOMPARE(actual[i][c], (float)expected[i * componentCount + c]);
+        }
+    }
+}
+
+static void compareIndices(const QVector<int>& actual, const QVector<double>& expected) {
+    QCOMPARE(actual.size(), expected.size());
+    for (int i = 0; i < actual.size(); i++) {
+        QCOMPARE(actual[i], (int)expected[i]);
+    }
+}
+
+// checks the mesh read from document against the serial reader
+static void compareMesh(const HFMModel::Pointer& model, const QJsonObject& json, const QByteArray& bin) {
+    QVERIFY(model);
+    QCOMPARE(model->meshes.size(), 1);
+    const HFMMesh& mesh = model->meshes[0];
+    QCOMPARE(mesh.parts.size(), 1);
+
+    QJsonObject primitive = json["meshes"].toArray()[0].toObject()["primitives"].toArray()[0].toObject();
+    QJsonObject attributes = primitive["attributes"].toObject();
+
+    compareIndices(mesh.parts[0].triangleIndices, serial::readAccessor(json, bin, primitive["indices"].toInt()));
+    compareVectors(mesh.vertices, serial::readAccessor(json, bin, attributes["POSITION"].toInt()));
+    compareVectors(mesh.texCoords, serial::readAccessor(json, bin, attributes["TEXCOORD_0"].toInt()));
+    if (attributes.contains("NORMAL")) {
+        compareVectors(mesh.normals, serial::readAccessor(json, bin, attributes["NORMAL"].toInt()));
+    }
+}
+
+void GLTFTests::initTestCase() {
+    DependencyManager::set<ResourceManager>(false);
+}
+
+void GLTFTests::cleanupTestCase() {
+    DependencyManager::get<ResourceManager>()->cleanup();
+}
+
+void GLTFTests::testInterleavedAttributes() {
+    TestDocument document = makeInterleavedDocument();
+    QJsonObject json = document.toJson();
+
+    compareMesh(readModel(toGLTF(json, document.bin), "file:///interleaved.gltf"), json, document.bin);
+}
+
+void GLTFTests::testMixedComponentTypes_data() {
+    QTest::addColumn<int>("indexType");
+    QTest::addColumn<int>("positionType");
+    QTest::addColumn<int>("texCoordType");
+
+    QTest::newRow("ubyte indices, float positions, float uvs") << (int)GLTFAccessorComponentType::UNSIGNED_BYTE
+        << (int)GLTFAccessorComponentType::FLOAT << (int)GLTFAccessorComponentType::FLOAT;
+    QTest::newRow("ushort indices, short positions, ushort uvs") << (int)GLTFAccessorComponentType::UNSIGNED_SHORT
+        << (int)GLTFAccessorComponentType::SHORT << (int)GLTFAccessorComponentType::UNSIGNED_SHORT;
+    QTest::newRow("uint indices, byte positions, ubyte uvs") << (int)GLTFAccessorComponentType::UNSIGNED_INT
+        << (int)GLTFAccessorComponentType::BYTE << (int)GLTFAccessorComponentType::UNSIGNED_BYTE;
+    QTest::newRow("ushort indices, ubyte positions, float uvs") << (int)GLTFAccessorComponentType::UNSIGNED_SHORT
+        << (int)GLTFAccessorComponentType::UNSIGNED_BYTE << (int)GLTFAccessorComponentType::FLOAT;
+}
+
+void GLTFTests::testMixedComponentTypes() {
+    QFETCH(int, indexType);
+    QFETCH(int, positionType);
+    QFETCH(int, texCoordType);
+
+    TestDocument document = makeSeparateDocument(indexType, positionType, texCoordType);
+    QJsonObject json = document.toJson();
+
+    compareMesh(readModel(toGLTF(json, document.bin), "file:///mixed.gltf"), json, document.bin);
+}
+
+void GLTFTests::testGLBChunks() {
+    TestDocument document = makeInterleavedDocument();
+    QJsonObject json = document.toJson();
+
+    compareMesh(readModel(toGLB(json, document.bin), "file:///chunks.glb"), json, document.bin);
+
+    // a BIN chunk that claims to run past the end of the file leaves the buffer without data
+    const int PAST_END = 1024;
+    QVERIFY(!readModel(toGLB(json, document.bin, PAST_END), "file:///truncated.glb"));
+}
+
+void GLTFTests::testInvalidAccessors_data() {
+    QTest::addColumn<bool>("isBufferView");
+    QTest::addColumn<QString>("key");
+    QTest::addColumn<int>("value");
+
+    // the positions are the first of three buffer views, so these run past the positions but not past the buffer
+    QTest::newRow("negative count") << false << "count" << -1;
+    QTest::newRow("zero count") << false << "count" << 0;
+    QTest::newRow("huge count") << false << "count" << INT_MAX;
+    QTest::newRow("count past buffer view") << false << "count" << NUM_VERTICES + 1;
+    QTest::newRow("negative accessor offset") << false << "byteOffset" << -4;
+    QTest::newRow("accessor offset pushes elements past buffer view") << false << "byteOffset" << 4;
+    QTest::newRow("accessor offset past buffer view") << false << "byteOffset" << 52;
+    QTest::newRow("buffer view past buffer") << true << "byteLength" << INT_MAX;
+    QTest::newRow("negative buffer view offset") << true << "byteOffset" << -4;
+    QTest::newRow("negative buffer view length") << true << "byteLength" << -12;
+    QTest::newRow("stride shorter than element") << true << "byteStride" << 4;
+    QTest::newRow("negative stride") << true << "byteStride" << -12;
+}
+
+void GLTFTests::testInvalidAccessors() {
+    QFETCH(bool, isBufferView);
+    QFETCH(QString, key);
+    QFETCH(int, value);
+
+    TestDocument document = makeSeparateDocument(GLTFAccessorComponentType::UNSIGNED_SHORT,
+                                                 GLTFAccessorComponentType::FLOAT, GLTFAccessorComponentType::FLOAT);
+    int positionAccessor = document.attributes["POSITION"].toInt();
+    if (isBufferView) {
+        int positionView = document.accessors[positionAccessor].toObject()["bufferView"].toInt();
+        QJsonObject bufferView = document.bufferViews[positionView].toObject();
+        bufferView[key] = value;
+        document.bufferViews[positionView] = bufferView;
+    } else {
+        QJsonObject accessor = document.accessors[positionAccessor].toObject();
+        accessor[key] = value;
+        document.accessors[positionAccessor] = accessor;
+    }
+    QJsonObject json = document.toJson();
+
+    // only the bad accessor is dropped
+    HFMModel::Pointer model = readModel(toGLTF(json, document.bin), "file:///invalid.gltf");
+    QVERIFY(model);
+    QCOMPARE(model->meshes.size(), 1);
+    const HFMMesh& mesh = model->meshes[0];
+    QVERIFY(mesh.vertices.isEmpty());
+    QCOMPARE(mesh.parts.size(), 1);
+    compareIndices(mesh.parts[0].triangleIndices, serial::readAccessor(json, document.bin, document.indices));
+}
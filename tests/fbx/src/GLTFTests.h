@@ -0,0 +1,30 @@
+//
+//  GLTFTests.h
+//  tests/fbx/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_GLTFTests_h
+#define hifi_GLTFTests_h
+
+#include <QtTest/QtTest>
+
+class GLTFTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void testInterleavedAttributes();
+    void testMixedComponentTypes_data();
+    void testMixedComponentTypes();
+    void testGLBChunks();
+    void testInvalidAccessors_data();
+    void testInvalidAccessors();
+};
+
+#endif // hifi_GLTFTests_h
@@ -0,0 +1,89 @@
+//
+//  TextureBakeTests.cpp
+//  tests/gpu/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureBakeTests.h"
+
+#include <QtCore/QElapsedTimer>
+
+#include <image/TextureProcessing.h>
+
+QTEST_GUILESS_MAIN(TextureBakeTests)
+
+Q_DECLARE_METATYPE(image::TextureUsage::Type)
+Q_DECLARE_METATYPE(gpu::BackendTarget)
+
+#ifdef MANUAL_TEST
+
+static const int TEST_IMAGE_SIZE = 2048;
+
+static QImage createTestImage(bool withAlpha) {
+    // A noisy gradient, so that the block compressors have to do real work on every block
+    QImage image(TEST_IMAGE_SIZE, TEST_IMAGE_SIZE, QImage::Format_ARGB32);
+    quint32 seed = 1;
+    for (int y = 0; y < image.height(); y++) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < image.width(); x++) {
+            seed = seed * 1664525u + 1013904223u;
+            int noise = (int)(seed >> 28);
+            int alpha = withAlpha ? ((x / 64 + y / 64) % 2) * 255 : 255;
+            line[x] = qRgba((x / 8 + noise) & 0xFF, (y / 8 + noise) & 0xFF, ((x + y) / 16) & 0xFF, alpha);
+        }
+    }
+    return image;
+}
+
+void TextureBakeTests::initTestCase() {
+    _opaqueImage = createTestImage(false);
+    _transparentImage = createTestImage(true);
+}
+
+void TextureBakeTests::benchmarkTextureBake_data() {
+    QTest::addColumn<image::TextureUsage::Type>("type");
+    QTest::addColumn<gpu::BackendTarget>("target");
+    QTest::addColumn<bool>("compress");
+    QTest::addColumn<bool>("withAlpha");
+
+    QTest::newRow("BC1") << image::TextureUsage::ALBEDO_TEXTURE << gpu::BackendTarget::GL45 << true << false;
+    QTest::newRow("BC3") << image::TextureUsage::ALBEDO_TEXTURE << gpu::BackendTarget::GL45 << true << true;
+    QTest::newRow("BC4") << image::TextureUsage::ROUGHNESS_TEXTURE << gpu::BackendTarget::GL45 << true << false;
+    QTest::newRow("BC5") << image::TextureUsage::NORMAL_TEXTURE << gpu::BackendTarget::GL45 << true << false;
+    QTest::newRow("ETC2") << image::TextureUsage::ALBEDO_TEXTURE << gpu::BackendTarget::GLES32 << true << false;
+    QTest::newRow("RGBA8") << image::TextureUsage::ALBEDO_TEXTURE << gpu::BackendTarget::GL45 << false << true;
+}
+
+void TextureBakeTests::benchmarkTextureBake() {
+    QFETCH(image::TextureUsage::Type, type);
+    QFETCH(gpu::BackendTarget, target);
+    QFETCH(bool, compress);
+    QFETCH(bool, withAlpha);
+
+    const auto& sourceImage = withAlpha ? _transparentImage : _opaqueImage;
+    const auto loader = image::TextureUsage::getTextureLoaderForType(type);
+    const std::atomic<bool> abortProcessing { false };
+
+    // QBENCHMARK only reports the time per bake, the throughput is what compares across formats and image sizes
+    QElapsedTimer timer;
+    qint64 totalNSecs = 0;
+    int numBakes = 0;
+    QBENCHMARK {
+        timer.start();
+        auto texture = loader(image::Image(sourceImage), "benchmark.png", compress, target, abortProcessing, image::TextureUsage::TextureOutput());
+        totalNSecs += timer.nsecsElapsed();
+        ++numBakes;
+        QVERIFY(texture);
+        QVERIFY(texture->getNumMips() > 1);
+    }
+
+    const double NSECS_PER_SEC = 1.0e9;
+    double megapixels = (double)sourceImage.width() * sourceImage.height() / 1.0e6;
+    qInfo() << QTest::currentDataTag() << megapixels * numBakes * NSECS_PER_SEC / totalNSecs << "MP/s";
+}
+
+#endif // MANUAL_TEST
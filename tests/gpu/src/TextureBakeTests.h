@@ -0,0 +1,34 @@
+//
+//  TextureBakeTests.h
+//  tests/gpu/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureBakeTests_h
+#define hifi_TextureBakeTests_h
+
+#include <QtTest/QtTest>
+#include <QtGui/QImage>
+
+//#define MANUAL_TEST
+
+class TextureBakeTests : public QObject {
+    Q_OBJECT
+
+private slots:
+#ifdef MANUAL_TEST
+    void initTestCase();
+    void benchmarkTextureBake_data();
+    void benchmarkTextureBake();
+#endif // MANUAL_TEST
+
+private:
+    QImage _opaqueImage;
+    QImage _transparentImage;
+};
+
+#endif // hifi_TextureBakeTests_h
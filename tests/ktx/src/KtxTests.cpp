@@ -142,6 +142,93 @@ void KtxTests::testKtxSerialization() {
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
 }
 
+static gpu::TexturePointer createTestTexture() {
+    const uint16 TEXTURE_SIZE = 64;
+    auto texture = gpu::Texture::create2D(gpu::Element::COLOR_RGBA_32, TEXTURE_SIZE, TEXTURE_SIZE, gpu::Texture::MAX_NUM_MIPS);
+    texture->setStoredMipFormat(gpu::Element::COLOR_RGBA_32);
+    texture->setSourceHash("0123456789abcdef0123456789abcdef");
+    return texture;
+}
+
+static void assignTestMip(gpu::Texture& texture, uint16 level) {
+    std::vector<gpu::Byte> mipData(texture.evalStoredMipSize(level, texture.getStoredMipFormat()));
+    for (size_t i = 0; i < mipData.size(); ++i) {
+        mipData[i] = (gpu::Byte)(i + level);
+    }
+    texture.assignStoredMip(level, mipData.size(), mipData.data());
+}
+
+static void compareWithMemorySerialization(const QString& filePath) {
+    auto texture = createTestTexture();
+    for (uint16 level = 0; level < texture->getNumMips(); ++level) {
+        assignTestMip(*texture, level);
+    }
+    auto ktxMemory = gpu::Texture::serialize(*texture);
+    QVERIFY(ktxMemory.get());
+
+    auto fileStorage = std::make_shared<storage::FileStorage>(filePath);
+    QVERIFY(ktx::KTX::validate(fileStorage));
+    const auto& memStorage = ktxMemory->getStorage();
+    QCOMPARE(fileStorage->size(), memStorage->size());
+    QVERIFY(0 == memcmp(memStorage->data(), fileStorage->data(), memStorage->size()));
+}
+
+void KtxTests::testKtxFileSerialization() {
+    // Writing a texture straight to a file must produce exactly the same bytes as the in-memory serialization
+    auto texture = createTestTexture();
+    for (uint16 level = 0; level < texture->getNumMips(); ++level) {
+        assignTestMip(*texture, level);
+    }
+
+    QTemporaryDir outputDir;
+    QVERIFY(outputDir.isValid());
+    const auto filePath = outputDir.filePath("texture.ktx");
+    QVERIFY(gpu::Texture::serialize(filePath.toStdString(), *texture));
+    compareWithMemorySerialization(filePath);
+}
+
+void KtxTests::testKtxOutput() {
+    QTemporaryDir outputDir;
+    QVERIFY(outputDir.isValid());
+    const auto filePath = outputDir.filePath("texture.ktx");
+
+    // Each mip goes to the file as it is assigned, and the file only shows up under its name once complete
+    {
+        auto texture = createTestTexture();
+        QVERIFY(texture->setKtxOutput(filePath.toStdString()));
+        for (uint16 level = 0; level < texture->getNumMips(); ++level) {
+            assignTestMip(*texture, level);
+            QVERIFY(texture->isStoredMipFaceAvailable(level));
+            QVERIFY(!texture->accessStoredMipFace(level));
+        }
+        QVERIFY(!QFile::exists(filePath));
+        QVERIFY(texture->finishKtxOutput());
+    }
+    compareWithMemorySerialization(filePath);
+    QCOMPARE(QDir(outputDir.path()).entryList(QDir::Files).size(), 1);
+
+    // A file missing mips is never written, and doesn't replace the previous one
+    const auto previousSize = QFileInfo(filePath).size();
+    {
+        auto texture = createTestTexture();
+        QVERIFY(texture->setKtxOutput(filePath.toStdString()));
+        assignTestMip(*texture, 0);
+        QVERIFY(!texture->finishKtxOutput());
+    }
+    QCOMPARE(QFileInfo(filePath).size(), previousSize);
+    compareWithMemorySerialization(filePath);
+
+    // Nor is a file left behind when processing stops before the output is finished
+    const auto unfinishedFilePath = outputDir.filePath("unfinished.ktx");
+    {
+        auto texture = createTestTexture();
+        QVERIFY(texture->setKtxOutput(unfinishedFilePath.toStdString()));
+        assignTestMip(*texture, 0);
+    }
+    QVERIFY(!QFile::exists(unfinishedFilePath));
+    QCOMPARE(QDir(outputDir.path()).entryList(QDir::Files).size(), 1);
+}
+
 #if 0
 
 static const QString TEST_FOLDER { "H:/ktx_cacheold" };
@@ -0,0 +1,160 @@
+//
+//  ContactMapTests.cpp
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ContactMapTests.h"
+
+#include <map>
+#include <random>
+
+#include <ContactMap.h>
+
+QTEST_GUILESS_MAIN(ContactMapTests)
+
+// the map never dereferences the object pointers, so any distinct addresses will do
+static const int NUM_OBJECTS = 64;
+static char objects[NUM_OBJECTS];
+
+static void* getObject(int i) {
+    return &objects[i];
+}
+
+void ContactMapTests::testAddAndFind() {
+    ContactMap contactMap;
+    QCOMPARE(contactMap.size(), 0);
+
+    contactMap[ContactKey(getObject(0), getObject(1))].distance = 1.0f;
+    contactMap[ContactKey(getObject(1), getObject(2))].distance = 2.0f;
+    // objects without a motion state are null
+    contactMap[ContactKey(nullptr, getObject(2))].distance = 3.0f;
+    QCOMPARE(contactMap.size(), 3);
+
+    // the same pair finds the same contact
+    QCOMPARE(contactMap[ContactKey(getObject(1), getObject(2))].distance, 2.0f);
+    QCOMPARE(contactMap.size(), 3);
+
+    QVERIFY(contactMap.contains(ContactKey(nullptr, getObject(2))));
+    QVERIFY(!contactMap.contains(ContactKey(getObject(2), getObject(1))));
+
+    QCOMPARE(contactMap.getNumContacts(getObject(1)), 2);
+    QCOMPARE(contactMap.getNumContacts(getObject(2)), 2);
+    QCOMPARE(contactMap.getNumContacts(nullptr), 1);
+    QCOMPARE(contactMap.getNumContacts(getObject(3)), 0);
+
+    contactMap.clear();
+    QCOMPARE(contactMap.size(), 0);
+    QCOMPARE(contactMap.getNumContacts(getObject(1)), 0);
+    QVERIFY(!contactMap.contains(ContactKey(getObject(0), getObject(1))));
+}
+
+void ContactMapTests::testRemoveObject() {
+    ContactMap contactMap;
+    for (int i = 0; i < NUM_OBJECTS; ++i) {
+        for (int j = i + 1; j < NUM_OBJECTS; j += 3) {
+            contactMap[ContactKey(getObject(i), getObject(j))].distance = (float)(i * NUM_OBJECTS + j);
+        }
+        contactMap[ContactKey(nullptr, getObject(i))].distance = (float)i;
+    }
+
+    int numContacts = contactMap.size();
+    int numObjectContacts = contactMap.getNumContacts(getObject(7));
+    QVERIFY(numObjectContacts > 0);
+
+    contactMap.removeObject(getObject(7));
+    QCOMPARE(contactMap.size(), numContacts - numObjectContacts);
+    QCOMPARE(contactMap.getNumContacts(getObject(7)), 0);
+    for (int i = 0; i < contactMap.size(); ++i) {
+        const ContactKey& key = contactMap.getKey(i);
+        QVERIFY(key._a != getObject(7) && key._b != getObject(7));
+    }
+
+    // contacts which were moved around by the removal are still found
+    QCOMPARE(contactMap[ContactKey(getObject(0), getObject(1))].distance, 1.0f);
+    QCOMPARE(contactMap[ContactKey(nullptr, getObject(63))].distance, 63.0f);
+
+    contactMap.removeObject(nullptr);
+    QCOMPARE(contactMap.getNumContacts(nullptr), 0);
+    QCOMPARE(contactMap.size(), numContacts - numObjectContacts - (NUM_OBJECTS - 1));
+}
+
+void ContactMapTests::testRemoveWhileIterating() {
+    ContactMap contactMap;
+    for (int i = 0; i < NUM_OBJECTS - 1; ++i) {
+        contactMap[ContactKey(getObject(i), getObject(i + 1))].distance = (float)i;
+    }
+
+    // remove the even ones, the way PhysicsEngine ends contacts
+    int index = 0;
+    int numVisited = 0;
+    while (index < contactMap.size()) {
+        ++numVisited;
+        if ((int)contactMap.getContact(index).distance % 2 == 0) {
+            contactMap.removeAt(index);
+        } else {
+            ++index;
+        }
+    }
+    QCOMPARE(numVisited, NUM_OBJECTS - 1);
+    QCOMPARE(contactMap.size(), (NUM_OBJECTS - 1) / 2);
+    for (int i = 0; i < contactMap.size(); ++i) {
+        QVERIFY((int)contactMap.getContact(i).distance % 2 == 1);
+    }
+    QCOMPARE(contactMap.getNumContacts(getObject(2)), 1);
+}
+
+void ContactMapTests::testMatchesStdMap() {
+    // random adds and removals, checked against the std::map this replaced
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int> objectDistribution(0, NUM_OBJECTS - 1);
+    std::uniform_int_distribution<int> operationDistribution(0, 9);
+
+    ContactMap contactMap;
+    std::map<ContactKey, float> expected;
+
+    const int NUM_OPERATIONS = 20000;
+    for (int n = 0; n < NUM_OPERATIONS; ++n) {
+        int operation = operationDistribution(generator);
+        void* a = getObject(objectDistribution(generator));
+        void* b = getObject(objectDistribution(generator));
+        if (a == b) {
+            b = nullptr;
+        }
+        if (operation < 7) {
+            contactMap[ContactKey(a, b)].distance = (float)n;
+            expected[ContactKey(a, b)] = (float)n;
+        } else if (operation < 9) {
+            if (!contactMap.empty()) {
+                int index = n % contactMap.size();
+                expected.erase(contactMap.getKey(index));
+                contactMap.removeAt(index);
+            }
+        } else {
+            contactMap.removeObject(a);
+            for (auto itr = expected.begin(); itr != expected.end();) {
+                if (itr->first._a == a || itr->first._b == a) {
+                    itr = expected.erase(itr);
+                } else {
+                    ++itr;
+                }
+            }
+        }
+    }
+
+    QCOMPARE(contactMap.size(), (int)expected.size());
+    for (auto& pair : expected) {
+        QVERIFY(contactMap.contains(pair.first));
+        QCOMPARE(contactMap[pair.first].distance, pair.second);
+    }
+    int numObjectContacts = 0;
+    for (int i = 0; i < NUM_OBJECTS; ++i) {
+        numObjectContacts += contactMap.getNumContacts(getObject(i));
+    }
+    numObjectContacts += contactMap.getNumContacts(nullptr);
+    QCOMPARE(numObjectContacts, 2 * contactMap.size());
+}
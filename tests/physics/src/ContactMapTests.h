@@ -0,0 +1,26 @@
+//
+//  ContactMapTests.h
+//  tests/physics/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ContactMapTests_h
+#define hifi_ContactMapTests_h
+
+#include <QtTest/QtTest>
+
+class ContactMapTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAddAndFind();
+    void testRemoveObject();
+    void testRemoveWhileIterating();
+    void testMatchesStdMap();
+};
+
+#endif // hifi_ContactMapTests_h
@@ -13,6 +13,8 @@
 
 #include <iostream>
 
+#include <QtCore/QTemporaryDir>
+
 #include <ShapeManager.h>
 #include <StreamUtils.h>
 #include <Extents.h>
@@ -244,3 +246,116 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::buildSlowShapeOffThread() {
+    // two hulls with enough points between them that the compound is built on a worker
+    ShapeInfo::PointCollection pointCollection;
+    const int NUM_HULLS = 2;
+    const int NUM_POINTS_PER_HULL = 1000;
+    Extents extents;
+    for (int i = 0; i < NUM_HULLS; ++i) {
+        ShapeInfo::PointList pointList;
+        glm::vec3 offset((float)i, 0.0f, 0.0f);
+        for (int j = 0; j < NUM_POINTS_PER_HULL; ++j) {
+            float angle = (float)j * 0.1f;
+            float height = (float)j / (float)NUM_POINTS_PER_HULL - 0.5f;
+            glm::vec3 point = glm::vec3(cosf(angle), height, sinf(angle)) + offset;
+            pointList.push_back(point);
+            extents.addPoint(point);
+        }
+        pointCollection.push_back(pointList);
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, 0.5f * (extents.maximum - extents.minimum));
+    info.setPointCollection(pointCollection);
+
+    ShapeManager shapeManager;
+    QVERIFY(shapeManager.getShape(info, true) == nullptr);
+    QCOMPARE(shapeManager.getWorkRequestCount(), (uint32_t)1);
+
+    // asking again while the shape is being built doesn't start another worker
+    QVERIFY(shapeManager.getShape(info, true) == nullptr);
+    QCOMPARE(shapeManager.getWorkRequestCount(), (uint32_t)1);
+
+    QTRY_COMPARE(shapeManager.getWorkDeliveryCount(), (uint32_t)1);
+    QCOMPARE(shapeManager.getNumShapes(), 1);
+    QCOMPARE(shapeManager.getNumReferences(info), 0);
+
+    const btCollisionShape* shape = shapeManager.getShapeByKey(info.getHash());
+    QVERIFY(shape != nullptr);
+    QCOMPARE(shape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    QCOMPARE(static_cast<const btCompoundShape*>(shape)->getNumChildShapes(), NUM_HULLS);
+    QCOMPARE(shapeManager.getNumReferences(info), 1);
+    QVERIFY(shapeManager.releaseShape(shape));
+
+    // callers that can't wait, like contact tests, get the same shape built on the spot
+    ShapeManager syncShapeManager;
+    const btCollisionShape* syncShape = syncShapeManager.getShape(info);
+    QVERIFY(syncShape != nullptr);
+    QCOMPARE(syncShape->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+    QCOMPARE(static_cast<const btCompoundShape*>(syncShape)->getNumChildShapes(), NUM_HULLS);
+    QCOMPARE(syncShapeManager.getWorkRequestCount(), (uint32_t)0);
+    QCOMPARE(syncShapeManager.getNumReferences(info), 1);
+    QVERIFY(syncShapeManager.releaseShape(syncShape));
+}
+
+void ShapeManagerTests::cacheStaticMeshBvh() {
+    // a flat grid of triangles
+    const int GRID_SIZE = 16;
+    ShapeInfo::PointList points;
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        for (int j = 0; j < GRID_SIZE; ++j) {
+            points.push_back(glm::vec3((float)i, 0.1f * (float)((i * j) % 3), (float)j));
+        }
+    }
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(0.5f * (float)GRID_SIZE), "http://localhost/grid.fbx");
+    info.getPointCollection().push_back(points);
+    ShapeInfo::TriangleIndices& triangleIndices = info.getTriangleIndices();
+    for (int i = 0; i < GRID_SIZE - 1; ++i) {
+        for (int j = 0; j < GRID_SIZE - 1; ++j) {
+            int32_t corner = i * GRID_SIZE + j;
+            triangleIndices << corner << corner + 1 << corner + GRID_SIZE;
+            triangleIndices << corner + 1 << corner + GRID_SIZE + 1 << corner + GRID_SIZE;
+        }
+    }
+
+    QTemporaryDir cacheDirectory;
+    QVERIFY(cacheDirectory.isValid());
+
+    auto buildShape = [&](ShapeManager& shapeManager) -> const btBvhTriangleMeshShape* {
+        shapeManager.setBvhCacheDirectory(cacheDirectory.path());
+        if (shapeManager.getShape(info, true) != nullptr) {
+            return nullptr;
+        }
+        if (!QTest::qWaitFor([&] { return shapeManager.getWorkDeliveryCount() == 1; })) {
+            return nullptr;
+        }
+        const btCollisionShape* shape = shapeManager.getShapeByKey(info.getHash());
+        if (!shape || shape->getShapeType() != (int)TRIANGLE_MESH_SHAPE_PROXYTYPE) {
+            return nullptr;
+        }
+        return static_cast<const btBvhTriangleMeshShape*>(shape);
+    };
+
+    // the first build writes the BVH to the cache...
+    ShapeManager firstManager;
+    const btBvhTriangleMeshShape* builtShape = buildShape(firstManager);
+    QVERIFY(builtShape != nullptr);
+    QCOMPARE(QDir(cacheDirectory.path()).entryList({ "*.bvh" }, QDir::Files).size(), 1);
+
+    // ...and the second reads it back rather than building it again
+    uint32_t cacheHitCount = ShapeFactory::getBvhCacheHitCount();
+    ShapeManager secondManager;
+    const btBvhTriangleMeshShape* cachedShape = buildShape(secondManager);
+    QVERIFY(cachedShape != nullptr);
+    QCOMPARE(ShapeFactory::getBvhCacheHitCount(), cacheHitCount + 1);
+
+    btOptimizedBvh* builtBvh = const_cast<btBvhTriangleMeshShape*>(builtShape)->getOptimizedBvh();
+    btOptimizedBvh* cachedBvh = const_cast<btBvhTriangleMeshShape*>(cachedShape)->getOptimizedBvh();
+    QVERIFY(builtBvh != nullptr);
+    QVERIFY(cachedBvh != nullptr);
+    QVERIFY(cachedBvh != builtBvh);
+    QCOMPARE(cachedBvh->getQuantizedNodeArray().size(), builtBvh->getQuantizedNodeArray().size());
+    QCOMPARE(cachedBvh->calculateSerializeBufferSize(), builtBvh->calculateSerializeBufferSize());
+}
@@ -0,0 +1,130 @@
+//
+//  BakeWorkerPoolTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeWorkerPoolTests.h"
+
+#include <QtTest/QtTest>
+
+#include <BakeWorkerPool.h>
+
+QTEST_MAIN(BakeWorkerPoolTests)
+
+// the workers are shell commands, standing in for oven processes
+static const QString SHELL = "/bin/sh";
+static const QString SUCCEED = "exit 0";
+static const QString CRASH = "kill -SEGV $$";
+static const QString WORK = "sleep 0.5";
+static const QString HANG = "sleep 30";
+
+static const int TIMEOUT_MS = 10000;
+
+// records the pool's job signals in the order they were emitted
+class JobLog : public QObject {
+public:
+    JobLog(BakeWorkerPool& pool) {
+        connect(&pool, &BakeWorkerPool::jobStarted, this, [this](quint32 jobID) {
+            events << QString("start %1").arg(jobID);
+        });
+        connect(&pool, &BakeWorkerPool::jobFinished, this, [this](quint32 jobID, int, QProcess::ExitStatus exitStatus) {
+            events << QString(exitStatus == QProcess::CrashExit ? "crash %1" : "finish %1").arg(jobID);
+        });
+        connect(&pool, &BakeWorkerPool::jobAborted, this, [this](quint32 jobID) {
+            events << QString("abort %1").arg(jobID);
+        });
+    }
+
+    int numEnded() const {
+        return events.filter(QRegExp("^(finish|crash|abort) ")).size();
+    }
+
+    QStringList events;
+};
+
+void BakeWorkerPoolTests::initTestCase() {
+#ifndef Q_OS_UNIX
+    QSKIP("Bake worker pool tests use a POSIX shell for their workers");
+#endif
+}
+
+void BakeWorkerPoolTests::testLargestFirst() {
+    BakeWorkerPool pool;
+    pool.setMaxWorkers(1);
+    JobLog log(pool);
+
+    auto small = pool.submit(SHELL, { "-c", SUCCEED }, 1);
+    auto large = pool.submit(SHELL, { "-c", SUCCEED }, 100);
+    auto medium = pool.submit(SHELL, { "-c", SUCCEED }, 10);
+
+    QTRY_COMPARE_WITH_TIMEOUT(log.numEnded(), 3, TIMEOUT_MS);
+    QCOMPARE(log.events, QStringList({
+        QString("start %1").arg(large), QString("finish %1").arg(large),
+        QString("start %1").arg(medium), QString("finish %1").arg(medium),
+        QString("start %1").arg(small), QString("finish %1").arg(small)
+    }));
+}
+
+void BakeWorkerPoolTests::testMemoryBudget() {
+    BakeWorkerPool pool;
+    pool.setMaxWorkers(4);
+    pool.setMemoryBudget(100);
+    JobLog log(pool);
+
+    // the first two don't fit together, the third fits next to either of them
+    auto first = pool.submit(SHELL, { "-c", WORK }, 60);
+    auto second = pool.submit(SHELL, { "-c", WORK }, 50);
+    auto third = pool.submit(SHELL, { "-c", WORK }, 40);
+
+    QTRY_COMPARE_WITH_TIMEOUT(log.numEnded(), 3, TIMEOUT_MS);
+    QCOMPARE(log.events.mid(0, 2), QStringList({ QString("start %1").arg(first), QString("start %1").arg(third) }));
+    // the second only starts once one of the others has made room for it
+    auto firstFinish = log.events.indexOf(QRegExp("^finish "));
+    QVERIFY(firstFinish >= 0);
+    QVERIFY(log.events.indexOf(QString("start %1").arg(second)) > firstFinish);
+}
+
+void BakeWorkerPoolTests::testCrashRetryDoublesEstimate() {
+    BakeWorkerPool pool;
+    pool.setMaxWorkers(2);
+    pool.setMemoryBudget(100);
+    pool.setMaxAttempts(2);
+    JobLog log(pool);
+
+    // both fit at first, but the retry of the crashed job needs 80 and has to wait for the other one
+    auto crashing = pool.submit(SHELL, { "-c", CRASH }, 40);
+    auto working = pool.submit(SHELL, { "-c", WORK }, 40);
+
+    QTRY_COMPARE_WITH_TIMEOUT(log.numEnded(), 2, TIMEOUT_MS);
+    auto crashingStart = QString("start %1").arg(crashing);
+    QCOMPARE(log.events.count(crashingStart), 2);
+    QVERIFY(log.events.lastIndexOf(crashingStart) > log.events.indexOf(QString("finish %1").arg(working)));
+
+    // the final attempt's crash is reported
+    QCOMPARE(log.events.last(), QString("crash %1").arg(crashing));
+}
+
+void BakeWorkerPoolTests::testAbort() {
+    BakeWorkerPool pool;
+    pool.setMaxWorkers(1);
+    JobLog log(pool);
+
+    auto running = pool.submit(SHELL, { "-c", HANG }, 2);
+    auto queued = pool.submit(SHELL, { "-c", HANG }, 1);
+    QTRY_VERIFY_WITH_TIMEOUT(pool.isRunning(running), TIMEOUT_MS);
+
+    // a queued job is dropped right away, a running one once its worker has been terminated
+    pool.abort(queued);
+    QCOMPARE(log.events.last(), QString("abort %1").arg(queued));
+    QCOMPARE(pool.getNumQueuedJobs(), 0);
+
+    pool.abort(running);
+    QTRY_COMPARE_WITH_TIMEOUT(log.events.last(), QString("abort %1").arg(running), TIMEOUT_MS);
+    QVERIFY(!pool.isRunning(running));
+    QCOMPARE(log.events.filter("finish").size(), 0);
+}
@@ -0,0 +1,26 @@
+//
+//  BakeWorkerPoolTests.h
+//  tests/shared/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakeWorkerPoolTests_h
+#define hifi_BakeWorkerPoolTests_h
+
+#include <QtCore/QObject>
+
+class BakeWorkerPoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void testLargestFirst();
+    void testMemoryBudget();
+    void testCrashRetryDoublesEstimate();
+    void testAbort();
+};
+
+#endif // hifi_BakeWorkerPoolTests_h
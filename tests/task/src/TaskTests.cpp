@@ -0,0 +1,263 @@
+//
+//  TaskTests.cpp
+//  tests/task/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TaskTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Profile.h>
+#include <task/Task.h>
+
+QTEST_MAIN(TaskTests)
+
+Q_LOGGING_CATEGORY(trace_test_task, "trace.test.task")
+
+namespace tasktest {
+
+class TestContext : public task::JobContext {
+};
+using TestContextPointer = std::shared_ptr<TestContext>;
+
+Task_DeclareCategoryTimeProfilerClass(TestTimeProfiler, trace_test_task);
+Task_DeclareTypeAliases(TestContext, TestTimeProfiler)
+
+// the names of the jobs that ran, in the order they started
+class RunLog {
+public:
+    void add(const std::string& name) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _names.push_back(name);
+    }
+
+    int indexOf(const std::string& name) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = std::find(_names.begin(), _names.end(), name);
+        return it != _names.end() ? (int)(it - _names.begin()) : -1;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _names.clear();
+    }
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<std::string> _names;
+};
+using RunLogPointer = std::shared_ptr<RunLog>;
+
+class ProduceJob {
+public:
+    using JobModel = Job::ModelO<ProduceJob, int>;
+
+    ProduceJob(const RunLogPointer& log, const std::string& name, int value, bool abort = false) :
+        _log(log), _name(name), _value(value), _abort(abort) {}
+
+    void run(const TestContextPointer& context, int& output) {
+        _log->add(_name);
+        output = _value;
+        if (_abort) {
+            context->taskFlow.abortTask();
+        }
+    }
+
+private:
+    RunLogPointer _log;
+    std::string _name;
+    int _value;
+    bool _abort;
+};
+
+class AddOneJob {
+public:
+    using JobModel = Job::ModelIO<AddOneJob, int, int>;
+
+    AddOneJob(const RunLogPointer& log, const std::string& name) : _log(log), _name(name) {}
+
+    void run(const TestContextPointer& context, const int& input, int& output) {
+        _log->add(_name);
+        output = input + 1;
+    }
+
+private:
+    RunLogPointer _log;
+    std::string _name;
+};
+
+class SumJob {
+public:
+    using Input = VaryingSet2<int, int>;
+    using JobModel = Job::ModelIO<SumJob, Input, int>;
+
+    SumJob(const RunLogPointer& log, const std::string& name) : _log(log), _name(name) {}
+
+    void run(const TestContextPointer& context, const Input& input, int& output) {
+        _log->add(_name);
+        output = input.get0() + input.get1();
+    }
+
+private:
+    RunLogPointer _log;
+    std::string _name;
+};
+
+// A and B are independent, C takes A and D takes both C and B, so D = (1 + 1) + 10
+class ChainTask {
+public:
+    using JobModel = Task::ModelO<ChainTask, int>;
+
+    void build(JobModel& model, const Varying& input, Varying& output, const RunLogPointer& log, bool parallel) {
+        model.setParallel(parallel);
+        const auto a = model.addJob<ProduceJob>("A", log, std::string("A"), 1);
+        const auto b = model.addJob<ProduceJob>("B", log, std::string("B"), 10);
+        const auto c = model.addJob<AddOneJob>("C", a, log, std::string("C"));
+        const auto sumInput = SumJob::Input(c, b).asVarying();
+        output = model.addJob<SumJob>("D", sumInput, log, std::string("D"));
+    }
+};
+
+// A aborts the task, so C which takes A's output must not run, while B is independent of A
+class AbortTask {
+public:
+    using JobModel = Task::ModelO<AbortTask, int>;
+
+    void build(JobModel& model, const Varying& input, Varying& output, const RunLogPointer& log, bool parallel) {
+        model.setParallel(parallel);
+        const auto a = model.addJob<ProduceJob>("A", log, std::string("A"), 1, true);
+        model.addJob<ProduceJob>("B", log, std::string("B"), 10);
+        output = model.addJob<AddOneJob>("C", a, log, std::string("C"));
+    }
+};
+
+// an abort only ends the task whose job issued it, so the job after the aborted task still runs
+class OuterTask {
+public:
+    using JobModel = Task::ModelO<OuterTask, int>;
+
+    void build(JobModel& model, const Varying& input, Varying& output, const RunLogPointer& log, bool parallel) {
+        model.addJob<AbortTask>("Inner", log, parallel);
+        output = model.addJob<ProduceJob>("After", log, std::string("After"), 100);
+    }
+};
+
+}
+
+using namespace tasktest;
+
+void TaskTests::testJobGraphOrder() {
+    Varying output0(0);
+    Varying output1(0);
+    Varying output2(0);
+    Varying output3(0);
+    std::vector<Varying> inputs {
+        Varying(task::JobNoIO()),
+        output0,
+        VaryingSet2<int, int>(output0, output1).asVarying(),
+        Varying(task::JobNoIO())
+    };
+    std::vector<Varying> outputs { output0, output1, output2, output3 };
+
+    task::JobGraph graph;
+    graph.build(inputs, outputs);
+    QVERIFY(graph.isBuilt());
+
+    const int NUM_RUNS = 20;
+    for (int run = 0; run < NUM_RUNS; run++) {
+        std::atomic<int> nextStep { 0 };
+        std::vector<int> steps(inputs.size(), -1);
+        QVERIFY(graph.run([&](size_t index) {
+            steps[index] = nextStep++;
+            return true;
+        }));
+
+        for (int step : steps) {
+            QVERIFY(step >= 0);
+        }
+        QVERIFY(steps[1] > steps[0]);
+        QVERIFY(steps[2] > steps[0]);
+        QVERIFY(steps[2] > steps[1]);
+    }
+}
+
+void TaskTests::testJobGraphAbort() {
+    Varying output0(0);
+    Varying output1(0);
+    Varying output2(0);
+    std::vector<Varying> inputs { Varying(task::JobNoIO()), output0, output1 };
+    std::vector<Varying> outputs { output0, output1, output2 };
+
+    task::JobGraph graph;
+    graph.build(inputs, outputs);
+
+    std::vector<std::atomic<bool>> ran(inputs.size());
+    for (auto& jobRan : ran) {
+        jobRan = false;
+    }
+    bool finished = graph.run([&](size_t index) {
+        ran[index] = true;
+        return index != 0;
+    });
+
+    QVERIFY(!finished);
+    QVERIFY(ran[0]);
+    QVERIFY(!ran[1]);
+    QVERIFY(!ran[2]);
+}
+
+void TaskTests::testParallelTaskOrder() {
+    const int NUM_RUNS = 20;
+    for (bool parallel : { false, true }) {
+        auto log = std::make_shared<RunLog>();
+        auto context = std::make_shared<TestContext>();
+        Engine engine(ChainTask::JobModel::create("Chain", log, parallel), context);
+
+        for (int run = 0; run < NUM_RUNS; run++) {
+            log->clear();
+            engine.run();
+
+            QCOMPARE(engine.getOutput().get<int>(), 12);
+            QVERIFY(log->indexOf("A") >= 0);
+            QVERIFY(log->indexOf("B") >= 0);
+            QVERIFY(log->indexOf("C") > log->indexOf("A"));
+            QVERIFY(log->indexOf("D") > log->indexOf("C"));
+            QVERIFY(log->indexOf("D") > log->indexOf("B"));
+            QVERIFY(!context->taskFlow.doAbortTask());
+        }
+    }
+}
+
+void TaskTests::testParallelTaskAbort() {
+    for (bool parallel : { false, true }) {
+        auto log = std::make_shared<RunLog>();
+        auto context = std::make_shared<TestContext>();
+        Engine engine(AbortTask::JobModel::create("Abort", log, parallel), context);
+        engine.run();
+
+        QVERIFY(log->indexOf("A") >= 0);
+        QCOMPARE(log->indexOf("C"), -1);
+        QCOMPARE(engine.getOutput().get<int>(), 0);
+
+        // the task handles the abort, just as it does when its jobs run one after the other
+        QVERIFY(!context->taskFlow.doAbortTask());
+
+        log->clear();
+        Engine outerEngine(OuterTask::JobModel::create("Outer", log, parallel), context);
+        outerEngine.run();
+
+        QCOMPARE(log->indexOf("C"), -1);
+        QVERIFY(log->indexOf("After") > log->indexOf("A"));
+        QCOMPARE(outerEngine.getOutput().get<int>(), 100);
+        QVERIFY(!context->taskFlow.doAbortTask());
+    }
+}
@@ -0,0 +1,26 @@
+//
+//  TaskTests.h
+//  tests/task/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TaskTests_h
+#define hifi_TaskTests_h
+
+#include <QtTest/QtTest>
+
+class TaskTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testJobGraphOrder();
+    void testJobGraphAbort();
+    void testParallelTaskOrder();
+    void testParallelTaskAbort();
+};
+
+#endif // hifi_TaskTests_h
@@ -13,37 +13,78 @@
 
 #include <iostream>
 
+#include <glm/gtx/norm.hpp>
+
 #include <workload/Space.h>
 #include <StreamUtils.h>
 #include <SharedUtil.h>
 
 
-const float INV_SQRT_3 = 1.0f / sqrtf(3.0f);
-
 QTEST_MAIN(SpaceTests)
 
+float randomFloat() {
+    return 2.0f * ((float)rand() / (float)RAND_MAX) - 1.0f;
+}
+
+glm::vec3 randomVec3() {
+    glm::vec3 v(randomFloat(), randomFloat(), randomFloat());
+    return v;
+}
+
+workload::View makeView(const glm::vec3& center, float near, float mid, float far) {
+    workload::View view;
+    view.origin = center;
+    view.regions[workload::Region::R1] = workload::Sphere(center, near);
+    view.regions[workload::Region::R2] = workload::Sphere(center, mid);
+    view.regions[workload::Region::R3] = workload::Sphere(center, far);
+    return view;
+}
+
+void processTransaction(workload::Space& space, workload::Transaction& transaction) {
+    space.enqueueTransaction(transaction);
+    space.enqueueFrame();
+    space.processTransactionQueue();
+    transaction.clear();
+}
+
+// what categorizeAndGetChanges() must agree with: every proxy tested against every view
+uint8_t evalRegionBruteForce(const workload::Sphere& sphere, const workload::Views& views) {
+    uint8_t region = workload::Region::UNKNOWN;
+    for (const auto& view : views) {
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = sphere.w + view.regions[k].w;
+            if (distance2(glm::vec3(sphere), glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
+        }
+    }
+    return region;
+}
+
 void SpaceTests::testOverlaps() {
     workload::Space space;
     using Changes = std::vector<workload::Space::Change>;
-    using Views = std::vector<workload::Space::View>;
 
     glm::vec3 viewCenter(0.0f, 0.0f, 0.0f);
     float near = 1.0f;
     float mid = 2.0f;
     float far = 3.0f;
 
-    Views views;
-    views.push_back(workload::Space::View(viewCenter, near, mid, far));
+    workload::Views views;
+    views.push_back(makeView(viewCenter, near, mid, far));
     space.setViews(views);
 
-    int32_t proxyId = 0;
+    workload::Transaction transaction;
+    int32_t proxyId = space.allocateID();
     const float DELTA = 0.001f;
     float proxyRadius = 0.5f;
     glm::vec3 proxyPosition = viewCenter + glm::vec3(0.0f, 0.0f, far + proxyRadius + DELTA);
-    workload::Space::Sphere proxySphere(proxyPosition, proxyRadius);
+    workload::Sphere proxySphere(proxyPosition, proxyRadius);
 
     { // create very_far proxy
-        proxyId = space.createProxy(proxySphere);
+        transaction.reset(proxyId, proxySphere, workload::Owner());
+        processTransaction(space, transaction);
         QVERIFY(space.getNumObjects() == 1);
 
         Changes changes;
@@ -54,53 +95,61 @@ void SpaceTests::testOverlaps() {
     { // move proxy far
         float newRadius = 1.0f;
         glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, far + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+        transaction.update(proxyId, workload::Sphere(newPosition, newRadius));
+        processTransaction(space, transaction);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_FAR);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_UNKNOWN);
+        QVERIFY(changes[0].region == workload::Region::R3);
+        QVERIFY(changes[0].prevRegion == workload::Region::UNKNOWN);
     }
 
     { // move proxy mid
         float newRadius = 1.0f;
         glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, mid + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+        transaction.update(proxyId, workload::Sphere(newPosition, newRadius));
+        processTransaction(space, transaction);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_MIDDLE);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_FAR);
+        QVERIFY(changes[0].region == workload::Region::R2);
+        QVERIFY(changes[0].prevRegion == workload::Region::R3);
     }
 
     { // move proxy near
         float newRadius = 1.0f;
         glm::vec3 newPosition = viewCenter + glm::vec3(0.0f, 0.0f, near + newRadius - DELTA);
-        workload::Space::Sphere newSphere(newPosition, newRadius);
-        std::vector<workload::Space::ProxyUpdate> updates;
-        updates.push_back(workload::Space::ProxyUpdate(proxyId, newSphere));
-        space.updateProxies(updates);
+        transaction.update(proxyId, workload::Sphere(newPosition, newRadius));
+        processTransaction(space, transaction);
+        Changes changes;
+        space.categorizeAndGetChanges(changes);
+        QVERIFY(changes.size() == 1);
+        QVERIFY(changes[0].proxyId == proxyId);
+        QVERIFY(changes[0].region == workload::Region::R1);
+        QVERIFY(changes[0].prevRegion == workload::Region::R2);
+    }
+
+    { // move the view away, leaving the proxy untouched
+        views[0] = makeView(viewCenter + glm::vec3(0.0f, 0.0f, -100.0f), near, mid, far);
+        space.setViews(views);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 1);
         QVERIFY(changes[0].proxyId == proxyId);
-        QVERIFY(changes[0].region == workload::Space::REGION_NEAR);
-        QVERIFY(changes[0].prevRegion == workload::Space::REGION_MIDDLE);
+        QVERIFY(changes[0].region == workload::Region::UNKNOWN);
+        QVERIFY(changes[0].prevRegion == workload::Region::R1);
+
+        changes.clear();
+        space.categorizeAndGetChanges(changes);
+        QVERIFY(changes.size() == 0);
     }
 
     { // delete proxy
         // NOTE: atm deleting a proxy doesn't result in a "Change"
-        std::vector<int32_t> deadProxies;
-        deadProxies.push_back(proxyId);
-        space.deleteProxies(deadProxies);
+        transaction.remove(proxyId);
+        processTransaction(space, transaction);
         Changes changes;
         space.categorizeAndGetChanges(changes);
         QVERIFY(changes.size() == 0);
@@ -108,51 +157,100 @@ void SpaceTests::testOverlaps() {
     }
 }
 
-#ifdef MANUAL_TEST
+void SpaceTests::testIncrementalCategorize() {
+    // the grid only revisits proxies that moved or sit near a region boundary,
+    // so check it against a full scan while views and proxies wander about
+    srand(1234);
+    const uint32_t NUM_PROXIES = 5000;
+    const float WORLD_HALF_WIDTH = 200.0f;
+    const float MAX_PROXY_RADIUS = 8.0f;
 
-const float WORLD_WIDTH = 1000.0f;
-const float MIN_RADIUS = 1.0f;
-const float MAX_RADIUS = 100.0f;
+    workload::Space space;
+    workload::Transaction transaction;
+    std::vector<workload::Sphere> spheres;
+    std::vector<int32_t> proxyIDs;
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        // a few huge proxies, or ones far outside the grid, exercise the catch-all cell
+        float radius = MAX_PROXY_RADIUS * 0.5f * (randomFloat() + 1.0f);
+        if (i % 500 == 0) {
+            radius = 0.0f;
+        } else if (i % 700 == 3) {
+            radius = 100.0f;
+        }
+        float scale = (i % 1000 == 1) ? 1.0e12f : WORLD_HALF_WIDTH;
+        spheres.push_back(workload::Sphere(scale * randomVec3(), radius));
+        proxyIDs.push_back(space.allocateID());
+        transaction.reset(proxyIDs.back(), spheres.back(), workload::Owner());
+    }
+    processTransaction(space, transaction);
+
+    std::vector<uint8_t> expectedRegions(NUM_PROXIES, workload::Region::UNKNOWN);
+    workload::Views views;
+    views.push_back(makeView(glm::vec3(0.0f), 20.0f, 40.0f, 80.0f));
+    views.push_back(makeView(glm::vec3(50.0f, 0.0f, 0.0f), 10.0f, 30.0f, 60.0f));
+
+    const uint32_t NUM_STEPS = 40;
+    for (uint32_t step = 0; step < NUM_STEPS; ++step) {
+        // views drift every step, proxies most of the time
+        for (auto& view : views) {
+            view = makeView(view.origin + 5.0f * randomVec3(), view.regions[0].w, view.regions[1].w, view.regions[2].w);
+        }
+        space.setViews(views);
+        if (step % 3 != 2) {
+            // sometimes enough proxies move to warrant a full pass, sometimes only a few
+            uint32_t stride = (step % 3 == 0) ? 7 : 53;
+            for (uint32_t i = step % stride; i < NUM_PROXIES; i += stride) {
+                spheres[i] = workload::Sphere(glm::vec3(spheres[i]) + 2.0f * randomVec3(), spheres[i].w);
+                transaction.update(proxyIDs[i], spheres[i]);
+            }
+            processTransaction(space, transaction);
+        }
 
-float randomFloat() {
-    return 2.0f * ((float)rand() / (float)RAND_MAX) - 1.0f;
-}
+        if (step == NUM_STEPS / 2) {
+            // removing and resetting proxies shouldn't leave anything stale in the grid
+            for (uint32_t i = 0; i < NUM_PROXIES; i += 11) {
+                transaction.remove(proxyIDs[i]);
+            }
+            processTransaction(space, transaction);
+            for (uint32_t i = 0; i < NUM_PROXIES; i += 11) {
+                transaction.reset(proxyIDs[i], spheres[i], workload::Owner());
+                expectedRegions[i] = workload::Region::UNKNOWN;
+            }
+            processTransaction(space, transaction);
+        }
 
-glm::vec3 randomVec3() {
-    glm::vec3 v(randomFloat(), randomFloat(), randomFloat());
-    return v;
-}
+        std::vector<workload::Space::Change> changes;
+        space.categorizeAndGetChanges(changes);
 
-void generateSpheres(uint32_t numProxies, std::vector<workload::Space::Sphere>& spheres) {
-    spheres.reserve(numProxies);
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        workload::Space::Sphere sphere(
-                WORLD_WIDTH * randomFloat(),
-                WORLD_WIDTH * randomFloat(),
-                WORLD_WIDTH * randomFloat(),
-                (MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS)) * randomFloat());
-        spheres.push_back(sphere);
+        uint32_t numExpectedChanges = 0;
+        for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+            uint8_t region = evalRegionBruteForce(spheres[i], views);
+            QCOMPARE(space.getRegion(proxyIDs[i]), region);
+            if (region != expectedRegions[i]) {
+                QVERIFY(numExpectedChanges < changes.size());
+                const auto& change = changes[numExpectedChanges];
+                QCOMPARE(change.proxyId, proxyIDs[i]);
+                QCOMPARE(change.region, region);
+                QCOMPARE(change.prevRegion, expectedRegions[i]);
+                ++numExpectedChanges;
+            }
+            expectedRegions[i] = region;
+        }
+        QCOMPARE((uint32_t)changes.size(), numExpectedChanges);
     }
 }
 
-void generatePositions(uint32_t numProxies, std::vector<glm::vec3>& positions) {
-    positions.reserve(numProxies);
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        positions.push_back(WORLD_WIDTH * randomVec3());
-    }
-}
+#ifdef MANUAL_TEST
 
-void generateRadiuses(uint32_t numRadiuses, std::vector<float>& radiuses) {
-    radiuses.reserve(numRadiuses);
-    for (uint32_t i = 0; i < numRadiuses; ++i) {
-        radiuses.push_back(MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * randomFloat());
-    }
-}
+const float WORLD_WIDTH = 1000.0f;
+const float MIN_RADIUS = 0.5f;
+const float MAX_RADIUS = 10.0f;
 
 void SpaceTests::benchmark() {
-    uint32_t numProxies[] = { 100, 1000, 10000, 100000 };
-    uint32_t numTests = 4;
+    uint32_t numProxies[] = { 10000, 100000, 1000000 };
+    uint32_t numTests = 3;
     std::vector<uint64_t> timeToAddAll;
+    std::vector<uint64_t> timeToCategorizeAll;
     std::vector<uint64_t> timeToMoveView;
     std::vector<uint64_t> timeToMoveProxies;
     std::vector<uint64_t> timeToRemoveAll;
@@ -160,80 +258,68 @@ void SpaceTests::benchmark() {
 
         workload::Space space;
 
-        { // build the views
-            std::vector<glm::vec3> viewPositions;
-            viewPositions.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-            viewPositions.push_back(glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH));
-            float radius0 = 0.25f * WORLD_WIDTH;
-            float radius1 = 0.50f * WORLD_WIDTH;
-            float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
+        // a couple of views with region radii like those ViewTask settles on
+        glm::vec3 viewPosition(0.0f);
+        auto setViews = [&] {
+            workload::Views views;
+            views.push_back(makeView(viewPosition, 20.0f, 80.0f, 300.0f));
+            views.push_back(makeView(viewPosition + glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH), 20.0f, 80.0f, 300.0f));
             space.setViews(views);
-        }
+        };
+        setViews();
 
         // build the proxies
         uint32_t n = numProxies[i];
-        std::vector<workload::Space::Sphere> proxySpheres;
-        generateSpheres(n, proxySpheres);
+        std::vector<workload::Sphere> proxySpheres;
+        proxySpheres.reserve(n);
+        for (uint32_t j = 0; j < n; ++j) {
+            float radius = MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * 0.5f * (randomFloat() + 1.0f);
+            proxySpheres.push_back(workload::Sphere(WORLD_WIDTH * randomVec3(), radius));
+        }
         std::vector<int32_t> proxyKeys;
         proxyKeys.reserve(n);
 
         // measure time to put proxies in the space
+        workload::Transaction transaction;
         uint64_t startTime = usecTimestampNow();
         for (uint32_t j = 0; j < n; ++j) {
-            int32_t key = space.createProxy(proxySpheres[j]);
+            int32_t key = space.allocateID();
+            transaction.reset(key, proxySpheres[j], workload::Owner());
             proxyKeys.push_back(key);
         }
+        processTransaction(space, transaction);
         uint64_t usec = usecTimestampNow() - startTime;
         timeToAddAll.push_back(usec);
 
-        {
-            // build the views
-            std::vector<glm::vec3> viewPositions;
-            viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f));
-            viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f + 0.1f * WORLD_WIDTH));
-            float radius0 = 0.25f * WORLD_WIDTH;
-            float radius1 = 0.50f * WORLD_WIDTH;
-            float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
-            space.setViews(views);
-        }
-
-        // measure time to categorizeAndGetChanges everything
+        // measure time to categorize everything the first time
         std::vector<workload::Space::Change> changes;
         startTime = usecTimestampNow();
         space.categorizeAndGetChanges(changes);
         usec = usecTimestampNow() - startTime;
-        timeToMoveView.push_back(usec);
+        timeToCategorizeAll.push_back(usec);
+
+        // measure time to categorizeAndGetChanges after the views take a step, averaged over several frames
+        const uint32_t NUM_FRAMES = 10;
+        const float viewSpeed = 1.0f;
+        usec = 0;
+        for (uint32_t frame = 0; frame < NUM_FRAMES; ++frame) {
+            viewPosition += viewSpeed * glm::vec3(1.0f, 0.0f, 0.0f);
+            setViews();
+            changes.clear();
+            startTime = usecTimestampNow();
+            space.categorizeAndGetChanges(changes);
+            usec += usecTimestampNow() - startTime;
+        }
+        timeToMoveView.push_back(usec / NUM_FRAMES);
 
-        // move every 10th proxy around
+        // move every 100th proxy around
         const float proxySpeed = 1.0f;
-        std::vector<workload::Space::Sphere> newSpheres;
-        uint32_t numMovingProxies = n / 10;
-        uint32_t jstep = n / numMovingProxies;
-        uint32_t maxJ = numMovingProxies * jstep - 1;
-        glm::vec3 direction;
-        for (uint32_t j = 0; j < maxJ - jstep; j += jstep) {
-            glm::vec3 position = (glm::vec3)proxySpheres[j];
-            glm::vec3 destination = (glm::vec3)proxySpheres[j + jstep];
-            direction = glm::normalize(destination - position);
-            glm::vec3 newPosition = position + proxySpeed * direction;
-            newSpheres.push_back(workload::Space::Sphere(newPosition, proxySpheres[j].w));
-        }
-        glm::vec3 position = (glm::vec3)proxySpheres[maxJ = jstep];
-        glm::vec3 destination = (glm::vec3)proxySpheres[0];
-        direction = glm::normalize(destination - position);
-        direction = position + proxySpeed * direction;
-        newSpheres.push_back(workload::Space::Sphere(direction, proxySpheres[0].w));
-        uint32_t k = 0;
         startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < maxJ; j += jstep) {
-            space.updateProxy(proxyKeys[j], newSpheres[k++]);
+        for (uint32_t j = 0; j < n; j += 100) {
+            glm::vec3 newPosition = glm::vec3(proxySpheres[j]) + proxySpeed * glm::normalize(randomVec3());
+            transaction.update(proxyKeys[j], workload::Sphere(newPosition, proxySpheres[j].w));
         }
+        processTransaction(space, transaction);
         changes.clear();
         space.categorizeAndGetChanges(changes);
         usec = usecTimestampNow() - startTime;
@@ -242,8 +328,9 @@ void SpaceTests::benchmark() {
         // measure time to remove proxies from space
         startTime = usecTimestampNow();
         for (uint32_t j = 0; j < n; ++j) {
-            space.deleteProxy(proxyKeys[j]);
+            transaction.remove(proxyKeys[j]);
         }
+        processTransaction(space, transaction);
         usec = usecTimestampNow() - startTime;
         timeToRemoveAll.push_back(usec);
     }
@@ -255,6 +342,13 @@ void SpaceTests::benchmark() {
     }
     std::cout << "];" << std::endl;
 
+    std::cout << "[numProxies, timeToCategorizeAll] = [" << std::endl;
+    for (uint32_t i = 0; i < timeToCategorizeAll.size(); ++i) {
+        uint32_t n = numProxies[i];
+        std::cout << "    " << n << ", " << timeToCategorizeAll[i] << std::endl;
+    }
+    std::cout << "];" << std::endl;
+
     std::cout << "[numProxies, timeToMoveView] = [" << std::endl;
     for (uint32_t i = 0; i < timeToMoveView.size(); ++i) {
         uint32_t n = numProxies[i];
@@ -265,7 +359,7 @@ void SpaceTests::benchmark() {
     std::cout << "[numProxies, timeToMoveProxies] = [" << std::endl;
     for (uint32_t i = 0; i < timeToMoveProxies.size(); ++i) {
         uint32_t n = numProxies[i];
-        std::cout << "    " << n << "/10, " << timeToMoveProxies[i] << std::endl;
+        std::cout << "    " << n << "/100, " << timeToMoveProxies[i] << std::endl;
     }
     std::cout << "];" << std::endl;
 
@@ -11,12 +11,15 @@
 
 #include "ATPClientApp.h"
 
+#include <memory>
+
 #include <QDataStream>
 #include <QTextStream>
 #include <QThread>
 #include <QFile>
 #include <QLoggingCategory>
 #include <QCommandLineParser>
+#include <QElapsedTimer>
 
 #include <NetworkLogging.h>
 #include <NetworkingConstants.h>
@@ -26,6 +29,7 @@
 #include <SettingHandle.h>
 #include <AssetUpload.h>
 #include <StatTracker.h>
+#include <NumericalConstants.h>
 
 #define HIGH_FIDELITY_ATP_CLIENT_USER_AGENT "Mozilla/5.0 (HighFidelityATPClient)"
 #define TIMEOUT_MILLISECONDS 8000
@@ -57,6 +61,17 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
     const QCommandLineOption listenPortOption("listenPort", "listen port", QString::number(INVALID_PORT));
     parser.addOption(listenPortOption);
 
+    const QCommandLineOption benchmarkOption("benchmark", "report download throughput for each chunk size and parallelism");
+    parser.addOption(benchmarkOption);
+
+    const QCommandLineOption chunkSizesOption("chunk-sizes", "comma separated chunk sizes in KB to benchmark",
+                                              "256,1024,4096");
+    parser.addOption(chunkSizesOption);
+
+    const QCommandLineOption parallelRangesOption("parallel-ranges", "comma separated ranges in flight to benchmark",
+                                                  "1,2,4,8");
+    parser.addOption(parallelRangesOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << endl;
         parser.showHelp();
@@ -125,6 +140,19 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
         _listenPort = parser.value(listenPortOption).toInt();
     }
 
+    _benchmark = parser.isSet(benchmarkOption);
+    if (_benchmark) {
+        const int64_t BYTES_PER_KB = 1024;
+        auto chunkSizes = parser.isSet(chunkSizesOption) ? parser.value(chunkSizesOption) : "256,1024,4096";
+        for (const auto& chunkSize : chunkSizes.split(",", QString::SkipEmptyParts)) {
+            _benchmarkChunkSizes.push_back(chunkSize.toLongLong() * BYTES_PER_KB);
+        }
+        auto parallelRanges = parser.isSet(parallelRangesOption) ? parser.value(parallelRangesOption) : "1,2,4,8";
+        for (const auto& maxParallelRanges : parallelRanges.split(",", QString::SkipEmptyParts)) {
+            _benchmarkParallelRanges.push_back(maxParallelRanges.toInt());
+        }
+    }
+
     _domainServerAddress = QString("127.0.0.1") + ":" + QString::number(domainPort);
     if (parser.isSet(domainAddressOption)) {
         _domainServerAddress = parser.value(domainAddressOption);
@@ -205,7 +233,7 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
 
     DependencyManager::get<AddressManager>()->handleLookupString(_domainServerAddress, false);
 
-    QTimer* _timeoutTimer = new QTimer(this);
+    _timeoutTimer = new QTimer(this);
     _timeoutTimer->setSingleShot(true);
     connect(_timeoutTimer, &QTimer::timeout, this, &ATPClientApp::timedOut);
     _timeoutTimer->start(TIMEOUT_MILLISECONDS);
@@ -351,7 +379,11 @@ void ATPClientApp::lookupAsset() {
             qDebug() << "not found: " << request->getErrorString();
         } else if (result == GetMappingRequest::NoError) {
             qDebug() << "found, hash is " << request->getHash();
-            download(request->getHash());
+            if (_benchmark) {
+                benchmark(request->getHash());
+            } else {
+                download(request->getHash());
+            }
         } else {
             qDebug() << "error -- " << request->getError() << " -- " << request->getErrorString();
         }
@@ -390,6 +422,61 @@ void ATPClientApp::download(AssetUtils::AssetHash hash) {
     assetRequest->start();
 }
 
+void ATPClientApp::benchmark(AssetUtils::AssetHash hash) {
+    // a benchmark can outlast the connection timeout, which only guards against never reaching the asset-server
+    _timeoutTimer->stop();
+
+    _pendingBenchmarkRuns.clear();
+    for (auto chunkSize : _benchmarkChunkSizes) {
+        for (auto maxParallelRanges : _benchmarkParallelRanges) {
+            _pendingBenchmarkRuns.push_back({ chunkSize, maxParallelRanges });
+        }
+    }
+
+    QTextStream cout(stdout);
+    cout << "chunk size (KB)\tparallel ranges\tsize (bytes)\ttime (ms)\tthroughput (MB/s)" << endl;
+
+    runNextBenchmark(hash);
+}
+
+void ATPClientApp::runNextBenchmark(AssetUtils::AssetHash hash) {
+    if (_pendingBenchmarkRuns.isEmpty()) {
+        finish(0);
+        return;
+    }
+
+    auto run = _pendingBenchmarkRuns.takeFirst();
+    auto assetClient = DependencyManager::get<AssetClient>();
+    assetClient->setDownloadChunking(run.first, run.second);
+
+    // make sure every run downloads the whole asset from the asset-server
+    AssetUtils::removeFromCache(AssetUtils::getATPUrl(hash));
+
+    auto assetRequest = assetClient->createRequest(hash);
+    auto timer = std::make_shared<QElapsedTimer>();
+
+    connect(assetRequest, &AssetRequest::finished, this, [this, run, hash, timer](AssetRequest* request) mutable {
+        auto elapsedMsecs = std::max(timer->elapsed(), (qint64)1);
+
+        QTextStream cout(stdout);
+        if (request->getError() == AssetRequest::Error::NoError) {
+            const double BYTES_PER_MEGABYTE = 1024.0 * 1024.0;
+            auto size = request->getData().size();
+            auto megabytesPerSecond = (size / BYTES_PER_MEGABYTE) / (elapsedMsecs / (double)MSECS_PER_SECOND);
+            cout << run.first / 1024 << "\t" << run.second << "\t" << size << "\t" << elapsedMsecs << "\t"
+                 << megabytesPerSecond << endl;
+        } else {
+            cout << run.first / 1024 << "\t" << run.second << "\tfailed: " << request->getErrorString() << endl;
+        }
+
+        request->deleteLater();
+        runNextBenchmark(hash);
+    });
+
+    timer->start();
+    assetRequest->start();
+}
+
 void ATPClientApp::finish(int exitCode) {
     auto nodeList = DependencyManager::get<NodeList>();
 
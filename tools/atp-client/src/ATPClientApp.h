@@ -46,9 +46,16 @@ private:
     void lookupAsset();
     void listAssets();
     void download(AssetUtils::AssetHash hash);
+    void benchmark(AssetUtils::AssetHash hash);
+    void runNextBenchmark(AssetUtils::AssetHash hash);
     void finish(int exitCode);
     bool _verbose;
 
+    bool _benchmark { false };
+    QList<int64_t> _benchmarkChunkSizes;
+    QList<int> _benchmarkParallelRanges;
+    QList<QPair<int64_t, int>> _pendingBenchmarkRuns;
+
     QUrl _url;
     QString _localOutputFile;
     QString _localUploadFile;
@@ -0,0 +1,120 @@
+//
+//  BakeCache.cpp
+//  tools/oven/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+static const QString MANIFEST_FILE_NAME = "manifest.json";
+static const QString MANIFEST_BASE_FILENAME_KEY = "baseFilename";
+static const QString MANIFEST_FILES_KEY = "files";
+static const QString PARTIAL_ENTRY_SUFFIX = ".partial";
+
+BakeCache::BakeCache(const QString& cacheDirectory) :
+    _cacheDirectory(cacheDirectory)
+{
+    if (!_cacheDirectory.exists() && !_cacheDirectory.mkpath(".")) {
+        qWarning() << "Could not create bake cache folder" << cacheDirectory;
+    }
+}
+
+QString BakeCache::computeKey(const QByteArray& sourceContent, const QString& bakerType, int bakerVersion,
+                              const QByteArray& options) {
+    QCryptographicHash hasher(QCryptographicHash::Sha256);
+    hasher.addData(bakerType.toUtf8());
+    hasher.addData((const char*)&bakerVersion, sizeof(bakerVersion));
+    hasher.addData(options);
+    hasher.addData(sourceContent);
+    return QString::fromLatin1(hasher.result().toHex());
+}
+
+bool BakeCache::restore(const QString& key, const QDir& outputDirectory, const QString& baseFilename,
+                        QStringList& restoredFiles, QString& cachedBaseFilename) const {
+    QDir entryDirectory { _cacheDirectory.absoluteFilePath(key) };
+
+    QFile manifestFile { entryDirectory.absoluteFilePath(MANIFEST_FILE_NAME) };
+    if (!manifestFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    auto manifest = QJsonDocument::fromJson(manifestFile.readAll()).object();
+    cachedBaseFilename = manifest[MANIFEST_BASE_FILENAME_KEY].toString();
+    auto files = manifest[MANIFEST_FILES_KEY].toArray();
+    if (cachedBaseFilename.isEmpty() || files.isEmpty()) {
+        return false;
+    }
+
+    restoredFiles.clear();
+    for (const auto& file : files) {
+        auto cachedFileName = file.toString();
+        auto restoredFilePath = outputDirectory.absoluteFilePath(baseFilename + cachedFileName.mid(cachedBaseFilename.length()));
+
+        QFile::remove(restoredFilePath);
+        if (!QFile::copy(entryDirectory.absoluteFilePath(cachedFileName), restoredFilePath)) {
+            qWarning() << "Could not restore" << cachedFileName << "from bake cache entry" << key;
+            for (const auto& restoredFile : restoredFiles) {
+                QFile::remove(restoredFile);
+            }
+            restoredFiles.clear();
+            return false;
+        }
+        restoredFiles << restoredFilePath;
+    }
+
+    return true;
+}
+
+bool BakeCache::store(const QString& key, const QString& baseFilename, const std::vector<QString>& outputFiles) {
+    // write the entry to a partial folder first so that an interrupted store never looks like a complete entry
+    auto partialEntryName = key + PARTIAL_ENTRY_SUFFIX;
+    QDir partialEntryDirectory { _cacheDirectory.absoluteFilePath(partialEntryName) };
+    partialEntryDirectory.removeRecursively();
+    if (!_cacheDirectory.mkpath(partialEntryName)) {
+        qWarning() << "Could not create bake cache entry" << key;
+        return false;
+    }
+
+    QJsonArray files;
+    for (const auto& outputFile : outputFiles) {
+        auto fileName = QFileInfo(outputFile).fileName();
+        if (!fileName.startsWith(baseFilename) || !QFile::copy(outputFile, partialEntryDirectory.absoluteFilePath(fileName))) {
+            qWarning() << "Could not add" << outputFile << "to bake cache entry" << key;
+            partialEntryDirectory.removeRecursively();
+            return false;
+        }
+        files.append(fileName);
+    }
+
+    QJsonObject manifest;
+    manifest[MANIFEST_BASE_FILENAME_KEY] = baseFilename;
+    manifest[MANIFEST_FILES_KEY] = files;
+
+    QFile manifestFile { partialEntryDirectory.absoluteFilePath(MANIFEST_FILE_NAME) };
+    if (!manifestFile.open(QIODevice::WriteOnly) || manifestFile.write(QJsonDocument(manifest).toJson()) == -1) {
+        qWarning() << "Could not write manifest for bake cache entry" << key;
+        partialEntryDirectory.removeRecursively();
+        return false;
+    }
+    manifestFile.close();
+
+    QDir { _cacheDirectory.absoluteFilePath(key) }.removeRecursively();
+    if (!_cacheDirectory.rename(partialEntryName, key)) {
+        qWarning() << "Could not commit bake cache entry" << key;
+        partialEntryDirectory.removeRecursively();
+        return false;
+    }
+
+    return true;
+}
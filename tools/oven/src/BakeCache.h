@@ -0,0 +1,42 @@
+//
+//  BakeCache.h
+//  tools/oven/src
+//
+//  Copyright 2019 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakeCache_h
+#define hifi_BakeCache_h
+
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+// Persistent store of baked outputs, keyed by a hash of the source content, the baker that produced them and its options.
+// Each entry is a folder holding the output files plus a manifest recording the base filename they were baked with,
+// so that a later bake can restore them under a different base filename.
+class BakeCache {
+public:
+    BakeCache(const QString& cacheDirectory);
+
+    static QString computeKey(const QByteArray& sourceContent, const QString& bakerType, int bakerVersion,
+                              const QByteArray& options);
+
+    // copies the outputs cached for key into outputDirectory, swapping the cached base filename for baseFilename
+    // returns false if there is no complete entry for key
+    bool restore(const QString& key, const QDir& outputDirectory, const QString& baseFilename,
+                 QStringList& restoredFiles, QString& cachedBaseFilename) const;
+
+    // every output file must live in the same folder and start with baseFilename
+    bool store(const QString& key, const QString& baseFilename, const std::vector<QString>& outputFiles);
+
+private:
+    QDir _cacheDirectory;
+};
+
+#endif // hifi_BakeCache_h
@@ -14,6 +14,7 @@
 #include <QObject>
 #include <QImageReader>
 #include <QtCore/QDebug>
+#include <QtCore/QDirIterator>
 #include <QFile>
 
 #include <unordered_map>
@@ -127,3 +128,117 @@ void BakerCLI::handleFinishedBaker() {
     }
     QCoreApplication::exit(exitCode);
 }
+
+void BakerCLI::bakeDirectory(const QString& inputPath, const QString& outputPath, const QString& type,
+                             int maxWorkers, quint64 memoryBudgetMB) {
+    static const QString MODEL_TYPE { "model" };
+    static const QString MATERIAL_TYPE { "material" };
+    static const QStringList MODEL_SUFFIXES { "fst", "fbx", "obj" };
+    static const QString MATERIAL_SUFFIX { "json" };
+
+    _outputPath = outputPath;
+
+    _workerPool.reset(new BakeWorkerPool());
+    if (maxWorkers > 0) {
+        _workerPool->setMaxWorkers(maxWorkers);
+    }
+    if (memoryBudgetMB > 0) {
+        _workerPool->setMemoryBudget(memoryBudgetMB * 1024 * 1024);
+    }
+    connect(_workerPool.get(), &BakeWorkerPool::jobFinished, this, &BakerCLI::handleFinishedBakeJob);
+    connect(_workerPool.get(), &BakeWorkerPool::jobAborted, this, &BakerCLI::handleAbortedBakeJob);
+
+    // without a type only the models are baked, their textures are baked along with them
+    auto jobType = type.isEmpty() ? MODEL_TYPE : type;
+
+    QDir inputDir { inputPath };
+    QDirIterator it { inputPath, QDir::Files, QDirIterator::Subdirectories };
+    while (it.hasNext()) {
+        auto filePath = it.next();
+        auto suffix = QFileInfo(filePath).suffix().toLower();
+
+        bool isBakeable;
+        if (jobType == MODEL_TYPE) {
+            isBakeable = MODEL_SUFFIXES.contains(suffix) && !isModelBaked(QUrl::fromLocalFile(filePath));
+        } else if (jobType == MATERIAL_TYPE) {
+            isBakeable = suffix == MATERIAL_SUFFIX;
+        } else {
+            // any other type is a texture usage type
+            isBakeable = QImageReader::supportedImageFormats().contains(suffix.toLatin1());
+        }
+        if (!isBakeable) {
+            continue;
+        }
+
+        ++_numBakeJobs;
+
+        // each file gets its own output folder, so files with the same base name can't collide
+        auto relativePath = inputDir.relativeFilePath(filePath);
+        if (!_outputPath.mkpath(relativePath)) {
+            _failedBakes << relativePath + ": Could not create output folder";
+            continue;
+        }
+
+        QStringList args {
+            "-i", filePath,
+            "-o", _outputPath.absoluteFilePath(relativePath),
+            "-t", jobType
+        };
+        if (!TextureBaker::isCompressionEnabled()) {
+            args << "--disable-texture-compression";
+        }
+
+        auto jobID = _workerPool->submit(QCoreApplication::applicationFilePath(), args,
+                                         BakeWorkerPool::estimateMemoryCost(filePath));
+        _pendingBakeJobs.insert(jobID, relativePath);
+    }
+
+    qCDebug(model_baking) << "Baking" << _numBakeJobs << "files from" << inputPath << "with up to"
+        << _workerPool->getMaxWorkers() << "workers and a memory budget of"
+        << _workerPool->getMemoryBudget() / (1024 * 1024) << "MB";
+
+    checkIfDirectoryBakeComplete();
+}
+
+void BakerCLI::handleFinishedBakeJob(quint32 jobID, int exitCode, QProcess::ExitStatus exitStatus) {
+    auto relativePath = _pendingBakeJobs.take(jobID);
+
+    if (exitStatus == QProcess::CrashExit) {
+        _failedBakes << relativePath + ": Fatal error occurred while baking";
+    } else if (exitCode != OVEN_STATUS_CODE_SUCCESS) {
+        QString errors = "Unknown error occurred while baking";
+        QFile errorFile { QDir(_outputPath.absoluteFilePath(relativePath)).absoluteFilePath(OVEN_ERROR_FILENAME) };
+        if (errorFile.open(QIODevice::ReadOnly)) {
+            errors = errorFile.readAll();
+        }
+        _failedBakes << relativePath + ": " + errors;
+    } else {
+        qCDebug(model_baking) << "Baked" << relativePath;
+    }
+
+    checkIfDirectoryBakeComplete();
+}
+
+void BakerCLI::handleAbortedBakeJob(quint32 jobID) {
+    _failedBakes << _pendingBakeJobs.take(jobID) + ": Aborted";
+    checkIfDirectoryBakeComplete();
+}
+
+void BakerCLI::checkIfDirectoryBakeComplete() {
+    if (!_pendingBakeJobs.isEmpty()) {
+        return;
+    }
+
+    qCDebug(model_baking) << "Finished baking" << _numBakeJobs - _failedBakes.size() << "of" << _numBakeJobs << "files";
+
+    int exitCode = OVEN_STATUS_CODE_SUCCESS;
+    if (!_failedBakes.isEmpty()) {
+        exitCode = OVEN_STATUS_CODE_FAIL;
+        QFile errorFile { _outputPath.absoluteFilePath(OVEN_ERROR_FILENAME) };
+        if (errorFile.open(QFile::WriteOnly)) {
+            errorFile.write(_failedBakes.join('\n').toUtf8());
+            errorFile.close();
+        }
+    }
+    QCoreApplication::exit(exitCode);
+}
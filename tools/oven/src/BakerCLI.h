@@ -13,11 +13,14 @@
 #define hifi_BakerCLI_h
 
 #include <QtCore/QObject>
+#include <QtCore/QProcess>
 #include <QDir>
 #include <QUrl>
 
 #include <memory>
 
+#include <BakeWorkerPool.h>
+
 #include "Baker.h"
 #include "OvenCLIApplication.h"
 
@@ -36,12 +39,25 @@ public:
 public slots:
     void bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type = QString::null);
 
+    // bakes every file in the directory in its own oven process, each into a folder named after the file
+    void bakeDirectory(const QString& inputPath, const QString& outputPath, const QString& type,
+                       int maxWorkers, quint64 memoryBudgetMB);
+
 private slots:
     void handleFinishedBaker();  
+    void handleFinishedBakeJob(quint32 jobID, int exitCode, QProcess::ExitStatus exitStatus);
+    void handleAbortedBakeJob(quint32 jobID);
 
 private:
+    void checkIfDirectoryBakeComplete();
+
     QDir _outputPath;
     std::unique_ptr<Baker> _baker;
+
+    std::unique_ptr<BakeWorkerPool> _workerPool;
+    QHash<quint32, QString> _pendingBakeJobs;
+    QStringList _failedBakes;
+    int _numBakeJobs { 0 };
 };
 
 #endif // hifi_BakerCLI_h
@@ -16,17 +16,28 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkReply>
+
+#include <NetworkAccessManager.h>
+#include <SharedUtil.h>
+#include <TextureMeta.h>
 
 #include "Gzip.h"
 #include "Oven.h"
 #include "baking/BakerLibrary.h"
 
+// the bake cache lives beside the timestamped output folders so that it is shared by every bake to the same location
+static const QString BAKE_CACHE_FOLDER_NAME = "bake-cache";
+static const QString TEXTURE_BAKER_CACHE_TYPE = "texture";
+
 DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainName,
                          const QString& baseOutputPath, const QUrl& destinationPath,
                          bool shouldRebakeOriginals) :
     _localEntitiesFileURL(localModelFileURL),
     _domainName(domainName),
     _baseOutputPath(baseOutputPath),
+    _bakeCache(QDir(baseOutputPath).absoluteFilePath(BAKE_CACHE_FOLDER_NAME)),
     _shouldRebakeOriginals(shouldRebakeOriginals)
 {
     // make sure the destination path has a trailing slash
@@ -195,25 +206,12 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
         QUrl textureURL = QUrl(url).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment);
         TextureKey key = { textureURL, type };
 
-        // setup a texture baker for this URL, as long as we aren't baking a texture already
-        if (!_textureBakers.contains(key)) {
-            auto baseTextureFileName = _textureFileNamer.createBaseTextureFileName(textureURL.fileName(), type);
-
-            // setup a baker for this texture
-            QSharedPointer<TextureBaker> textureBaker {
-                new TextureBaker(textureURL, type, _contentOutputPath, baseTextureFileName),
-                &TextureBaker::deleteLater
-            };
-
-            // make sure our handler is called when the texture baker is done
-            connect(textureBaker.data(), &TextureBaker::finished, this, &DomainBaker::handleFinishedTextureBaker);
-
-            // insert it into our bakers hash so we hold a strong pointer to it
-            _textureBakers.insert(key, textureBaker);
+        // setup a texture bake for this URL, as long as we aren't baking a texture already
+        if (!_requestedTextures.contains(key)) {
+            _requestedTextures.insert(key);
 
-            // move the baker to a worker thread and kickoff the bake
-            textureBaker->moveToThread(Oven::instance().getNextWorkerThread());
-            QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
+            auto baseTextureFileName = _textureFileNamer.createBaseTextureFileName(textureURL.fileName(), type);
+            loadTextureForBake(key, baseTextureFileName);
 
             // keep track of the total number of baking entities
             ++_totalNumberOfSubBakes;
@@ -228,6 +226,132 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
     }
 }
 
+void DomainBaker::loadTextureForBake(const TextureKey& key, const QString& baseFilename) {
+    const QUrl& textureURL = key.first;
+
+    // the source content is needed up front to look the texture up in the bake cache,
+    // and is then handed to the TextureBaker so that it does not have to load it again
+    if (textureURL.isLocalFile()) {
+        // defer the bake so that every entity referencing this texture has been queued for a re-write
+        // before a cache hit re-writes them
+        QTimer::singleShot(0, this, [this, key, baseFilename] {
+            QFile localTexture { key.first.toLocalFile() };
+            if (localTexture.open(QIODevice::ReadOnly)) {
+                bakeTexture(key, baseFilename, localTexture.readAll());
+            } else {
+                // let the baker report the failure to open the texture
+                bakeTexture(key, baseFilename, QByteArray());
+            }
+        });
+    } else {
+        auto& networkAccessManager = NetworkAccessManager::getInstance();
+
+        QNetworkRequest networkRequest;
+
+        // setup the request to follow re-directs and always hit the network
+        networkRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+        networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+        networkRequest.setHeader(QNetworkRequest::UserAgentHeader, HIGH_FIDELITY_USER_AGENT);
+
+        networkRequest.setUrl(textureURL);
+
+        auto networkReply = networkAccessManager.get(networkRequest);
+        connect(networkReply, &QNetworkReply::finished, this, [this, networkReply, key, baseFilename] {
+            networkReply->deleteLater();
+            if (networkReply->error() == QNetworkReply::NoError) {
+                bakeTexture(key, baseFilename, networkReply->readAll());
+            } else {
+                // let the baker retry the download and report the error
+                bakeTexture(key, baseFilename, QByteArray());
+            }
+        });
+    }
+}
+
+void DomainBaker::bakeTexture(const TextureKey& key, const QString& baseFilename, const QByteArray& textureContent) {
+    const QUrl& textureURL = key.first;
+    auto type = key.second;
+
+    if (!textureContent.isEmpty()) {
+        auto options = QString("%1:%2").arg(type).arg(TextureBaker::isCompressionEnabled()).toUtf8();
+        auto cacheKey = BakeCache::computeKey(textureContent, TEXTURE_BAKER_CACHE_TYPE, TEXTURE_BAKER_VERSION, options);
+
+        QString metaTextureFileName;
+        if (restoreTextureFromCache(cacheKey, baseFilename, metaTextureFileName)) {
+            qDebug() << "Restored" << textureURL << "with usage" << type << "from the bake cache";
+            ++_bakeCacheHits;
+            completeTextureBake(key, metaTextureFileName);
+            return;
+        }
+
+        _textureCacheKeys.insert(key, cacheKey);
+    }
+
+    ++_bakeCacheMisses;
+
+    // setup a baker for this texture
+    QSharedPointer<TextureBaker> textureBaker {
+        new TextureBaker(textureURL, type, _contentOutputPath, baseFilename, textureContent),
+        &TextureBaker::deleteLater
+    };
+
+    // make sure our handler is called when the texture baker is done
+    connect(textureBaker.data(), &TextureBaker::finished, this, &DomainBaker::handleFinishedTextureBaker);
+
+    // insert it into our bakers hash so we hold a strong pointer to it
+    _textureBakers.insert(key, textureBaker);
+
+    // move the baker to a worker thread and kickoff the bake
+    textureBaker->moveToThread(Oven::instance().getNextWorkerThread());
+    QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
+}
+
+bool DomainBaker::restoreTextureFromCache(const QString& cacheKey, const QString& baseFilename, QString& metaTextureFileName) {
+    QStringList restoredFiles;
+    QString cachedBaseFilename;
+    if (!_bakeCache.restore(cacheKey, QDir(_contentOutputPath), baseFilename, restoredFiles, cachedBaseFilename)) {
+        return false;
+    }
+
+    for (const auto& restoredFile : restoredFiles) {
+        if (restoredFile.endsWith(BAKED_META_TEXTURE_SUFFIX)) {
+            metaTextureFileName = restoredFile;
+        }
+    }
+
+    bool restored = !metaTextureFileName.isEmpty();
+    if (restored && cachedBaseFilename != baseFilename) {
+        // the meta file names the baked files relative to itself, so point it at the renamed copies
+        QFile metaTextureFile { metaTextureFileName };
+        TextureMeta meta;
+        restored = metaTextureFile.open(QIODevice::ReadWrite) && TextureMeta::deserialize(metaTextureFile.readAll(), &meta);
+        if (restored) {
+            auto rename = [&](const QUrl& url) -> QUrl {
+                auto fileName = url.toString();
+                return fileName.isEmpty() ? url : QUrl(baseFilename + fileName.mid(cachedBaseFilename.length()));
+            };
+            meta.original = rename(meta.original);
+            meta.uncompressed = rename(meta.uncompressed);
+            for (auto& availableTextureType : meta.availableTextureTypes) {
+                availableTextureType.second = rename(availableTextureType.second);
+            }
+
+            auto data = meta.serialize();
+            restored = metaTextureFile.resize(0) && metaTextureFile.write(data) == data.size();
+        }
+    }
+
+    if (!restored) {
+        qWarning() << "Discarding incomplete bake cache entry" << cacheKey;
+        for (const auto& restoredFile : restoredFiles) {
+            QFile::remove(restoredFile);
+        }
+        metaTextureFileName.clear();
+    }
+
+    return restored;
+}
+
 void DomainBaker::addScriptBaker(const QString& property, const QString& url, const QJsonValueRef& jsonRef) {
     // grab a clean version of the URL without a query or fragment
     QUrl scriptURL = QUrl(url).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment);
@@ -502,57 +626,14 @@ void DomainBaker::handleFinishedTextureBaker() {
     auto baker = qobject_cast<TextureBaker*>(sender());
 
     if (baker) {
-        QUrl rewriteKey = baker->getTextureURL().toDisplayString() + "^" + QString::number(baker->getTextureType());
+        TextureKey key = { baker->getTextureURL(), baker->getTextureType() };
 
         if (!baker->hasErrors()) {
             // this TextureBaker is done and everything went according to plan
-            qDebug() << "Re-writing entity references to" << baker->getTextureURL() << "with usage" << baker->getTextureType();
-
-            // setup a new URL using the prefix we were passed
-            auto relativeTextureFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getMetaTextureFileName());
-            if (relativeTextureFilePath.startsWith("/")) {
-                relativeTextureFilePath = relativeTextureFilePath.right(relativeTextureFilePath.length() - 1);
-            }
-            auto newURL = _destinationPath.resolved(relativeTextureFilePath);
-
-            // enumerate the QJsonRef values for the URL of this texture from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(rewriteKey)) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // copy the fragment and query, and user info from the old texture URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old texture URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
-
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
+            // hold on to its outputs so the next bake of the same content can skip it
+            auto cacheKey = _textureCacheKeys.value(key);
+            if (!cacheKey.isEmpty()) {
+                _bakeCache.store(cacheKey, baker->getBaseFilename(), baker->getOutputFiles());
             }
         } else {
             // this texture failed to bake - this doesn't fail the entire bake but we need to add the errors from
@@ -560,18 +641,77 @@ void DomainBaker::handleFinishedTextureBaker() {
             _warningList << baker->getWarnings();
         }
 
-        // remove the baked URL from the multi hash of entities needing a re-write
-        _entitiesNeedingRewrite.remove(rewriteKey);
+        _textureCacheKeys.remove(key);
 
         // drop our shared pointer to this baker so that it gets cleaned up
-        _textureBakers.remove({ baker->getTextureURL(), baker->getTextureType() });
+        _textureBakers.remove(key);
 
-        // emit progress to tell listeners how many textures we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+        completeTextureBake(key, baker->hasErrors() ? QString() : baker->getMetaTextureFileName());
+    }
+}
 
-        // check if this was the last texture we needed to re-write and if we are done now
-        checkIfRewritingComplete();
+void DomainBaker::completeTextureBake(const TextureKey& key, const QString& metaTextureFileName) {
+    QUrl rewriteKey = key.first.toDisplayString() + "^" + QString::number(key.second);
+
+    if (!metaTextureFileName.isEmpty()) {
+        qDebug() << "Re-writing entity references to" << key.first << "with usage" << key.second;
+
+        // setup a new URL using the prefix we were passed
+        auto relativeTextureFilePath = QDir(_contentOutputPath).relativeFilePath(metaTextureFileName);
+        if (relativeTextureFilePath.startsWith("/")) {
+            relativeTextureFilePath = relativeTextureFilePath.right(relativeTextureFilePath.length() - 1);
+        }
+        auto newURL = _destinationPath.resolved(relativeTextureFilePath);
+
+        // enumerate the QJsonRef values for the URL of this texture from our multi hash of
+        // entity objects needing a URL re-write
+        for (auto propertyEntityPair : _entitiesNeedingRewrite.values(rewriteKey)) {
+            QString property = propertyEntityPair.first;
+            // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
+            auto entity = propertyEntityPair.second.toObject();
+
+            if (!property.contains(".")) {
+                // grab the old URL
+                QUrl oldURL = entity[property].toString();
+
+                // copy the fragment and query, and user info from the old texture URL
+                newURL.setQuery(oldURL.query());
+                newURL.setFragment(oldURL.fragment());
+                newURL.setUserInfo(oldURL.userInfo());
+
+                // set the new URL as the value in our temp QJsonObject
+                entity[property] = newURL.toString();
+            } else {
+                // Group property
+                QStringList propertySplit = property.split(".");
+                assert(propertySplit.length() == 2);
+                // grab the old URL
+                auto oldObject = entity[propertySplit[0]].toObject();
+                QUrl oldURL = oldObject[propertySplit[1]].toString();
+
+                // copy the fragment and query, and user info from the old texture URL
+                newURL.setQuery(oldURL.query());
+                newURL.setFragment(oldURL.fragment());
+                newURL.setUserInfo(oldURL.userInfo());
+
+                // set the new URL as the value in our temp QJsonObject
+                oldObject[propertySplit[1]] = newURL.toString();
+                entity[propertySplit[0]] = oldObject;
+            }
+
+            // replace our temp object with the value referenced by our QJsonValueRef
+            propertyEntityPair.second = entity;
+        }
     }
+
+    // remove the baked URL from the multi hash of entities needing a re-write
+    _entitiesNeedingRewrite.remove(rewriteKey);
+
+    // emit progress to tell listeners how many textures we have baked
+    emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+
+    // check if this was the last texture we needed to re-write and if we are done now
+    checkIfRewritingComplete();
 }
 
 void DomainBaker::handleFinishedScriptBaker() {
@@ -746,6 +886,8 @@ void DomainBaker::checkIfRewritingComplete() {
             return;
         }
 
+        qDebug() << "Bake cache:" << _bakeCacheHits << "hits," << _bakeCacheMisses << "misses";
+
         // we've now written out our new models file - time to say that we are finished up
         emit finished();
     }
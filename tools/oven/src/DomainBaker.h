@@ -15,6 +15,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonArray>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
 #include <QtCore/QUrl>
 #include <QtCore/QThread>
 
@@ -23,6 +24,8 @@
 #include "JSBaker.h"
 #include "MaterialBaker.h"
 
+#include "BakeCache.h"
+
 class DomainBaker : public Baker {
     Q_OBJECT
 public:
@@ -33,6 +36,9 @@ public:
                 const QString& baseOutputPath, const QUrl& destinationPath,
                 bool shouldRebakeOriginals);
 
+    int getBakeCacheHits() const { return _bakeCacheHits; }
+    int getBakeCacheMisses() const { return _bakeCacheMisses; }
+
 signals:
     void allModelsFinished();
     void bakeProgress(int baked, int total);
@@ -51,6 +57,11 @@ private:
     void checkIfRewritingComplete();
     void writeNewEntitiesFile();
 
+    void loadTextureForBake(const TextureKey& key, const QString& baseFilename);
+    void bakeTexture(const TextureKey& key, const QString& baseFilename, const QByteArray& textureContent);
+    bool restoreTextureFromCache(const QString& cacheKey, const QString& baseFilename, QString& metaTextureFileName);
+    void completeTextureBake(const TextureKey& key, const QString& metaTextureFileName);
+
     QUrl _localEntitiesFileURL;
     QString _domainName;
     QString _baseOutputPath;
@@ -65,6 +76,8 @@ private:
 
     QHash<QUrl, QSharedPointer<ModelBaker>> _modelBakers;
     QHash<TextureKey, QSharedPointer<TextureBaker>> _textureBakers;
+    QSet<TextureKey> _requestedTextures;
+    QHash<TextureKey, QString> _textureCacheKeys;
     TextureFileNamer _textureFileNamer;
     QHash<QUrl, QSharedPointer<JSBaker>> _scriptBakers;
     QHash<QUrl, QSharedPointer<MaterialBaker>> _materialBakers;
@@ -74,6 +87,10 @@ private:
     int _totalNumberOfSubBakes { 0 };
     int _completedSubBakes { 0 };
 
+    BakeCache _bakeCache;
+    int _bakeCacheHits { 0 };
+    int _bakeCacheMisses { 0 };
+
     bool _shouldRebakeOriginals { false };
 
     void addModelBaker(const QString& property, const QString& url, const QJsonValueRef& jsonRef);
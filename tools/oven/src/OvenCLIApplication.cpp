@@ -12,6 +12,7 @@
 #include "OvenCLIApplication.h"
 
 #include <QtCore/QCommandLineParser>
+#include <QtCore/QFileInfo>
 #include <QtCore/QUrl>
 
 #include <image/TextureProcessing.h>
@@ -23,6 +24,8 @@ static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_WORKERS_PARAMETER = "workers";
+static const QString CLI_MEMORY_BUDGET_PARAMETER = "memory-budget";
 
 OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
@@ -31,10 +34,12 @@ OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCommandLineParser parser;
 
     parser.addOptions({
-        { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
+        { CLI_INPUT_PARAMETER, "Path to file or folder that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_WORKERS_PARAMETER, "Maximum number of oven processes used to bake a folder.", "count" },
+        { CLI_MEMORY_BUDGET_PARAMETER, "Memory in MB that the oven processes baking a folder may use between them.", "megabytes" }
     });
 
     parser.addHelpOption();
@@ -51,8 +56,18 @@ OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
             TextureBaker::setCompressionEnabled(false);
         }
 
-        QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, inputUrl),
-                                    Q_ARG(QString, outputUrl.toString()), Q_ARG(QString, type));
+        QString inputPath = QDir::fromNativeSeparators(parser.value(CLI_INPUT_PARAMETER));
+        if (QFileInfo(inputPath).isDir()) {
+            int maxWorkers = parser.value(CLI_WORKERS_PARAMETER).toInt();
+            quint64 memoryBudgetMB = parser.value(CLI_MEMORY_BUDGET_PARAMETER).toULongLong();
+
+            QMetaObject::invokeMethod(cli, "bakeDirectory", Qt::QueuedConnection, Q_ARG(QString, inputPath),
+                                      Q_ARG(QString, outputUrl.toString()), Q_ARG(QString, type),
+                                      Q_ARG(int, maxWorkers), Q_ARG(quint64, memoryBudgetMB));
+        } else {
+            QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, inputUrl),
+                                        Q_ARG(QString, outputUrl.toString()), Q_ARG(QString, type));
+        }
     } else {
         parser.showHelp();
         QCoreApplication::quit();
@@ -270,6 +270,9 @@ void DomainBakeWidget::handleFinishedBaker() {
             auto resultRow = it->second;
             auto resultsWindow = OvenGUIApplication::instance()->getMainWindow()->showResultsWindow();
 
+            auto bakeCacheSummary = QString("Bake cache: %1 hits, %2 misses")
+                .arg(baker->getBakeCacheHits()).arg(baker->getBakeCacheMisses());
+
             if (baker->hasErrors()) {
                 auto errors = baker->getErrors();
                 errors.removeDuplicates();
@@ -279,9 +282,9 @@ void DomainBakeWidget::handleFinishedBaker() {
                 auto warnings = baker->getWarnings();
                 warnings.removeDuplicates();
 
-                resultsWindow->changeStatusForRow(resultRow, warnings.join("\n"));
+                resultsWindow->changeStatusForRow(resultRow, warnings.join("\n") + "\n" + bakeCacheSummary);
             } else {
-                resultsWindow->changeStatusForRow(resultRow, "Success");
+                resultsWindow->changeStatusForRow(resultRow, "Success - " + bakeCacheSummary);
             }
 
             // remove the DomainBaker now that it has completed